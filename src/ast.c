@@ -36,8 +36,22 @@ static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, s
 	*capacity = new_capacity;
 }
 
-static void ast_expr_destroy(AstExpr *expr);
-static void ast_stmt_destroy(AstStmt *stmt);
+static char *dup_string(const char *src)
+{
+	if (!src)
+	{
+		return NULL;
+	}
+	size_t len = strlen(src) + 1;
+	char *copy = malloc(len);
+	if (!copy)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(copy, src, len);
+	return copy;
+}
 
 AstProgram *ast_program_create(void)
 {
@@ -55,7 +69,7 @@ void ast_program_add_function(AstProgram *program, AstFunction *fn)
 	program->functions.items[program->functions.count++] = fn;
 }
 
-static void ast_function_destroy(AstFunction *fn)
+void ast_function_destroy(AstFunction *fn)
 {
 	if (!fn)
 	{
@@ -82,6 +96,7 @@ void ast_program_destroy(AstProgram *program)
 		ast_function_destroy(program->functions.items[i]);
 	}
 	free(program->functions.items);
+	ast_stmt_list_destroy(&program->constants);
 	free(program);
 }
 
@@ -141,7 +156,7 @@ void ast_expr_list_push(AstExprList *list, AstExpr *expr)
 	list->items[list->count++] = expr;
 }
 
-static void ast_expr_destroy(AstExpr *expr)
+void ast_expr_destroy(AstExpr *expr)
 {
 	if (!expr)
 	{
@@ -229,7 +244,7 @@ void ast_stmt_list_destroy(AstStmtList *list)
 	list->capacity = 0;
 }
 
-static void ast_stmt_destroy(AstStmt *stmt)
+void ast_stmt_destroy(AstStmt *stmt)
 {
 	if (!stmt)
 	{
@@ -319,6 +334,8 @@ AstStmt *ast_stmt_make_decl(TypeKind type, char *name, AstExpr *init)
 	stmt->data.decl.is_array = 0;
 	stmt->data.decl.array_size = 0;
 	stmt->data.decl.array_init = NULL;
+	stmt->data.decl.spilled = 0;
+	stmt->data.decl.is_const = 0;
 	return stmt;
 }
 
@@ -342,6 +359,8 @@ AstStmt *ast_stmt_make_array_decl(TypeKind type, char *name, size_t size, AstExp
 	stmt->data.decl.is_array = 1;
 	stmt->data.decl.array_size = size;
 	stmt->data.decl.array_init = init;
+	stmt->data.decl.spilled = 0;
+	stmt->data.decl.is_const = 0;
 	return stmt;
 }
 
@@ -500,6 +519,313 @@ AstExpr *ast_expr_make_subscript(AstExpr *array, AstExpr *index)
 	return expr;
 }
 
+AstExpr *ast_expr_clone(const AstExpr *expr)
+{
+	if (!expr)
+	{
+		return NULL;
+	}
+	AstExpr *copy = xcalloc(1, sizeof(AstExpr));
+	copy->kind = expr->kind;
+	copy->type = expr->type;
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+		copy->data.int_value = expr->data.int_value;
+		break;
+	case EXPR_FLOAT_LITERAL:
+		copy->data.float_value = expr->data.float_value;
+		break;
+	case EXPR_BOOL_LITERAL:
+		copy->data.bool_value = expr->data.bool_value;
+		break;
+	case EXPR_STRING_LITERAL:
+		copy->data.string_literal = dup_string(expr->data.string_literal);
+		break;
+	case EXPR_IDENTIFIER:
+		copy->data.identifier = dup_string(expr->data.identifier);
+		break;
+	case EXPR_BINARY:
+		copy->data.binary.op = expr->data.binary.op;
+		copy->data.binary.int_op = expr->data.binary.int_op;
+		copy->data.binary.left = ast_expr_clone(expr->data.binary.left);
+		copy->data.binary.right = ast_expr_clone(expr->data.binary.right);
+		break;
+	case EXPR_UNARY:
+		copy->data.unary.op = expr->data.unary.op;
+		copy->data.unary.int_op = expr->data.unary.int_op;
+		copy->data.unary.operand = ast_expr_clone(expr->data.unary.operand);
+		break;
+	case EXPR_CALL:
+		copy->data.call.callee = dup_string(expr->data.call.callee);
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			ast_expr_list_push(&copy->data.call.args, ast_expr_clone(expr->data.call.args.items[i]));
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			ast_expr_list_push(&copy->data.array_literal.elements, ast_expr_clone(expr->data.array_literal.elements.items[i]));
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		copy->data.subscript.array = ast_expr_clone(expr->data.subscript.array);
+		copy->data.subscript.index = ast_expr_clone(expr->data.subscript.index);
+		copy->data.subscript.array_size = expr->data.subscript.array_size;
+		copy->data.subscript.bounds_check = expr->data.subscript.bounds_check;
+		break;
+	}
+	return copy;
+}
+
+AstStmt *ast_stmt_clone(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return NULL;
+	}
+	AstStmt *copy = xcalloc(1, sizeof(AstStmt));
+	copy->kind = stmt->kind;
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			ast_stmt_list_push(&copy->data.block.statements, ast_stmt_clone(stmt->data.block.statements.items[i]));
+		}
+		break;
+	case STMT_DECL:
+		copy->data.decl = stmt->data.decl;
+		copy->data.decl.name = dup_string(stmt->data.decl.name);
+		copy->data.decl.init = ast_expr_clone(stmt->data.decl.init);
+		copy->data.decl.array_init = ast_expr_clone(stmt->data.decl.array_init);
+		break;
+	case STMT_ASSIGN:
+		copy->data.assign = stmt->data.assign;
+		copy->data.assign.name = dup_string(stmt->data.assign.name);
+		copy->data.assign.value = ast_expr_clone(stmt->data.assign.value);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		copy->data.array_assign = stmt->data.array_assign;
+		copy->data.array_assign.name = dup_string(stmt->data.array_assign.name);
+		copy->data.array_assign.index = ast_expr_clone(stmt->data.array_assign.index);
+		copy->data.array_assign.value = ast_expr_clone(stmt->data.array_assign.value);
+		break;
+	case STMT_WHILE:
+		copy->data.while_stmt.condition = ast_expr_clone(stmt->data.while_stmt.condition);
+		copy->data.while_stmt.body = ast_stmt_clone(stmt->data.while_stmt.body);
+		copy->data.while_stmt.profile_id = stmt->data.while_stmt.profile_id;
+		break;
+	case STMT_FOR:
+		copy->data.for_stmt.init = ast_stmt_clone(stmt->data.for_stmt.init);
+		copy->data.for_stmt.condition = ast_expr_clone(stmt->data.for_stmt.condition);
+		copy->data.for_stmt.post = ast_stmt_clone(stmt->data.for_stmt.post);
+		copy->data.for_stmt.body = ast_stmt_clone(stmt->data.for_stmt.body);
+		copy->data.for_stmt.profile_id = stmt->data.for_stmt.profile_id;
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		copy->data.expr = ast_expr_clone(stmt->data.expr);
+		break;
+	}
+	return copy;
+}
+
+static int ast_expr_list_equal(const AstExprList *left, const AstExprList *right)
+{
+	if (left->count != right->count)
+	{
+		return 0;
+	}
+	for (size_t i = 0; i < left->count; ++i)
+	{
+		if (!ast_expr_equal(left->items[i], right->items[i]))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int ast_expr_equal(const AstExpr *left, const AstExpr *right)
+{
+	if (!left || !right)
+	{
+		return left == right;
+	}
+	if (left->kind != right->kind || left->type != right->type)
+	{
+		return 0;
+	}
+	switch (left->kind)
+	{
+	case EXPR_INT_LITERAL:
+		return left->data.int_value == right->data.int_value;
+	case EXPR_FLOAT_LITERAL:
+		return left->data.float_value == right->data.float_value;
+	case EXPR_BOOL_LITERAL:
+		return left->data.bool_value == right->data.bool_value;
+	case EXPR_STRING_LITERAL:
+		return strcmp(left->data.string_literal, right->data.string_literal) == 0;
+	case EXPR_IDENTIFIER:
+		return strcmp(left->data.identifier, right->data.identifier) == 0;
+	case EXPR_BINARY:
+		return left->data.binary.op == right->data.binary.op &&
+			   ast_expr_equal(left->data.binary.left, right->data.binary.left) &&
+			   ast_expr_equal(left->data.binary.right, right->data.binary.right);
+	case EXPR_UNARY:
+		return left->data.unary.op == right->data.unary.op &&
+			   ast_expr_equal(left->data.unary.operand, right->data.unary.operand);
+	case EXPR_CALL:
+		return strcmp(left->data.call.callee, right->data.call.callee) == 0 &&
+			   ast_expr_list_equal(&left->data.call.args, &right->data.call.args);
+	case EXPR_ARRAY_LITERAL:
+		return ast_expr_list_equal(&left->data.array_literal.elements, &right->data.array_literal.elements);
+	case EXPR_SUBSCRIPT:
+		return ast_expr_equal(left->data.subscript.array, right->data.subscript.array) &&
+			   ast_expr_equal(left->data.subscript.index, right->data.subscript.index);
+	}
+	return 0;
+}
+
+int ast_expr_references(const AstExpr *expr, const char *name)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		return strcmp(expr->data.identifier, name) == 0;
+	case EXPR_BINARY:
+		return ast_expr_references(expr->data.binary.left, name) || ast_expr_references(expr->data.binary.right, name);
+	case EXPR_UNARY:
+		return ast_expr_references(expr->data.unary.operand, name);
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			if (ast_expr_references(expr->data.call.args.items[i], name))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (ast_expr_references(expr->data.array_literal.elements.items[i], name))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case EXPR_SUBSCRIPT:
+		return ast_expr_references(expr->data.subscript.array, name) || ast_expr_references(expr->data.subscript.index, name);
+	default:
+		return 0;
+	}
+}
+
+int ast_expr_contains_call(const AstExpr *expr)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_CALL:
+		return 1;
+	case EXPR_BINARY:
+		return ast_expr_contains_call(expr->data.binary.left) || ast_expr_contains_call(expr->data.binary.right);
+	case EXPR_UNARY:
+		return ast_expr_contains_call(expr->data.unary.operand);
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (ast_expr_contains_call(expr->data.array_literal.elements.items[i]))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case EXPR_SUBSCRIPT:
+		return ast_expr_contains_call(expr->data.subscript.index);
+	default:
+		return 0;
+	}
+}
+
+int ast_stmt_assigns(const AstStmt *stmt, const char *name)
+{
+	if (!stmt || !name)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (ast_stmt_assigns(stmt->data.block.statements.items[i], name))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) == 0;
+	case STMT_ASSIGN:
+		return strcmp(stmt->data.assign.name, name) == 0;
+	case STMT_ARRAY_ASSIGN:
+		return strcmp(stmt->data.array_assign.name, name) == 0;
+	case STMT_WHILE:
+		return ast_stmt_assigns(stmt->data.while_stmt.body, name);
+	case STMT_FOR:
+		return ast_stmt_assigns(stmt->data.for_stmt.init, name) ||
+			   ast_stmt_assigns(stmt->data.for_stmt.post, name) ||
+			   ast_stmt_assigns(stmt->data.for_stmt.body, name);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return 0;
+	}
+	return 0;
+}
+
+int ast_expr_invariant_in(const AstExpr *expr, const AstStmt *stmt)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+	case EXPR_STRING_LITERAL:
+		return 1;
+	case EXPR_IDENTIFIER:
+		return !ast_stmt_assigns(stmt, expr->data.identifier);
+	case EXPR_BINARY:
+		return ast_expr_invariant_in(expr->data.binary.left, stmt) && ast_expr_invariant_in(expr->data.binary.right, stmt);
+	case EXPR_UNARY:
+		return ast_expr_invariant_in(expr->data.unary.operand, stmt);
+	case EXPR_SUBSCRIPT:
+		return ast_expr_invariant_in(expr->data.subscript.array, stmt) && ast_expr_invariant_in(expr->data.subscript.index, stmt);
+	case EXPR_CALL:
+	case EXPR_ARRAY_LITERAL:
+		return 0;
+	}
+	return 0;
+}
+
 TypeKind ast_type_from_keyword(const char *kw)
 {
 	if (!kw)
@@ -38,6 +38,14 @@ typedef enum
 	UN_OP_NOT
 } AstUnaryOp;
 
+typedef enum
+{
+	INT_OP_LUA = 0,
+	INT_OP_WRAP32,
+	INT_OP_FLOOR,
+	INT_OP_TRUNC
+} AstIntOp;
+
 struct AstExpr;
 struct AstStmt;
 struct AstBlock;
@@ -106,11 +114,13 @@ typedef struct AstExpr
 			AstBinaryOp op;
 			struct AstExpr *left;
 			struct AstExpr *right;
+			AstIntOp int_op;
 		} binary;
 		struct
 		{
 			AstUnaryOp op;
 			struct AstExpr *operand;
+			AstIntOp int_op;
 		} unary;
 		struct
 		{
@@ -125,6 +135,8 @@ typedef struct AstExpr
 		{
 			struct AstExpr *array;
 			struct AstExpr *index;
+			size_t array_size;
+			int bounds_check;
 		} subscript;
 	} data;
 } AstExpr;
@@ -158,6 +170,8 @@ typedef struct AstStmt
 			int is_array;
 			size_t array_size;
 			AstExpr *array_init;
+			int spilled;
+			int is_const;
 		} decl;
 		struct
 		{
@@ -172,11 +186,13 @@ typedef struct AstStmt
 			AstExpr *value;
 			TypeKind element_type;
 			size_t array_size;
+			int bounds_check;
 		} array_assign;
 		struct
 		{
 			AstExpr *condition;
 			struct AstStmt *body;
+			size_t profile_id;
 		} while_stmt;
 		struct
 		{
@@ -184,6 +200,7 @@ typedef struct AstStmt
 			AstExpr *condition;
 			struct AstStmt *post;
 			struct AstStmt *body;
+			size_t profile_id;
 		} for_stmt;
 		AstExpr *expr;
 	} data;
@@ -201,6 +218,7 @@ typedef struct AstFunction
 typedef struct AstProgram
 {
 	AstFunctionList functions;
+	AstStmtList constants;
 } AstProgram;
 
 AstProgram *ast_program_create(void);
@@ -208,6 +226,7 @@ void ast_program_add_function(AstProgram *program, AstFunction *fn);
 void ast_program_destroy(AstProgram *program);
 
 AstFunction *ast_function_create(TypeKind return_type, char *name, AstParamList *params, AstBlock *body);
+void ast_function_destroy(AstFunction *fn);
 
 AstParamList ast_param_list_make(void);
 void ast_param_list_push(AstParamList *list, AstParam param);
@@ -221,6 +240,9 @@ AstStmtList ast_stmt_list_make(void);
 void ast_stmt_list_push(AstStmtList *list, AstStmt *stmt);
 void ast_stmt_list_destroy(AstStmtList *list);
 
+void ast_expr_destroy(AstExpr *expr);
+void ast_stmt_destroy(AstStmt *stmt);
+
 AstBlock ast_block_from_list(AstStmtList *list);
 
 AstStmt *ast_stmt_make_block(AstBlock *block);
@@ -244,6 +266,14 @@ AstExpr *ast_expr_make_binary(AstBinaryOp op, AstExpr *left, AstExpr *right);
 AstExpr *ast_expr_make_unary(AstUnaryOp op, AstExpr *operand);
 AstExpr *ast_expr_make_call(char *callee, AstExprList *args);
 
+AstExpr *ast_expr_clone(const AstExpr *expr);
+AstStmt *ast_stmt_clone(const AstStmt *stmt);
+int ast_expr_equal(const AstExpr *left, const AstExpr *right);
+int ast_expr_references(const AstExpr *expr, const char *name);
+int ast_expr_contains_call(const AstExpr *expr);
+int ast_stmt_assigns(const AstStmt *stmt, const char *name);
+int ast_expr_invariant_in(const AstExpr *expr, const AstStmt *stmt);
+
 TypeKind ast_type_from_keyword(const char *kw);
 const char *ast_type_name(TypeKind type);
 
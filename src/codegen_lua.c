@@ -1,45 +1,146 @@
 #include "codegen_lua.h"
+#include "output.h"
+#include "profile.h"
+#include "purity.h"
 
+#include <limits.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-static void emit_program(FILE *out, const AstProgram *program, const FunctionTable *functions);
-static void emit_function(FILE *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions);
-static void emit_main_wrapper(FILE *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions);
-static void emit_block(FILE *out, const AstBlock *block, const FunctionTable *functions, const FunctionSignature *signature, int indent, int wrap_with_do);
-static void emit_statement(FILE *out, const AstStmt *stmt, const FunctionTable *functions, const FunctionSignature *signature, int indent);
-static void emit_expression_raw(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_expression_expected(FILE *out, const AstExpr *expr, const FunctionTable *functions, TypeKind expected_type);
-static void emit_expression_as_bool(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_call(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_printf_call(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_puts_call(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_printf_args(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_string_literal_n(FILE *out, const char *value, size_t length);
-static void emit_string_literal(FILE *out, const char *value);
-static void emit_array_declaration(FILE *out, const AstStmt *stmt, const FunctionTable *functions, int indent);
-static void emit_array_literal_expr(FILE *out, const AstExprList *elements, const FunctionTable *functions);
-static void emit_array_index(FILE *out, const AstExpr *expr, const FunctionTable *functions);
-static void emit_array_default_value(FILE *out, TypeKind type);
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+typedef struct
+{
+	const char *name;
+	const AstExpr *start;
+	const AstExpr *bound;
+	long long bound_offset;
+	int round_bound;
+	long long step;
+} NumericFor;
+
+/* Lua operator precedence, lowest first. An operand is parenthesized only
+ * when it binds more loosely than its position requires. */
+enum
+{
+	PREC_LOWEST,
+	PREC_OR,
+	PREC_AND,
+	PREC_COMPARE,
+	PREC_BAND,
+	PREC_ADD,
+	PREC_MUL,
+	PREC_UNARY,
+	PREC_ATOM
+};
+
+static void emit_program(OutputBuffer *out, const AstProgram *program, const FunctionTable *functions, const CompilerOptions *options);
+static void emit_function_declarations(OutputBuffer *out, const AstProgram *program, const FunctionTable *functions);
+static void emit_function(OutputBuffer *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions);
+static int should_memoize(const AstFunction *fn, const FunctionSignature *signature, const CompilerOptions *options);
+static void emit_memoized_function(OutputBuffer *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions);
+static void emit_param_list(OutputBuffer *out, const AstFunction *fn);
+static void emit_main_wrapper(OutputBuffer *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions,
+							  const char *profile_path);
+static void emit_block(OutputBuffer *out, const AstBlock *block, const FunctionTable *functions, const FunctionSignature *signature, int indent, int wrap_with_do);
+static void emit_statement(OutputBuffer *out, const AstStmt *stmt, const FunctionTable *functions, const FunctionSignature *signature, int indent);
+static int match_numeric_for(const AstStmt *stmt, NumericFor *loop, const FunctionTable *functions);
+static int match_for_step(const AstExpr *value, const char *name, long long *step);
+static int is_integral_int(const AstExpr *expr, const FunctionTable *functions);
+static void emit_numeric_for(OutputBuffer *out, const AstStmt *stmt, const NumericFor *loop, const FunctionTable *functions, const FunctionSignature *signature, int indent);
+static void emit_expression_raw(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static void emit_expression_expected(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, TypeKind expected_type, int prec);
+static void emit_expression_as_bool(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static void emit_negated_condition(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static int negated_comparison(const AstExpr *expr, AstBinaryOp *negated);
+static int literal_truth(const AstExpr *expr);
+static void emit_int_binary(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static void emit_call(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static void emit_printf_call(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static void emit_puts_call(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec);
+static void emit_printf_args(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions);
+static char printf_conversion(const char *format, size_t position);
+static int emit_constant_printf(OutputBuffer *out, const AstExpr *expr);
+static int parse_printf_spec(const char *format, size_t start, size_t length, char *spec, char *conversion, size_t *end);
+static int format_constant_argument(const AstExpr *arg, const char *spec, char conversion, char *buffer, size_t size,
+									const char **text, size_t *text_length);
+static int literal_lua_number(const AstExpr *arg, int *is_integer, long long *integer, double *number);
+static void emit_string_literal_n(OutputBuffer *out, const char *value, size_t length);
+static void emit_string_chars(OutputBuffer *out, const char *value, size_t length);
+static void emit_string_literal(OutputBuffer *out, const char *value);
+static void emit_array_declaration(OutputBuffer *out, const AstStmt *stmt, const FunctionTable *functions, int indent);
+static void emit_array_literal_expr(OutputBuffer *out, const AstExprList *elements, const FunctionTable *functions);
+static void emit_array_index(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions);
+static void emit_checked_index(OutputBuffer *out, const AstExpr *expr, const char *array_name, size_t array_size, const FunctionTable *functions);
+static void emit_bounds_helper(OutputBuffer *out);
+static void emit_int32_helpers(OutputBuffer *out);
+static void emit_int_with_offset(OutputBuffer *out, const AstExpr *expr, long long extra, const FunctionTable *functions);
+static int is_int_additive(const AstExpr *expr);
+static size_t count_additive_terms(const AstExpr *expr);
+static int leading_additive_term_negated(const AstExpr *expr, int negate);
+static long long offset_of_additive(const AstExpr *expr);
+static void emit_additive_terms(OutputBuffer *out, const AstExpr *expr, int negate, int *first, int prec, const FunctionTable *functions);
+static void emit_array_default_value(OutputBuffer *out, TypeKind type);
 static const FunctionSignature *lookup_signature(const FunctionTable *functions, const char *name);
+static const char *storage_prefix(const FunctionSignature *signature);
 static const char *binary_op_token(AstBinaryOp op);
-static void emit_indent(FILE *out, int indent);
-static int emit_builtin_expr_statement(FILE *out, const AstExpr *expr, const FunctionTable *functions, int indent);
+static int binary_op_precedence(AstBinaryOp op);
+static int starts_with_minus(const AstExpr *expr);
+static void emit_minus(OutputBuffer *out, const AstExpr *operand, const FunctionTable *functions);
+static int emit_builtin_expr_statement(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int indent);
 
-void codegen_lua_emit(FILE *out, const AstProgram *program, const FunctionTable *functions)
+/* The whole chunk is built in memory and written with one flush. */
+int codegen_lua_emit(FILE *out, const AstProgram *program, const FunctionTable *functions, const CompilerOptions *options)
 {
-	if (!out || !program || !functions)
+	if (!out || !program || !functions || !options)
 	{
-		return;
+		return 0;
+	}
+	OutputBuffer buffer;
+	output_init(&buffer);
+	emit_program(&buffer, program, functions, options);
+	int written = output_flush(&buffer, out);
+	output_free(&buffer);
+	return written;
+}
+
+char *codegen_lua_emit_string(const AstProgram *program, const FunctionTable *functions, const CompilerOptions *options, size_t *length)
+{
+	if (!program || !functions || !options)
+	{
+		return NULL;
 	}
-	emit_program(out, program, functions);
+	OutputBuffer buffer;
+	output_init(&buffer);
+	emit_program(&buffer, program, functions, options);
+	return output_release(&buffer, length);
 }
 
-static void emit_program(FILE *out, const AstProgram *program, const FunctionTable *functions)
+static void emit_program(OutputBuffer *out, const AstProgram *program, const FunctionTable *functions, const CompilerOptions *options)
 {
 	const AstFunction *main_function = NULL;
 	const FunctionSignature *main_signature = NULL;
 
+	if (options->bounds_check)
+	{
+		emit_bounds_helper(out);
+	}
+	if (options->int_semantics == INT_SEMANTICS_C32)
+	{
+		emit_int32_helpers(out);
+	}
+	for (size_t i = 0; i < program->constants.count; ++i)
+	{
+		emit_statement(out, program->constants.items[i], functions, NULL, 0);
+	}
+	if (program->constants.count > 0)
+	{
+		output_char(out, '\n');
+	}
+	emit_function_declarations(out, program, functions);
+
 	for (size_t i = 0; i < program->functions.count; ++i)
 	{
 		const AstFunction *fn = program->functions.items[i];
@@ -50,61 +151,223 @@ static void emit_program(FILE *out, const AstProgram *program, const FunctionTab
 			continue;
 		}
 		const FunctionSignature *signature = lookup_signature(functions, fn->name);
-		emit_function(out, fn, signature, functions);
-		fputc('\n', out);
+		if (should_memoize(fn, signature, options))
+		{
+			emit_memoized_function(out, fn, signature, functions);
+		}
+		else
+		{
+			emit_function(out, fn, signature, functions);
+		}
+		output_char(out, '\n');
 	}
 
 	if (main_function && main_signature)
 	{
-		emit_main_wrapper(out, main_function, main_signature, functions);
+		emit_main_wrapper(out, main_function, main_signature, functions, options->profile_generate);
+	}
+}
+
+/* Functions called before their definition are declared up front, and the
+ * ones that did not fit in the chunk's locals share one table. */
+static void emit_function_declarations(OutputBuffer *out, const AstProgram *program, const FunctionTable *functions)
+{
+	int first = 1;
+	int tabled = 0;
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		const FunctionSignature *signature = lookup_signature(functions, program->functions.items[i]->name);
+		if (!signature)
+		{
+			continue;
+		}
+		tabled |= signature->storage == FUNCTION_TABLE;
+		if (signature->storage != FUNCTION_FORWARD)
+		{
+			continue;
+		}
+		output_string(out, first ? "local " : ", ");
+		output_string(out, signature->name);
+		first = 0;
+	}
+	if (!first)
+	{
+		output_char(out, '\n');
+	}
+	if (tabled)
+	{
+		output_string(out, "local __fn = {}\n");
+	}
+	if (!first || tabled)
+	{
+		output_char(out, '\n');
+	}
+}
+
+static void emit_function(OutputBuffer *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions)
+{
+	output_indent(out, 0);
+	if (signature && signature->storage != FUNCTION_LOCAL)
+	{
+		output_format(out, "function %s%s(", storage_prefix(signature), fn->name);
+	}
+	else
+	{
+		output_format(out, "local function %s(", fn->name);
 	}
+	emit_param_list(out, fn);
+	output_string(out, ")\n");
+	emit_block(out, &fn->body, functions, signature, 1, 0);
+	output_indent(out, 0);
+	output_string(out, "end\n");
 }
 
-static void emit_function(FILE *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions)
+static int should_memoize(const AstFunction *fn, const FunctionSignature *signature, const CompilerOptions *options)
 {
-	(void)signature;
-	emit_indent(out, 0);
-	fprintf(out, "local function %s(", fn->name);
+	if (options->memoize != MEMOIZE_AUTO || !signature || !signature->is_pure || fn->params.count == 0 ||
+		fn->return_type == TYPE_VOID || !purity_function_calls(fn, fn->name))
+	{
+		return 0;
+	}
 	for (size_t i = 0; i < fn->params.count; ++i)
 	{
-		if (i > 0)
+		if (fn->params.items[i].type != TYPE_INT && fn->params.items[i].type != TYPE_BOOL)
 		{
-			fputs(", ", out);
+			return 0;
 		}
-		fputs(fn->params.items[i].name, out);
 	}
-	fputs(")\n", out);
+	return 1;
+}
+
+/* The body keeps calling the memoized name through an upvalue, so recursive
+ * calls hit the cache too. */
+static void emit_memoized_function(OutputBuffer *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions)
+{
+	const char *prefix = storage_prefix(signature);
+	if (signature->storage == FUNCTION_LOCAL)
+	{
+		output_indent(out, 0);
+		output_format(out, "local %s\n", fn->name);
+	}
+	output_indent(out, 0);
+	if (signature->storage == FUNCTION_TABLE)
+	{
+		output_format(out, "__fn.__memo_%s = {}\n", fn->name);
+		output_indent(out, 0);
+		output_format(out, "function __fn.__compute_%s(", fn->name);
+	}
+	else
+	{
+		output_format(out, "local __memo_%s = {}\n", fn->name);
+		output_indent(out, 0);
+		output_format(out, "local function __compute_%s(", fn->name);
+	}
+	emit_param_list(out, fn);
+	output_string(out, ")\n");
 	emit_block(out, &fn->body, functions, signature, 1, 0);
-	emit_indent(out, 0);
-	fputs("end\n", out);
+	output_indent(out, 0);
+	output_string(out, "end\n");
+
+	output_indent(out, 0);
+	output_format(out, "%s%s = function(", prefix, fn->name);
+	emit_param_list(out, fn);
+	output_string(out, ")\n");
+	output_indent(out, 1);
+	output_string(out, "local key = ");
+	if (fn->params.count == 1)
+	{
+		output_string(out, fn->params.items[0].name);
+	}
+	else
+	{
+		for (size_t i = 0; i < fn->params.count; ++i)
+		{
+			if (i > 0)
+			{
+				output_string(out, " .. \",\" .. ");
+			}
+			output_format(out, "tostring(%s)", fn->params.items[i].name);
+		}
+	}
+	output_char(out, '\n');
+	output_indent(out, 1);
+	output_format(out, "local value = %s__memo_%s[key]\n", prefix, fn->name);
+	output_indent(out, 1);
+	output_string(out, "if value == nil then\n");
+	output_indent(out, 2);
+	output_format(out, "value = %s__compute_%s(", prefix, fn->name);
+	emit_param_list(out, fn);
+	output_string(out, ")\n");
+	output_indent(out, 2);
+	output_format(out, "%s__memo_%s[key] = value\n", prefix, fn->name);
+	output_indent(out, 1);
+	output_string(out, "end\n");
+	output_indent(out, 1);
+	output_string(out, "return value\n");
+	output_indent(out, 0);
+	output_string(out, "end\n");
+}
+
+static void emit_param_list(OutputBuffer *out, const AstFunction *fn)
+{
+	for (size_t i = 0; i < fn->params.count; ++i)
+	{
+		if (i > 0)
+		{
+			output_string(out, ", ");
+		}
+		output_string(out, fn->params.items[i].name);
+	}
 }
 
-static void emit_main_wrapper(FILE *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions)
+/* An instrumented build writes its counters once main has returned. */
+static void emit_main_wrapper(OutputBuffer *out, const AstFunction *fn, const FunctionSignature *signature, const FunctionTable *functions,
+							  const char *profile_path)
 {
-	emit_indent(out, 0);
-	fputs("os.exit((function(args)\n", out);
+	output_indent(out, 0);
+	output_string(out, "os.exit(");
+	if (profile_path)
+	{
+		output_string(out, "(function(status)\n");
+		output_indent(out, 1);
+		output_string(out, "local file = assert(io.open(");
+		emit_string_literal(out, profile_path);
+		output_string(out, ", \"w\"))\n");
+		output_indent(out, 1);
+		output_string(out, "for i = 1, #" PROFILE_NAMES " do\n");
+		output_indent(out, 2);
+		output_string(out, "file:write(" PROFILE_NAMES "[i], \" \", " PROFILE_COUNTERS "[i], \"\\n\")\n");
+		output_indent(out, 1);
+		output_string(out, "end\n");
+		output_indent(out, 1);
+		output_string(out, "file:close()\n");
+		output_indent(out, 1);
+		output_string(out, "return status\n");
+		output_string(out, "end)(");
+	}
+	output_string(out, "(function(args)\n");
 
 	if (fn->params.count > 0)
 	{
-		emit_indent(out, 1);
-		fputs("local args_table = args\n", out);
+		output_indent(out, 1);
+		output_string(out, "local args_table = args\n");
 		for (size_t i = 0; i < fn->params.count; ++i)
 		{
 			const AstParam *param = &fn->params.items[i];
-			emit_indent(out, 1);
+			output_indent(out, 1);
 			switch (param->type)
 			{
 			case TYPE_INT:
-				fprintf(out, "local %s = args_table and tonumber(args_table[%zu]) or 0\n", param->name, i + 1);
+				output_format(out, "local %s = args_table and tonumber(args_table[%zu]) or 0\n", param->name, i + 1);
 				break;
 			case TYPE_FLOAT:
-				fprintf(out, "local %s = args_table and tonumber(args_table[%zu]) or 0.0\n", param->name, i + 1);
+				output_format(out, "local %s = args_table and tonumber(args_table[%zu]) or 0.0\n", param->name, i + 1);
 				break;
 			case TYPE_BOOL:
-				fprintf(out, "local %s = args_table and args_table[%zu] ~= nil or false\n", param->name, i + 1);
+				output_format(out, "local %s = args_table and args_table[%zu] ~= nil or false\n", param->name, i + 1);
 				break;
 			default:
-				fprintf(out, "local %s = args_table and args_table[%zu] or nil\n", param->name, i + 1);
+				output_format(out, "local %s = args_table and args_table[%zu] or nil\n", param->name, i + 1);
 				break;
 			}
 		}
@@ -112,11 +375,11 @@ static void emit_main_wrapper(FILE *out, const AstFunction *fn, const FunctionSi
 
 	emit_block(out, &fn->body, functions, signature, 1, 0);
 
-	emit_indent(out, 0);
-	fputs("end)(arg))\n", out);
+	output_indent(out, 0);
+	output_string(out, profile_path ? "end)(arg)))\n" : "end)(arg))\n");
 }
 
-static void emit_block(FILE *out, const AstBlock *block, const FunctionTable *functions, const FunctionSignature *signature, int indent, int wrap_with_do)
+static void emit_block(OutputBuffer *out, const AstBlock *block, const FunctionTable *functions, const FunctionSignature *signature, int indent, int wrap_with_do)
 {
 	if (!block)
 	{
@@ -126,8 +389,8 @@ static void emit_block(FILE *out, const AstBlock *block, const FunctionTable *fu
 	int current_indent = indent;
 	if (wrap_with_do)
 	{
-		emit_indent(out, indent);
-		fputs("do\n", out);
+		output_indent(out, indent);
+		output_string(out, "do\n");
 		current_indent = indent + 1;
 	}
 
@@ -139,12 +402,12 @@ static void emit_block(FILE *out, const AstBlock *block, const FunctionTable *fu
 
 	if (wrap_with_do)
 	{
-		emit_indent(out, indent);
-		fputs("end\n", out);
+		output_indent(out, indent);
+		output_string(out, "end\n");
 	}
 }
 
-static void emit_statement(FILE *out, const AstStmt *stmt, const FunctionTable *functions, const FunctionSignature *signature, int indent)
+static void emit_statement(OutputBuffer *out, const AstStmt *stmt, const FunctionTable *functions, const FunctionSignature *signature, int indent)
 {
 	if (!stmt)
 	{
@@ -161,69 +424,99 @@ static void emit_statement(FILE *out, const AstStmt *stmt, const FunctionTable *
 		{
 			emit_array_declaration(out, stmt, functions, indent);
 		}
+		else if (stmt->data.decl.spilled)
+		{
+			if (stmt->data.decl.init)
+			{
+				output_indent(out, indent);
+				output_string(out, stmt->data.decl.name);
+				output_string(out, " = ");
+				emit_expression_expected(out, stmt->data.decl.init, functions, stmt->data.decl.type, PREC_LOWEST);
+				output_char(out, '\n');
+			}
+		}
 		else
 		{
-			emit_indent(out, indent);
-			fprintf(out, "local %s", stmt->data.decl.name);
+			output_indent(out, indent);
+			output_string(out, "local ");
+			output_string(out, stmt->data.decl.name);
+			output_string(out, stmt->data.decl.is_const ? " <const>" : "");
 			if (stmt->data.decl.init)
 			{
-				fputs(" = ", out);
-				emit_expression_expected(out, stmt->data.decl.init, functions, stmt->data.decl.type);
+				output_string(out, " = ");
+				emit_expression_expected(out, stmt->data.decl.init, functions, stmt->data.decl.type, PREC_LOWEST);
 			}
-			fputc('\n', out);
+			output_char(out, '\n');
 		}
 		break;
 	case STMT_ASSIGN:
-		emit_indent(out, indent);
-		fprintf(out, "%s = ", stmt->data.assign.name);
-		emit_expression_expected(out, stmt->data.assign.value, functions, stmt->data.assign.type);
-		fputc('\n', out);
+		output_indent(out, indent);
+		output_string(out, stmt->data.assign.name);
+		output_string(out, " = ");
+		emit_expression_expected(out, stmt->data.assign.value, functions, stmt->data.assign.type, PREC_LOWEST);
+		output_char(out, '\n');
 		break;
 	case STMT_ARRAY_ASSIGN:
-		emit_indent(out, indent);
-		fprintf(out, "%s[", stmt->data.array_assign.name);
-		emit_array_index(out, stmt->data.array_assign.index, functions);
-		fputs("] = ", out);
-		emit_expression_expected(out, stmt->data.array_assign.value, functions, stmt->data.array_assign.element_type);
-		fputc('\n', out);
+		output_indent(out, indent);
+		output_string(out, stmt->data.array_assign.name);
+		output_char(out, '[');
+		if (stmt->data.array_assign.bounds_check)
+		{
+			emit_checked_index(out, stmt->data.array_assign.index, stmt->data.array_assign.name, stmt->data.array_assign.array_size, functions);
+		}
+		else
+		{
+			emit_array_index(out, stmt->data.array_assign.index, functions);
+		}
+		output_string(out, "] = ");
+		emit_expression_expected(out, stmt->data.array_assign.value, functions, stmt->data.array_assign.element_type, PREC_LOWEST);
+		output_char(out, '\n');
 		break;
 	case STMT_WHILE:
-		emit_indent(out, indent);
-		fputs("while ", out);
-		emit_expression_as_bool(out, stmt->data.while_stmt.condition, functions);
-		fputs(" do\n", out);
+		output_indent(out, indent);
+		output_string(out, "while ");
+		emit_expression_as_bool(out, stmt->data.while_stmt.condition, functions, PREC_LOWEST);
+		output_string(out, " do\n");
 		emit_statement(out, stmt->data.while_stmt.body, functions, signature, indent + 1);
-		emit_indent(out, indent);
-		fputs("end\n", out);
+		output_indent(out, indent);
+		output_string(out, "end\n");
 		break;
 	case STMT_FOR:
-		emit_indent(out, indent);
-		fputs("do\n", out);
+	{
+		NumericFor loop;
+		if (match_numeric_for(stmt, &loop, functions))
+		{
+			emit_numeric_for(out, stmt, &loop, functions, signature, indent);
+			break;
+		}
+		output_indent(out, indent);
+		output_string(out, "do\n");
 		if (stmt->data.for_stmt.init)
 		{
 			emit_statement(out, stmt->data.for_stmt.init, functions, signature, indent + 1);
 		}
-		emit_indent(out, indent + 1);
-		fputs("while ", out);
+		output_indent(out, indent + 1);
+		output_string(out, "while ");
 		if (stmt->data.for_stmt.condition)
 		{
-			emit_expression_as_bool(out, stmt->data.for_stmt.condition, functions);
+			emit_expression_as_bool(out, stmt->data.for_stmt.condition, functions, PREC_LOWEST);
 		}
 		else
 		{
-			fputs("true", out);
+			output_string(out, "true");
 		}
-		fputs(" do\n", out);
+		output_string(out, " do\n");
 		emit_statement(out, stmt->data.for_stmt.body, functions, signature, indent + 2);
 		if (stmt->data.for_stmt.post)
 		{
 			emit_statement(out, stmt->data.for_stmt.post, functions, signature, indent + 2);
 		}
-		emit_indent(out, indent + 1);
-		fputs("end\n", out);
-		emit_indent(out, indent);
-		fputs("end\n", out);
+		output_indent(out, indent + 1);
+		output_string(out, "end\n");
+		output_indent(out, indent);
+		output_string(out, "end\n");
 		break;
+	}
 	case STMT_EXPR:
 		if (stmt->data.expr)
 		{
@@ -231,83 +524,303 @@ static void emit_statement(FILE *out, const AstStmt *stmt, const FunctionTable *
 			{
 				break;
 			}
-			emit_indent(out, indent);
-			emit_expression_raw(out, stmt->data.expr, functions);
-			fputc('\n', out);
+			output_indent(out, indent);
+			emit_expression_raw(out, stmt->data.expr, functions, PREC_LOWEST);
+			output_char(out, '\n');
 		}
 		break;
 	case STMT_RETURN:
-		emit_indent(out, indent);
-		fputs("return", out);
+		output_indent(out, indent);
+		output_string(out, "return");
 		if (stmt->data.expr)
 		{
-			fputc(' ', out);
+			output_char(out, ' ');
 			TypeKind expected = signature ? signature->return_type : TYPE_UNKNOWN;
-			emit_expression_expected(out, stmt->data.expr, functions, expected);
+			emit_expression_expected(out, stmt->data.expr, functions, expected, PREC_LOWEST);
+		}
+		output_char(out, '\n');
+		break;
+	}
+}
+
+/* Matches for (int i = e0; i OP e1; i = i +/- k) where neither i nor the
+ * operands of e1 change in the body, so Lua's numeric for can evaluate the
+ * bound once and drive the loop with FORPREP/FORLOOP. */
+static int match_numeric_for(const AstStmt *stmt, NumericFor *loop, const FunctionTable *functions)
+{
+	const AstStmt *init = stmt->data.for_stmt.init;
+	const AstStmt *post = stmt->data.for_stmt.post;
+	const AstExpr *condition = stmt->data.for_stmt.condition;
+	const AstStmt *body = stmt->data.for_stmt.body;
+	if (!init || init->kind != STMT_DECL || init->data.decl.is_array || init->data.decl.type != TYPE_INT || !init->data.decl.init)
+	{
+		return 0;
+	}
+	const char *name = init->data.decl.name;
+	if (!post || post->kind != STMT_ASSIGN || strcmp(post->data.assign.name, name) != 0 ||
+		!match_for_step(post->data.assign.value, name, &loop->step))
+	{
+		return 0;
+	}
+	if (!condition || condition->kind != EXPR_BINARY || ast_stmt_assigns(body, name))
+	{
+		return 0;
+	}
+
+	AstBinaryOp op = condition->data.binary.op;
+	const AstExpr *bound;
+	const AstExpr *left = condition->data.binary.left;
+	const AstExpr *right = condition->data.binary.right;
+	if (left->kind == EXPR_IDENTIFIER && strcmp(left->data.identifier, name) == 0)
+	{
+		bound = right;
+	}
+	else if (right->kind == EXPR_IDENTIFIER && strcmp(right->data.identifier, name) == 0)
+	{
+		bound = left;
+		switch (op)
+		{
+		case BIN_OP_LT:
+			op = BIN_OP_GT;
+			break;
+		case BIN_OP_LE:
+			op = BIN_OP_GE;
+			break;
+		case BIN_OP_GT:
+			op = BIN_OP_LT;
+			break;
+		case BIN_OP_GE:
+			op = BIN_OP_LE;
+			break;
+		default:
+			return 0;
 		}
-		fputc('\n', out);
+	}
+	else
+	{
+		return 0;
+	}
+	if (ast_expr_references(bound, name) || !ast_expr_invariant_in(bound, body))
+	{
+		return 0;
+	}
+	/* A fractional start would step through fractions that i <= e - 1 and
+	 * i < e disagree on. */
+	if (init->data.decl.init->type == TYPE_INT && !is_integral_int(init->data.decl.init, functions))
+	{
+		return 0;
+	}
+
+	loop->round_bound = 0;
+	switch (op)
+	{
+	case BIN_OP_LT:
+	case BIN_OP_GT:
+		if (bound->type != TYPE_INT)
+		{
+			return 0;
+		}
+		/* i < 2.5 is i <= 2 only after rounding the bound. */
+		loop->bound_offset = op == BIN_OP_LT ? -1 : 1;
+		loop->round_bound = !is_integral_int(bound, functions);
+		break;
+	case BIN_OP_LE:
+	case BIN_OP_GE:
+		if (bound->type != TYPE_INT && bound->type != TYPE_FLOAT)
+		{
+			return 0;
+		}
+		loop->bound_offset = 0;
 		break;
+	default:
+		return 0;
+	}
+	if ((op == BIN_OP_LT || op == BIN_OP_LE) != (loop->step > 0))
+	{
+		return 0;
+	}
+
+	loop->name = name;
+	loop->start = init->data.decl.init;
+	loop->bound = bound;
+	return 1;
+}
+
+static int match_for_step(const AstExpr *value, const char *name, long long *step)
+{
+	if (!value || value->kind != EXPR_BINARY || value->type != TYPE_INT)
+	{
+		return 0;
+	}
+	const AstExpr *left = value->data.binary.left;
+	const AstExpr *right = value->data.binary.right;
+	int left_is_var = left->kind == EXPR_IDENTIFIER && strcmp(left->data.identifier, name) == 0;
+	int right_is_var = right->kind == EXPR_IDENTIFIER && strcmp(right->data.identifier, name) == 0;
+	if (value->data.binary.op == BIN_OP_ADD && left_is_var && right->kind == EXPR_INT_LITERAL)
+	{
+		*step = right->data.int_value;
+	}
+	else if (value->data.binary.op == BIN_OP_ADD && right_is_var && left->kind == EXPR_INT_LITERAL)
+	{
+		*step = left->data.int_value;
+	}
+	else if (value->data.binary.op == BIN_OP_SUB && left_is_var && right->kind == EXPR_INT_LITERAL)
+	{
+		*step = -right->data.int_value;
+	}
+	else
+	{
+		return 0;
+	}
+	return *step != 0;
+}
+
+/* Int division is Lua's float division outside c32 mode. Literals and sums
+ * or products of them are whole; any other int value is whole only in a
+ * program that never divides ints. */
+static int is_integral_int(const AstExpr *expr, const FunctionTable *functions)
+{
+	if (!expr || expr->type != TYPE_INT)
+	{
+		return 0;
+	}
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+		return 1;
+	case EXPR_BINARY:
+		if (expr->data.binary.op == BIN_OP_DIV && expr->data.binary.int_op == INT_OP_LUA)
+		{
+			return 0;
+		}
+		return is_integral_int(expr->data.binary.left, functions) && is_integral_int(expr->data.binary.right, functions);
+	case EXPR_UNARY:
+		return is_integral_int(expr->data.unary.operand, functions);
+	default:
+		return !functions->fractional_ints;
+	}
+}
+
+static void emit_numeric_for(OutputBuffer *out, const AstStmt *stmt, const NumericFor *loop, const FunctionTable *functions, const FunctionSignature *signature, int indent)
+{
+	output_indent(out, indent);
+	output_string(out, "for ");
+	output_string(out, loop->name);
+	output_string(out, " = ");
+	emit_expression_expected(out, loop->start, functions, TYPE_INT, PREC_LOWEST);
+	output_string(out, ", ");
+	if (loop->round_bound)
+	{
+		output_string(out, loop->bound_offset < 0 ? "math.ceil(" : "math.floor(");
+		emit_expression_raw(out, loop->bound, functions, PREC_LOWEST);
+		output_string(out, loop->bound_offset < 0 ? ") - 1" : ") + 1");
 	}
+	else if (loop->bound_offset != 0 || loop->bound->kind == EXPR_INT_LITERAL)
+	{
+		emit_int_with_offset(out, loop->bound, loop->bound_offset, functions);
+	}
+	else
+	{
+		emit_expression_raw(out, loop->bound, functions, PREC_LOWEST);
+	}
+	if (loop->step != 1)
+	{
+		output_string(out, ", ");
+		output_int(out, loop->step);
+	}
+	output_string(out, " do\n");
+	const AstStmt *body = stmt->data.for_stmt.body;
+	if (body && body->kind == STMT_BLOCK)
+	{
+		emit_block(out, &body->data.block, functions, signature, indent + 1, 0);
+	}
+	else
+	{
+		emit_statement(out, body, functions, signature, indent + 1);
+	}
+	output_indent(out, indent);
+	output_string(out, "end\n");
 }
 
-static void emit_expression_expected(FILE *out, const AstExpr *expr, const FunctionTable *functions, TypeKind expected_type)
+static void emit_expression_expected(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, TypeKind expected_type, int prec)
 {
 	if (!expr)
 	{
-		fputs("nil", out);
+		output_string(out, "nil");
 		return;
 	}
 
 	TypeKind actual = expr->type;
 	if (expected_type == TYPE_UNKNOWN || actual == TYPE_UNKNOWN || expected_type == actual)
 	{
-		emit_expression_raw(out, expr, functions);
+		emit_expression_raw(out, expr, functions, prec);
 		return;
 	}
 
 	if (expected_type == TYPE_BOOL)
 	{
-		emit_expression_as_bool(out, expr, functions);
+		emit_expression_as_bool(out, expr, functions, prec);
 		return;
 	}
 
 	if (expected_type == TYPE_INT && actual == TYPE_FLOAT)
 	{
-		fputs("math.floor(", out);
-		emit_expression_raw(out, expr, functions);
-		fputc(')', out);
+		output_string(out, "math.floor(");
+		emit_expression_raw(out, expr, functions, PREC_LOWEST);
+		output_char(out, ')');
 		return;
 	}
 
 	if ((expected_type == TYPE_INT || expected_type == TYPE_FLOAT) && actual == TYPE_BOOL)
 	{
-		fputc('(', out);
-		emit_expression_as_bool(out, expr, functions);
-		fputs(" and 1 or 0)", out);
+		int truth = literal_truth(expr);
+		if (truth >= 0)
+		{
+			output_string(out, truth ? "1" : "0");
+			return;
+		}
+		if (prec > PREC_OR)
+		{
+			output_char(out, '(');
+		}
+		emit_expression_as_bool(out, expr, functions, PREC_AND);
+		output_string(out, " and 1 or 0");
+		if (prec > PREC_OR)
+		{
+			output_char(out, ')');
+		}
 		return;
 	}
 
-	emit_expression_raw(out, expr, functions);
+	emit_expression_raw(out, expr, functions, prec);
 }
 
-static void emit_expression_raw(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+static void emit_expression_raw(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
 {
 	if (!expr)
 	{
-		fputs("nil", out);
+		output_string(out, "nil");
 		return;
 	}
 
 	switch (expr->kind)
 	{
 	case EXPR_INT_LITERAL:
-		fprintf(out, "%lld", expr->data.int_value);
+		/* Lua reads -9223372036854775808 as a negated float. */
+		if (expr->data.int_value == LLONG_MIN)
+		{
+			output_string(out, "math.mininteger");
+		}
+		else
+		{
+			output_int(out, expr->data.int_value);
+		}
 		break;
 	case EXPR_FLOAT_LITERAL:
-		fprintf(out, "%g", expr->data.float_value);
+		output_format(out, "%g", expr->data.float_value);
 		break;
 	case EXPR_BOOL_LITERAL:
-		fputs(expr->data.bool_value ? "true" : "false", out);
+		output_string(out, expr->data.bool_value ? "true" : "false");
 		break;
 	case EXPR_STRING_LITERAL:
 		emit_string_literal(out, expr->data.string_literal);
@@ -316,31 +829,46 @@ static void emit_expression_raw(FILE *out, const AstExpr *expr, const FunctionTa
 		emit_array_literal_expr(out, &expr->data.array_literal.elements, functions);
 		break;
 	case EXPR_IDENTIFIER:
-		fputs(expr->data.identifier, out);
+		output_string(out, expr->data.identifier);
 		break;
 	case EXPR_BINARY:
 		switch (expr->data.binary.op)
 		{
 		case BIN_OP_AND:
-			fputc('(', out);
-			emit_expression_as_bool(out, expr->data.binary.left, functions);
-			fputs(" and ", out);
-			emit_expression_as_bool(out, expr->data.binary.right, functions);
-			fputc(')', out);
-			break;
 		case BIN_OP_OR:
-			fputc('(', out);
-			emit_expression_as_bool(out, expr->data.binary.left, functions);
-			fputs(" or ", out);
-			emit_expression_as_bool(out, expr->data.binary.right, functions);
-			fputc(')', out);
+		{
+			/* true && x and false || x are just x. */
+			int identity = expr->data.binary.op == BIN_OP_AND;
+			int own = identity ? PREC_AND : PREC_OR;
+			const AstExpr *left = expr->data.binary.left;
+			const AstExpr *right = expr->data.binary.right;
+			if (literal_truth(right) == identity)
+			{
+				emit_expression_as_bool(out, left, functions, prec);
+				break;
+			}
+			if (literal_truth(left) == identity)
+			{
+				emit_expression_as_bool(out, right, functions, prec);
+				break;
+			}
+			/* Both are associative, so a right operand using the same
+			 * operator needs no parentheses either. */
+			if (prec > own)
+			{
+				output_char(out, '(');
+			}
+			emit_expression_as_bool(out, left, functions, own);
+			output_string(out, identity ? " and " : " or ");
+			emit_expression_as_bool(out, right, functions, own);
+			if (prec > own)
+			{
+				output_char(out, ')');
+			}
 			break;
+		}
 		default:
-			fputc('(', out);
-			emit_expression_raw(out, expr->data.binary.left, functions);
-			fprintf(out, " %s ", binary_op_token(expr->data.binary.op));
-			emit_expression_raw(out, expr->data.binary.right, functions);
-			fputc(')', out);
+			emit_int_binary(out, expr, functions, prec);
 			break;
 		}
 		break;
@@ -348,123 +876,392 @@ static void emit_expression_raw(FILE *out, const AstExpr *expr, const FunctionTa
 		switch (expr->data.unary.op)
 		{
 		case UN_OP_NEG:
-			fputc('-', out);
-			fputc('(', out);
-			emit_expression_raw(out, expr->data.unary.operand, functions);
-			fputc(')', out);
+			if (expr->data.unary.int_op == INT_OP_WRAP32)
+			{
+				if (prec > PREC_ADD)
+				{
+					output_char(out, '(');
+				}
+				output_char(out, '(');
+				emit_minus(out, expr->data.unary.operand, functions);
+				output_string(out, " + 0x80000000 & 0xFFFFFFFF) - 0x80000000");
+				if (prec > PREC_ADD)
+				{
+					output_char(out, ')');
+				}
+				break;
+			}
+			emit_minus(out, expr->data.unary.operand, functions);
 			break;
 		case UN_OP_NOT:
-			fputs("not (", out);
-			emit_expression_as_bool(out, expr->data.unary.operand, functions);
-			fputc(')', out);
+			emit_negated_condition(out, expr->data.unary.operand, functions, prec);
 			break;
 		case UN_OP_POS:
 		default:
-			emit_expression_raw(out, expr->data.unary.operand, functions);
+			emit_expression_raw(out, expr->data.unary.operand, functions, prec);
 			break;
 		}
 		break;
 	case EXPR_CALL:
-		emit_call(out, expr, functions);
+		emit_call(out, expr, functions, prec);
 		break;
 	case EXPR_SUBSCRIPT:
 		if (expr->data.subscript.array && expr->data.subscript.array->kind == EXPR_IDENTIFIER)
 		{
-			emit_expression_raw(out, expr->data.subscript.array, functions);
+			emit_expression_raw(out, expr->data.subscript.array, functions, PREC_ATOM);
+		}
+		else
+		{
+			output_char(out, '(');
+			emit_expression_raw(out, expr->data.subscript.array, functions, PREC_LOWEST);
+			output_char(out, ')');
+		}
+		output_char(out, '[');
+		if (expr->data.subscript.bounds_check)
+		{
+			emit_checked_index(out, expr->data.subscript.index, expr->data.subscript.array->data.identifier, expr->data.subscript.array_size, functions);
 		}
 		else
 		{
-			fputc('(', out);
-			emit_expression_raw(out, expr->data.subscript.array, functions);
-			fputc(')', out);
+			emit_array_index(out, expr->data.subscript.index, functions);
+		}
+		output_char(out, ']');
+		break;
+	}
+}
+
+/* Arithmetic annotated by the range analysis for --int-semantics=c32: results
+ * that may overflow are wrapped to 32 bits, and division or remainder of
+ * possibly negative operands truncates toward zero as in C. */
+static void emit_int_binary(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
+{
+	const AstExpr *left = expr->data.binary.left;
+	const AstExpr *right = expr->data.binary.right;
+	AstBinaryOp op = expr->data.binary.op;
+	int own = binary_op_precedence(op);
+	switch (expr->data.binary.int_op)
+	{
+	case INT_OP_WRAP32:
+		/* & binds looser than + and -, so the offset sum needs no grouping. */
+		if (prec > PREC_ADD)
+		{
+			output_char(out, '(');
+		}
+		output_char(out, '(');
+		emit_expression_raw(out, left, functions, own);
+		output_char(out, ' ');
+		output_string(out, binary_op_token(op));
+		output_char(out, ' ');
+		emit_expression_raw(out, right, functions, own + 1);
+		output_string(out, " + 0x80000000 & 0xFFFFFFFF) - 0x80000000");
+		if (prec > PREC_ADD)
+		{
+			output_char(out, ')');
+		}
+		return;
+	case INT_OP_FLOOR:
+		own = PREC_MUL;
+		if (prec > own)
+		{
+			output_char(out, '(');
+		}
+		emit_expression_raw(out, left, functions, own);
+		output_string(out, op == BIN_OP_DIV ? " // " : " % ");
+		emit_expression_raw(out, right, functions, own + 1);
+		if (prec > own)
+		{
+			output_char(out, ')');
 		}
-		fputc('[', out);
-		emit_array_index(out, expr->data.subscript.index, functions);
-		fputc(']', out);
+		return;
+	case INT_OP_TRUNC:
+		output_string(out, op == BIN_OP_DIV ? "__cdiv(" : "math.fmod(");
+		emit_expression_raw(out, left, functions, PREC_LOWEST);
+		output_string(out, ", ");
+		emit_expression_raw(out, right, functions, PREC_LOWEST);
+		output_char(out, ')');
+		return;
+	case INT_OP_LUA:
 		break;
 	}
+	if (prec > own)
+	{
+		output_char(out, '(');
+	}
+	emit_expression_raw(out, left, functions, own);
+	output_char(out, ' ');
+	output_string(out, binary_op_token(op));
+	output_char(out, ' ');
+	emit_expression_raw(out, right, functions, own + 1);
+	if (prec > own)
+	{
+		output_char(out, ')');
+	}
 }
 
-static void emit_expression_as_bool(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+static void emit_expression_as_bool(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
 {
 	if (!expr)
 	{
-		fputs("false", out);
+		output_string(out, "false");
 		return;
 	}
 
-	switch (expr->type)
+	int truth = literal_truth(expr);
+	if (truth >= 0)
+	{
+		output_string(out, truth ? "true" : "false");
+		return;
+	}
+
+	switch (expr->type)
 	{
 	case TYPE_BOOL:
-		emit_expression_raw(out, expr, functions);
+		emit_expression_raw(out, expr, functions, prec);
 		break;
 	case TYPE_INT:
 	case TYPE_FLOAT:
-		fputc('(', out);
-		emit_expression_raw(out, expr, functions);
-		fputs(" ~= 0)", out);
+		if (prec > PREC_COMPARE)
+		{
+			output_char(out, '(');
+		}
+		emit_expression_raw(out, expr, functions, PREC_COMPARE);
+		output_string(out, " ~= 0");
+		if (prec > PREC_COMPARE)
+		{
+			output_char(out, ')');
+		}
 		break;
 	default:
-		emit_expression_raw(out, expr, functions);
+		emit_expression_raw(out, expr, functions, prec);
 		break;
 	}
 }
 
-static void emit_call(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+/* Emits !expr without a bool round trip where Lua has a direct form: literals
+ * and numbers compare against zero, double negation cancels and comparisons
+ * flip their operator. */
+static void emit_negated_condition(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
+{
+	AstBinaryOp negated;
+	if (!expr)
+	{
+		output_string(out, "true");
+		return;
+	}
+	int truth = literal_truth(expr);
+	if (truth >= 0)
+	{
+		output_string(out, truth ? "false" : "true");
+		return;
+	}
+	if (expr->kind == EXPR_UNARY && expr->data.unary.op == UN_OP_NOT)
+	{
+		emit_expression_as_bool(out, expr->data.unary.operand, functions, prec);
+		return;
+	}
+	if (negated_comparison(expr, &negated))
+	{
+		if (prec > PREC_COMPARE)
+		{
+			output_char(out, '(');
+		}
+		emit_expression_raw(out, expr->data.binary.left, functions, PREC_COMPARE);
+		output_char(out, ' ');
+		output_string(out, binary_op_token(negated));
+		output_char(out, ' ');
+		emit_expression_raw(out, expr->data.binary.right, functions, PREC_COMPARE + 1);
+		if (prec > PREC_COMPARE)
+		{
+			output_char(out, ')');
+		}
+		return;
+	}
+	if (expr->type == TYPE_INT || expr->type == TYPE_FLOAT)
+	{
+		if (prec > PREC_COMPARE)
+		{
+			output_char(out, '(');
+		}
+		emit_expression_raw(out, expr, functions, PREC_COMPARE);
+		output_string(out, " == 0");
+		if (prec > PREC_COMPARE)
+		{
+			output_char(out, ')');
+		}
+		return;
+	}
+	if (prec > PREC_UNARY)
+	{
+		output_char(out, '(');
+	}
+	output_string(out, "not ");
+	emit_expression_as_bool(out, expr, functions, PREC_UNARY);
+	if (prec > PREC_UNARY)
+	{
+		output_char(out, ')');
+	}
+}
+
+/* Ordered comparisons only flip for ints: with a NaN operand both a < b and
+ * a >= b are false. */
+static int negated_comparison(const AstExpr *expr, AstBinaryOp *negated)
+{
+	if (expr->kind != EXPR_BINARY)
+	{
+		return 0;
+	}
+	int ints = expr->data.binary.left->type == TYPE_INT && expr->data.binary.right->type == TYPE_INT;
+	switch (expr->data.binary.op)
+	{
+	case BIN_OP_EQ:
+		*negated = BIN_OP_NEQ;
+		return 1;
+	case BIN_OP_NEQ:
+		*negated = BIN_OP_EQ;
+		return 1;
+	case BIN_OP_LT:
+		*negated = BIN_OP_GE;
+		return ints;
+	case BIN_OP_LE:
+		*negated = BIN_OP_GT;
+		return ints;
+	case BIN_OP_GT:
+		*negated = BIN_OP_LE;
+		return ints;
+	case BIN_OP_GE:
+		*negated = BIN_OP_LT;
+		return ints;
+	default:
+		return 0;
+	}
+}
+
+/* 1 or 0 for a literal or a logical combination of literals, -1 for anything
+ * that needs evaluating. */
+static int literal_truth(const AstExpr *expr)
+{
+	if (!expr)
+	{
+		return -1;
+	}
+	switch (expr->kind)
+	{
+	case EXPR_UNARY:
+	{
+		if (expr->data.unary.op != UN_OP_NOT)
+		{
+			return -1;
+		}
+		int operand = literal_truth(expr->data.unary.operand);
+		return operand < 0 ? -1 : !operand;
+	}
+	case EXPR_BINARY:
+	{
+		if (expr->data.binary.op != BIN_OP_AND && expr->data.binary.op != BIN_OP_OR)
+		{
+			return -1;
+		}
+		int left = literal_truth(expr->data.binary.left);
+		int right = literal_truth(expr->data.binary.right);
+		if (left < 0 || right < 0)
+		{
+			return -1;
+		}
+		return expr->data.binary.op == BIN_OP_AND ? left && right : left || right;
+	}
+	case EXPR_BOOL_LITERAL:
+		return expr->data.bool_value != 0;
+	case EXPR_INT_LITERAL:
+		return expr->data.int_value != 0;
+	case EXPR_FLOAT_LITERAL:
+		return expr->data.float_value != 0.0;
+	default:
+		return -1;
+	}
+}
+
+static void emit_call(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
 {
 	if (strcmp(expr->data.call.callee, "printf") == 0)
 	{
-		emit_printf_call(out, expr, functions);
+		emit_printf_call(out, expr, functions, prec);
 		return;
 	}
 	if (strcmp(expr->data.call.callee, "puts") == 0)
 	{
-		emit_puts_call(out, expr, functions);
+		emit_puts_call(out, expr, functions, prec);
 		return;
 	}
 	const FunctionSignature *signature = lookup_signature(functions, expr->data.call.callee);
-	fputs(expr->data.call.callee, out);
-	fputc('(', out);
+	output_string(out, storage_prefix(signature));
+	output_string(out, expr->data.call.callee);
+	output_char(out, '(');
 	for (size_t i = 0; i < expr->data.call.args.count; ++i)
 	{
 		if (i > 0)
 		{
-			fputs(", ", out);
+			output_string(out, ", ");
 		}
 		TypeKind expected = TYPE_UNKNOWN;
 		if (signature && i < signature->params.count)
 		{
 			expected = signature->params.items[i].type;
 		}
-		emit_expression_expected(out, expr->data.call.args.items[i], functions, expected);
+		emit_expression_expected(out, expr->data.call.args.items[i], functions, expected, PREC_LOWEST);
 	}
-	fputc(')', out);
+	output_char(out, ')');
 }
 
-static void emit_printf_call(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+/* print returns nothing, so printf and puts read as 0 when used as values. */
+static void emit_printf_call(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
 {
-	fputs("((print(string.format(", out);
-	emit_printf_args(out, expr, functions);
-	fputs("))) or 0)", out);
+	if (prec > PREC_OR)
+	{
+		output_char(out, '(');
+	}
+	if (emit_constant_printf(NULL, expr))
+	{
+		output_string(out, "print(");
+		emit_constant_printf(out, expr);
+		output_string(out, ") or 0");
+	}
+	else
+	{
+		output_string(out, "print(string.format(");
+		emit_printf_args(out, expr, functions);
+		output_string(out, ")) or 0");
+	}
+	if (prec > PREC_OR)
+	{
+		output_char(out, ')');
+	}
 }
 
-static void emit_puts_call(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+static void emit_puts_call(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int prec)
 {
-	fputs("((print(", out);
+	if (prec > PREC_OR)
+	{
+		output_char(out, '(');
+	}
+	output_string(out, "print(");
 	if (expr->data.call.args.count > 0)
 	{
-		emit_expression_raw(out, expr->data.call.args.items[0], functions);
+		emit_expression_raw(out, expr->data.call.args.items[0], functions, PREC_LOWEST);
+	}
+	output_string(out, ") or 0");
+	if (prec > PREC_OR)
+	{
+		output_char(out, ')');
 	}
-	fputs(")) or 0)", out);
 }
 
-static void emit_printf_args(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+static void emit_printf_args(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions)
 {
 	for (size_t i = 0; i < expr->data.call.args.count; ++i)
 	{
 		if (i > 0)
 		{
-			fputs(", ", out);
+			output_string(out, ", ");
 		}
 		if (i == 0 && expr->data.call.args.items[i]->kind == EXPR_STRING_LITERAL)
 		{
@@ -476,72 +1273,410 @@ static void emit_printf_args(FILE *out, const AstExpr *expr, const FunctionTable
 				continue;
 			}
 		}
-		emit_expression_raw(out, expr->data.call.args.items[i], functions);
+		const AstExpr *arg = expr->data.call.args.items[i];
+		TypeKind expected = arg->type;
+		const AstExpr *format = expr->data.call.args.items[0];
+		char conversion = format->kind == EXPR_STRING_LITERAL ? printf_conversion(format->data.string_literal, i) : '\0';
+		if (expected == TYPE_BOOL && i > 0 && conversion != '\0' && strchr("dicuxXo", conversion))
+		{
+			/* string.format rejects booleans for integer conversions. */
+			expected = TYPE_INT;
+		}
+		emit_expression_expected(out, arg, functions, expected, PREC_LOWEST);
 	}
 }
 
-static void emit_string_literal_n(FILE *out, const char *value, size_t length)
+/* Conversion character of the position-th argument, 1-based. */
+static char printf_conversion(const char *format, size_t position)
+{
+	size_t seen = 0;
+	for (const char *p = format; p && *p; ++p)
+	{
+		if (*p != '%')
+		{
+			continue;
+		}
+		++p;
+		if (*p == '%')
+		{
+			continue;
+		}
+		while (*p && strchr("-+ #0123456789.lh", *p))
+		{
+			++p;
+		}
+		if (!*p)
+		{
+			break;
+		}
+		if (++seen == position)
+		{
+			return *p;
+		}
+	}
+	return '\0';
+}
+
+/* A printf whose format and arguments are all literals is formatted here the
+ * way string.format would at run time, leaving only the text to print. With
+ * a NULL stream it only checks; conversions that cannot be reproduced
+ * exactly, or that would raise an error in Lua, keep the runtime call. */
+static int emit_constant_printf(OutputBuffer *out, const AstExpr *expr)
+{
+	const AstExprList *args = &expr->data.call.args;
+	if (args->count == 0 || args->items[0]->kind != EXPR_STRING_LITERAL || !args->items[0]->data.string_literal)
+	{
+		return 0;
+	}
+	const char *format = args->items[0]->data.string_literal;
+	size_t length = strlen(format);
+	if (length > 0 && format[length - 1] == '\n')
+	{
+		length--;
+	}
+	size_t next = 1;
+	if (out)
+	{
+		output_char(out, '"');
+	}
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (format[i] != '%')
+		{
+			if (out)
+			{
+				emit_string_chars(out, &format[i], 1);
+			}
+			continue;
+		}
+		if (i + 1 < length && format[i + 1] == '%')
+		{
+			if (out)
+			{
+				output_char(out, '%');
+			}
+			++i;
+			continue;
+		}
+		char spec[16];
+		char conversion;
+		char buffer[512];
+		const char *text;
+		size_t text_length;
+		if (next >= args->count || !parse_printf_spec(format, i, length, spec, &conversion, &i) ||
+			!format_constant_argument(args->items[next++], spec, conversion, buffer, sizeof(buffer), &text, &text_length))
+		{
+			return 0;
+		}
+		if (out)
+		{
+			emit_string_chars(out, text, text_length);
+		}
+	}
+	if (out)
+	{
+		output_char(out, '"');
+	}
+	return 1;
+}
+
+/* Accepts only what both Lua 5.3 and 5.4 format alike: flags valid for the
+ * conversion, at most two digits of width and of precision. */
+static int parse_printf_spec(const char *format, size_t start, size_t length, char *spec, char *conversion, size_t *end)
+{
+	size_t p = start + 1;
+	size_t used = 0;
+	spec[used++] = '%';
+	while (p < length && format[p] && strchr("-+ #0", format[p]))
+	{
+		if (used > 5)
+		{
+			return 0;
+		}
+		spec[used++] = format[p++];
+	}
+	size_t flag_count = used - 1;
+	for (int digits = 0; p < length && format[p] >= '0' && format[p] <= '9'; ++digits)
+	{
+		if (digits == 2)
+		{
+			return 0;
+		}
+		spec[used++] = format[p++];
+	}
+	if (p < length && format[p] == '.')
+	{
+		spec[used++] = format[p++];
+		for (int digits = 0; p < length && format[p] >= '0' && format[p] <= '9'; ++digits)
+		{
+			if (digits == 2)
+			{
+				return 0;
+			}
+			spec[used++] = format[p++];
+		}
+	}
+	spec[used] = '\0';
+	if (p >= length || !format[p])
+	{
+		return 0;
+	}
+	const char *flags;
+	switch (format[p])
+	{
+	case 'd':
+	case 'i':
+		flags = "-+ 0";
+		break;
+	case 'x':
+	case 'X':
+		flags = "-#0";
+		break;
+	case 'e':
+	case 'E':
+	case 'f':
+	case 'g':
+	case 'G':
+		flags = "-+ #0";
+		break;
+	case 's':
+		flags = "-";
+		break;
+	default:
+		return 0;
+	}
+	for (size_t i = 1; i <= flag_count; ++i)
+	{
+		if (!strchr(flags, spec[i]))
+		{
+			return 0;
+		}
+	}
+	*conversion = format[p];
+	*end = p;
+	return 1;
+}
+
+static int format_constant_argument(const AstExpr *arg, const char *spec, char conversion, char *buffer, size_t size,
+									const char **text, size_t *text_length)
+{
+	char full[24];
+	int is_integer = 0;
+	long long integer = 0;
+	double number = 0.0;
+	int written;
+	switch (conversion)
+	{
+	case 'd':
+	case 'i':
+	case 'x':
+	case 'X':
+		if (arg->kind == EXPR_BOOL_LITERAL)
+		{
+			integer = arg->data.bool_value ? 1 : 0;
+		}
+		else if (!literal_lua_number(arg, &is_integer, &integer, &number))
+		{
+			return 0;
+		}
+		else if (!is_integer)
+		{
+			/* string.format only takes floats with an exact integer value. */
+			if (!(number >= -9223372036854775808.0 && number < 9223372036854775808.0) || (double)(long long)number != number)
+			{
+				return 0;
+			}
+			integer = (long long)number;
+		}
+		snprintf(full, sizeof(full), "%sll%c", spec, conversion);
+		written = snprintf(buffer, size, full, integer);
+		break;
+	case 's':
+	{
+		const char *source = buffer;
+		size_t source_length;
+		if (arg->kind == EXPR_STRING_LITERAL && arg->data.string_literal)
+		{
+			source = arg->data.string_literal;
+			source_length = strlen(source);
+		}
+		else if (arg->kind == EXPR_BOOL_LITERAL)
+		{
+			source = arg->data.bool_value ? "true" : "false";
+			source_length = strlen(source);
+		}
+		else if (!literal_lua_number(arg, &is_integer, &integer, &number))
+		{
+			return 0;
+		}
+		else if (is_integer)
+		{
+			source_length = (size_t)snprintf(buffer, size, "%lld", integer);
+		}
+		else
+		{
+			source_length = (size_t)snprintf(buffer, size, "%.14g", number);
+			if (buffer[strspn(buffer, "-0123456789")] == '\0')
+			{
+				source_length += (size_t)snprintf(buffer + source_length, size - source_length, ".0");
+			}
+		}
+		const char *dot = strchr(spec, '.');
+		size_t width = strtoul(spec + strspn(spec, "%-"), NULL, 10);
+		size_t shown = source_length;
+		if (dot && (size_t)strtoul(dot + 1, NULL, 10) < shown)
+		{
+			shown = strtoul(dot + 1, NULL, 10);
+		}
+		if (shown >= width)
+		{
+			*text = source;
+			*text_length = shown;
+			return 1;
+		}
+		char padded[128];
+		size_t pad = width - shown;
+		if (spec[1] == '-')
+		{
+			memcpy(padded, source, shown);
+			memset(padded + shown, ' ', pad);
+		}
+		else
+		{
+			memset(padded, ' ', pad);
+			memcpy(padded + pad, source, shown);
+		}
+		memcpy(buffer, padded, width);
+		*text = buffer;
+		*text_length = width;
+		return 1;
+	}
+	default:
+		if (!literal_lua_number(arg, &is_integer, &integer, &number))
+		{
+			return 0;
+		}
+		snprintf(full, sizeof(full), "%s%c", spec, conversion);
+		written = snprintf(buffer, size, full, is_integer ? (double)integer : number);
+		break;
+	}
+	if (written < 0 || (size_t)written >= size)
+	{
+		return 0;
+	}
+	*text = buffer;
+	*text_length = (size_t)written;
+	return 1;
+}
+
+/* The number Lua reads back from the emitted literal. Floats are written with
+ * %g, which drops the point from integral values and so yields a Lua integer. */
+static int literal_lua_number(const AstExpr *arg, int *is_integer, long long *integer, double *number)
+{
+	if (arg->kind == EXPR_INT_LITERAL)
+	{
+		*is_integer = 1;
+		*integer = arg->data.int_value;
+		return 1;
+	}
+	if (arg->kind != EXPR_FLOAT_LITERAL)
+	{
+		return 0;
+	}
+	char text[64];
+	snprintf(text, sizeof(text), "%g", arg->data.float_value);
+	if (strpbrk(text, "in"))
+	{
+		return 0;
+	}
+	if (strpbrk(text, ".e"))
+	{
+		*is_integer = 0;
+		*number = strtod(text, NULL);
+		return 1;
+	}
+	*is_integer = 1;
+	*integer = strtoll(text, NULL, 10);
+	return 1;
+}
+
+static void emit_string_literal_n(OutputBuffer *out, const char *value, size_t length)
 {
 	if (!value)
 	{
-		fputs("\"\"", out);
+		output_string(out, "\"\"");
 		return;
 	}
-	fputc('"', out);
+	output_char(out, '"');
+	emit_string_chars(out, value, length);
+	output_char(out, '"');
+}
+
+static void emit_string_chars(OutputBuffer *out, const char *value, size_t length)
+{
 	for (size_t i = 0; i < length; ++i)
 	{
 		unsigned char c = (unsigned char)value[i];
 		switch (c)
 		{
 		case '\\':
-			fputs("\\\\", out);
+			output_string(out, "\\\\");
 			break;
 		case '"':
-			fputs("\\\"", out);
+			output_string(out, "\\\"");
 			break;
 		case '\n':
-			fputs("\\n", out);
+			output_string(out, "\\n");
 			break;
 		case '\r':
-			fputs("\\r", out);
+			output_string(out, "\\r");
 			break;
 		case '\t':
-			fputs("\\t", out);
+			output_string(out, "\\t");
 			break;
 		default:
 			if (c < 32 || c == 127)
 			{
-				fprintf(out, "\\x%02X", c);
+				char escape[4] = {'\\', 'x', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 15]};
+				output_bytes(out, escape, sizeof(escape));
 			}
 			else
 			{
-				fputc(c, out);
+				output_char(out, c);
 			}
 			break;
 		}
 	}
-	fputc('"', out);
 }
 
-static void emit_string_literal(FILE *out, const char *value)
+static void emit_string_literal(OutputBuffer *out, const char *value)
 {
 	if (!value)
 	{
-		fputs("\"\"", out);
+		output_string(out, "\"\"");
 		return;
 	}
 	emit_string_literal_n(out, value, strlen(value));
 }
 
-static void emit_array_declaration(FILE *out, const AstStmt *stmt, const FunctionTable *functions, int indent)
+static void emit_array_declaration(OutputBuffer *out, const AstStmt *stmt, const FunctionTable *functions, int indent)
 {
 	if (!stmt)
 	{
 		return;
 	}
 	const AstExpr *init = stmt->data.decl.array_init;
-	emit_indent(out, indent);
-	fprintf(out, "local %s = {", stmt->data.decl.name);
+	output_indent(out, indent);
+	output_string(out, stmt->data.decl.spilled ? "" : "local ");
+	output_string(out, stmt->data.decl.name);
+	output_string(out, stmt->data.decl.is_const ? " <const> = " : " = ");
+	if (init && init->kind == EXPR_IDENTIFIER)
+	{
+		output_string(out, init->data.identifier);
+		output_char(out, '\n');
+		return;
+	}
+	output_char(out, '{');
 	size_t emitted = 0;
 	int first = 1;
 	if (init && init->kind == EXPR_ARRAY_LITERAL)
@@ -551,14 +1686,14 @@ static void emit_array_declaration(FILE *out, const AstStmt *stmt, const Functio
 		{
 			if (first)
 			{
-				fputc(' ', out);
+				output_char(out, ' ');
 				first = 0;
 			}
 			else
 			{
-				fputs(", ", out);
+				output_string(out, ", ");
 			}
-			emit_expression_expected(out, elements->items[i], functions, stmt->data.decl.type);
+			emit_expression_expected(out, elements->items[i], functions, stmt->data.decl.type, PREC_LOWEST);
 			emitted++;
 		}
 	}
@@ -566,21 +1701,21 @@ static void emit_array_declaration(FILE *out, const AstStmt *stmt, const Functio
 	{
 		if (first)
 		{
-			fputc(' ', out);
+			output_char(out, ' ');
 			first = 0;
 		}
 		else
 		{
-			fputs(", ", out);
+			output_string(out, ", ");
 		}
 		emit_array_default_value(out, stmt->data.decl.type);
 	}
-	fputs(" }\n", out);
+	output_string(out, " }\n");
 }
 
-static void emit_array_literal_expr(FILE *out, const AstExprList *elements, const FunctionTable *functions)
+static void emit_array_literal_expr(OutputBuffer *out, const AstExprList *elements, const FunctionTable *functions)
 {
-	fputc('{', out);
+	output_char(out, '{');
 	int first = 1;
 	if (elements)
 	{
@@ -588,58 +1723,184 @@ static void emit_array_literal_expr(FILE *out, const AstExprList *elements, cons
 		{
 			if (first)
 			{
-				fputc(' ', out);
+				output_char(out, ' ');
 				first = 0;
 			}
 			else
 			{
-				fputs(", ", out);
+				output_string(out, ", ");
 			}
-			emit_expression_raw(out, elements->items[i], functions);
+			emit_expression_raw(out, elements->items[i], functions, PREC_LOWEST);
 		}
 	}
 	if (first)
 	{
-		fputc(' ', out);
+		output_char(out, ' ');
+	}
+	output_string(out, " }");
+}
+
+static void emit_array_index(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions)
+{
+	emit_int_with_offset(out, expr, 1, functions);
+}
+
+static void emit_checked_index(OutputBuffer *out, const AstExpr *expr, const char *array_name, size_t array_size, const FunctionTable *functions)
+{
+	output_string(out, "__check_index(");
+	emit_int_with_offset(out, expr, 0, functions);
+	if (array_size > 0)
+	{
+		output_string(out, ", ");
+		output_size(out, array_size);
+		output_char(out, ')');
+	}
+	else
+	{
+		output_string(out, ", #");
+		output_string(out, array_name);
+		output_char(out, ')');
+	}
+}
+
+static void emit_bounds_helper(OutputBuffer *out)
+{
+	output_string(out, "local function __check_index(index, size)\n");
+	output_string(out, "\tif index < 0 or index >= size then\n");
+	output_string(out, "\t\terror(\"array index \" .. index .. \" out of bounds for size \" .. size, 2)\n");
+	output_string(out, "\tend\n");
+	output_string(out, "\treturn index + 1\n");
+	output_string(out, "end\n\n");
+}
+
+static void emit_int32_helpers(OutputBuffer *out)
+{
+	output_string(out, "local function __cdiv(a, b)\n");
+	output_string(out, "\tlocal q = (a - math.fmod(a, b)) // b\n");
+	output_string(out, "\treturn ((q + 0x80000000) & 0xFFFFFFFF) - 0x80000000\n");
+	output_string(out, "end\n\n");
+}
+
+static void emit_int_with_offset(OutputBuffer *out, const AstExpr *expr, long long extra, const FunctionTable *functions)
+{
+	long long offset = offset_of_additive(expr) + extra;
+	size_t terms = count_additive_terms(expr);
+	if (terms == 0)
+	{
+		output_int(out, offset);
+		return;
+	}
+	int first = 1;
+	if (offset != 0 && leading_additive_term_negated(expr, 0))
+	{
+		output_int(out, offset);
+		offset = 0;
+		first = 0;
+	}
+	emit_additive_terms(out, expr, 0, &first, terms > 1 || offset != 0 ? PREC_ADD : PREC_LOWEST, functions);
+	if (offset > 0)
+	{
+		output_string(out, " + ");
+		output_int(out, offset);
+	}
+	else if (offset < 0)
+	{
+		output_string(out, " - ");
+		output_int(out, -offset);
 	}
-	fputs(" }", out);
 }
 
-static void emit_array_index(FILE *out, const AstExpr *expr, const FunctionTable *functions)
+static int is_int_additive(const AstExpr *expr)
 {
-	if (expr && expr->kind == EXPR_INT_LITERAL)
+	return expr && expr->kind == EXPR_BINARY && expr->type == TYPE_INT && expr->data.binary.int_op == INT_OP_LUA &&
+		   (expr->data.binary.op == BIN_OP_ADD || expr->data.binary.op == BIN_OP_SUB);
+}
+
+static size_t count_additive_terms(const AstExpr *expr)
+{
+	if (is_int_additive(expr))
 	{
-		fprintf(out, "%lld", expr->data.int_value + 1);
+		return count_additive_terms(expr->data.binary.left) + count_additive_terms(expr->data.binary.right);
+	}
+	return (!expr || expr->kind == EXPR_INT_LITERAL) ? 0 : 1;
+}
+
+static int leading_additive_term_negated(const AstExpr *expr, int negate)
+{
+	if (!is_int_additive(expr))
+	{
+		return negate;
+	}
+	if (count_additive_terms(expr->data.binary.left) > 0)
+	{
+		return leading_additive_term_negated(expr->data.binary.left, negate);
+	}
+	return leading_additive_term_negated(expr->data.binary.right, expr->data.binary.op == BIN_OP_SUB ? !negate : negate);
+}
+
+static long long offset_of_additive(const AstExpr *expr)
+{
+	if (is_int_additive(expr))
+	{
+		long long right = offset_of_additive(expr->data.binary.right);
+		long long left = offset_of_additive(expr->data.binary.left);
+		return expr->data.binary.op == BIN_OP_ADD ? left + right : left - right;
+	}
+	return (expr && expr->kind == EXPR_INT_LITERAL) ? expr->data.int_value : 0;
+}
+
+/* Emits the non-literal terms of an integer +/- chain; literal terms are folded into one constant by offset_of_additive.
+ * The leading term is emitted at prec, later ones as right operands of + or -. */
+static void emit_additive_terms(OutputBuffer *out, const AstExpr *expr, int negate, int *first, int prec, const FunctionTable *functions)
+{
+	if (!expr || expr->kind == EXPR_INT_LITERAL)
+	{
+		return;
+	}
+	if (is_int_additive(expr))
+	{
+		emit_additive_terms(out, expr->data.binary.left, negate, first, prec, functions);
+		emit_additive_terms(out, expr->data.binary.right, expr->data.binary.op == BIN_OP_SUB ? !negate : negate, first, prec, functions);
 		return;
 	}
-	fputc('(', out);
-	emit_expression_raw(out, expr, functions);
-	fputs(" + 1)", out);
+	if (*first && negate)
+	{
+		emit_minus(out, expr, functions);
+	}
+	else
+	{
+		if (!*first)
+		{
+			output_string(out, negate ? " - " : " + ");
+		}
+		emit_expression_raw(out, expr, functions, *first ? prec : PREC_ADD + 1);
+	}
+	*first = 0;
 }
 
-static void emit_array_default_value(FILE *out, TypeKind type)
+static void emit_array_default_value(OutputBuffer *out, TypeKind type)
 {
 	switch (type)
 	{
 	case TYPE_INT:
-		fputs("0", out);
+		output_string(out, "0");
 		break;
 	case TYPE_FLOAT:
-		fputs("0.0", out);
+		output_string(out, "0.0");
 		break;
 	case TYPE_BOOL:
-		fputs("false", out);
+		output_string(out, "false");
 		break;
 	case TYPE_STRING:
 		emit_string_literal(out, "");
 		break;
 	default:
-		fputs("nil", out);
+		output_string(out, "nil");
 		break;
 	}
 }
 
-static int emit_builtin_expr_statement(FILE *out, const AstExpr *expr, const FunctionTable *functions, int indent)
+static int emit_builtin_expr_statement(OutputBuffer *out, const AstExpr *expr, const FunctionTable *functions, int indent)
 {
 	if (!expr || expr->kind != EXPR_CALL)
 	{
@@ -647,21 +1908,28 @@ static int emit_builtin_expr_statement(FILE *out, const AstExpr *expr, const Fun
 	}
 	if (strcmp(expr->data.call.callee, "printf") == 0)
 	{
-		emit_indent(out, indent);
-		fputs("print(string.format(", out);
+		output_indent(out, indent);
+		if (emit_constant_printf(NULL, expr))
+		{
+			output_string(out, "print(");
+			emit_constant_printf(out, expr);
+			output_string(out, ")\n");
+			return 1;
+		}
+		output_string(out, "print(string.format(");
 		emit_printf_args(out, expr, functions);
-		fputs("))\n", out);
+		output_string(out, "))\n");
 		return 1;
 	}
 	if (strcmp(expr->data.call.callee, "puts") == 0)
 	{
-		emit_indent(out, indent);
-		fputs("print(", out);
+		output_indent(out, indent);
+		output_string(out, "print(");
 		if (expr->data.call.args.count > 0)
 		{
-			emit_expression_raw(out, expr->data.call.args.items[0], functions);
+			emit_expression_raw(out, expr->data.call.args.items[0], functions, PREC_LOWEST);
 		}
-		fputs(")\n", out);
+		output_string(out, ")\n");
 		return 1;
 	}
 	return 0;
@@ -676,6 +1944,11 @@ static const FunctionSignature *lookup_signature(const FunctionTable *functions,
 	return function_table_find(functions, name);
 }
 
+static const char *storage_prefix(const FunctionSignature *signature)
+{
+	return signature && signature->storage == FUNCTION_TABLE ? "__fn." : "";
+}
+
 static const char *binary_op_token(AstBinaryOp op)
 {
 	switch (op)
@@ -710,10 +1983,64 @@ static const char *binary_op_token(AstBinaryOp op)
 	return "?";
 }
 
-static void emit_indent(FILE *out, int indent)
+static int binary_op_precedence(AstBinaryOp op)
+{
+	switch (op)
+	{
+	case BIN_OP_ADD:
+	case BIN_OP_SUB:
+		return PREC_ADD;
+	case BIN_OP_MUL:
+	case BIN_OP_DIV:
+	case BIN_OP_MOD:
+		return PREC_MUL;
+	case BIN_OP_EQ:
+	case BIN_OP_NEQ:
+	case BIN_OP_LT:
+	case BIN_OP_LE:
+	case BIN_OP_GT:
+	case BIN_OP_GE:
+		return PREC_COMPARE;
+	case BIN_OP_AND:
+		return PREC_AND;
+	case BIN_OP_OR:
+		return PREC_OR;
+	}
+	return PREC_LOWEST;
+}
+
+/* Unary minus; an operand that itself starts with a minus is parenthesized,
+ * since "--" would open a comment. */
+static void emit_minus(OutputBuffer *out, const AstExpr *operand, const FunctionTable *functions)
 {
-	for (int i = 0; i < indent; ++i)
+	if (starts_with_minus(operand))
 	{
-		fputs("\t", out);
+		output_string(out, "-(");
+		emit_expression_raw(out, operand, functions, PREC_LOWEST);
+		output_char(out, ')');
+		return;
 	}
+	output_char(out, '-');
+	emit_expression_raw(out, operand, functions, PREC_UNARY);
 }
+
+/* Whether the emitted text of expr begins with a minus sign. */
+static int starts_with_minus(const AstExpr *expr)
+{
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+		return expr->data.int_value < 0;
+	case EXPR_FLOAT_LITERAL:
+		return signbit(expr->data.float_value) != 0;
+	case EXPR_UNARY:
+		if (expr->data.unary.op == UN_OP_NEG)
+		{
+			return expr->data.unary.int_op != INT_OP_WRAP32;
+		}
+		return expr->data.unary.op == UN_OP_POS && starts_with_minus(expr->data.unary.operand);
+	default:
+		return 0;
+	}
+}
+
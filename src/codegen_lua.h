@@ -1,11 +1,14 @@
 #ifndef CODEGEN_LUA_H
 #define CODEGEN_LUA_H
 
+#include <stddef.h>
 #include <stdio.h>
 
 #include "ast.h"
+#include "options.h"
 #include "symbol_table.h"
 
-void codegen_lua_emit(FILE *out, const AstProgram *program, const FunctionTable *functions);
+int codegen_lua_emit(FILE *out, const AstProgram *program, const FunctionTable *functions, const CompilerOptions *options);
+char *codegen_lua_emit_string(const AstProgram *program, const FunctionTable *functions, const CompilerOptions *options, size_t *length);
 
 #endif
@@ -0,0 +1,910 @@
+#include "evaluator.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EVAL_DEPTH_LIMIT 64
+
+typedef enum
+{
+	VALUE_NIL,
+	VALUE_INT,
+	VALUE_FLOAT,
+	VALUE_BOOL,
+	VALUE_ARRAY
+} ValueKind;
+
+struct ValueArray;
+
+typedef struct
+{
+	ValueKind kind;
+	union
+	{
+		long long int_value;
+		double float_value;
+		int bool_value;
+		struct ValueArray *array;
+	} as;
+} Value;
+
+typedef struct ValueArray
+{
+	Value *items;
+	size_t count;
+} ValueArray;
+
+typedef struct
+{
+	const char *name;
+	Value value;
+} Binding;
+
+typedef struct
+{
+	Binding *items;
+	size_t count;
+	size_t capacity;
+} Environment;
+
+typedef enum
+{
+	EXEC_NORMAL,
+	EXEC_RETURN,
+	EXEC_FAIL
+} ExecStatus;
+
+typedef struct
+{
+	const AstProgram *program;
+	const FunctionTable *functions;
+	size_t steps;
+	size_t step_limit;
+	size_t depth;
+	int c32;
+	Value result;
+} Evaluator;
+
+static int call_function(Evaluator *ev, const AstExpr *call, const Environment *caller, Value *out);
+static ExecStatus exec_statement(Evaluator *ev, const AstStmt *stmt, Environment *env, TypeKind return_type);
+static ExecStatus exec_statements(Evaluator *ev, const AstStmtList *list, Environment *env, TypeKind return_type);
+static int eval_expression(Evaluator *ev, const AstExpr *expr, const Environment *env, Value *out);
+static int eval_expected(Evaluator *ev, const AstExpr *expr, const Environment *env, TypeKind expected, Value *out);
+static int eval_condition(Evaluator *ev, const AstExpr *expr, const Environment *env, int *out);
+static int eval_binary(Evaluator *ev, const AstExpr *expr, const Environment *env, Value *out);
+static int eval_index(Evaluator *ev, const AstExpr *index, const Environment *env, const ValueArray *array, size_t *out);
+static int arithmetic(AstBinaryOp op, Value left, Value right, int c_int, Value *out);
+static long long wrap_int32(long long value);
+static int compare(AstBinaryOp op, Value left, Value right, Value *out);
+static int convert(Value value, TypeKind actual, TypeKind expected, Value *out);
+static int truthy(Value value, TypeKind type, int *out);
+static int as_double(Value value, double *out);
+static Value literal_value(const AstExpr *expr);
+static AstExpr *value_to_literal(Value value);
+static const AstFunction *find_function(const AstProgram *program, const char *name);
+static void bind(Environment *env, const char *name, Value value);
+static Binding *lookup(const Environment *env, const char *name);
+static void unwind(Environment *env, size_t count);
+static int tick(Evaluator *ev);
+static void *xcalloc(size_t n, size_t size);
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed);
+
+/* Runs a call with literal arguments the way the generated Lua would: integer
+ * arithmetic wraps (at 32 bits under --int-semantics=c32), '/' yields a float
+ * unless C int semantics ask for truncation, and literals go through the same
+ * %g spelling codegen uses. Anything the interpreter cannot reproduce exactly,
+ * or that exceeds the step or depth budget, leaves the call untouched. */
+AstExpr *evaluator_call(const AstProgram *program, const FunctionTable *functions, const AstExpr *call, const CompilerOptions *options)
+{
+	if (!program || !functions || !call || call->kind != EXPR_CALL || !options || options->eval_limit == 0)
+	{
+		return NULL;
+	}
+	Evaluator ev = {0};
+	ev.program = program;
+	ev.functions = functions;
+	ev.step_limit = options->eval_limit;
+	ev.c32 = options->int_semantics == INT_SEMANTICS_C32;
+	Environment empty = {0};
+	Value value;
+	if (!call_function(&ev, call, &empty, &value))
+	{
+		return NULL;
+	}
+	return value_to_literal(value);
+}
+
+static int call_function(Evaluator *ev, const AstExpr *call, const Environment *caller, Value *out)
+{
+	const FunctionSignature *signature = function_table_find(ev->functions, call->data.call.callee);
+	const AstFunction *fn = find_function(ev->program, call->data.call.callee);
+	if (!signature || !signature->is_pure || !fn || fn->params.count != call->data.call.args.count ||
+		ev->depth >= EVAL_DEPTH_LIMIT)
+	{
+		return 0;
+	}
+
+	Environment env = {0};
+	int ok = 1;
+	for (size_t i = 0; ok && i < fn->params.count; ++i)
+	{
+		Value arg;
+		ok = eval_expected(ev, call->data.call.args.items[i], caller, fn->params.items[i].type, &arg);
+		if (ok)
+		{
+			bind(&env, fn->params.items[i].name, arg);
+		}
+	}
+
+	ExecStatus status = EXEC_FAIL;
+	if (ok)
+	{
+		ev->depth++;
+		status = exec_statements(ev, &fn->body.statements, &env, fn->return_type);
+		ev->depth--;
+	}
+	unwind(&env, 0);
+	free(env.items);
+	if (status != EXEC_RETURN)
+	{
+		return 0;
+	}
+	*out = ev->result;
+	return 1;
+}
+
+static ExecStatus exec_statements(Evaluator *ev, const AstStmtList *list, Environment *env, TypeKind return_type)
+{
+	size_t mark = env->count;
+	ExecStatus status = EXEC_NORMAL;
+	for (size_t i = 0; status == EXEC_NORMAL && i < list->count; ++i)
+	{
+		status = exec_statement(ev, list->items[i], env, return_type);
+	}
+	unwind(env, mark);
+	return status;
+}
+
+static ExecStatus exec_statement(Evaluator *ev, const AstStmt *stmt, Environment *env, TypeKind return_type)
+{
+	if (!stmt)
+	{
+		return EXEC_NORMAL;
+	}
+	if (!tick(ev))
+	{
+		return EXEC_FAIL;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		return exec_statements(ev, &stmt->data.block.statements, env, return_type);
+	case STMT_DECL:
+	{
+		Value value;
+		value.kind = VALUE_NIL;
+		if (stmt->data.decl.is_array)
+		{
+			const AstExpr *init = stmt->data.decl.array_init;
+			if (init && init->kind != EXPR_ARRAY_LITERAL)
+			{
+				return EXEC_FAIL;
+			}
+			ValueArray *array = xcalloc(1, sizeof(ValueArray));
+			size_t count = stmt->data.decl.array_size;
+			if (init && init->data.array_literal.elements.count > count)
+			{
+				count = init->data.array_literal.elements.count;
+			}
+			array->items = xcalloc(count ? count : 1, sizeof(Value));
+			array->count = count;
+			value.kind = VALUE_ARRAY;
+			value.as.array = array;
+			bind(env, stmt->data.decl.name, value);
+			for (size_t i = 0; i < count; ++i)
+			{
+				Value element;
+				if (init && i < init->data.array_literal.elements.count)
+				{
+					if (!eval_expected(ev, init->data.array_literal.elements.items[i], env, stmt->data.decl.type, &element))
+					{
+						return EXEC_FAIL;
+					}
+				}
+				else if (stmt->data.decl.type == TYPE_INT)
+				{
+					element.kind = VALUE_INT;
+					element.as.int_value = 0;
+				}
+				else if (stmt->data.decl.type == TYPE_FLOAT)
+				{
+					element.kind = VALUE_FLOAT;
+					element.as.float_value = 0.0;
+				}
+				else if (stmt->data.decl.type == TYPE_BOOL)
+				{
+					element.kind = VALUE_BOOL;
+					element.as.bool_value = 0;
+				}
+				else
+				{
+					return EXEC_FAIL;
+				}
+				array->items[i] = element;
+			}
+			return EXEC_NORMAL;
+		}
+		if (stmt->data.decl.init && !eval_expected(ev, stmt->data.decl.init, env, stmt->data.decl.type, &value))
+		{
+			return EXEC_FAIL;
+		}
+		bind(env, stmt->data.decl.name, value);
+		return EXEC_NORMAL;
+	}
+	case STMT_ASSIGN:
+	{
+		Value value;
+		Binding *binding = lookup(env, stmt->data.assign.name);
+		if (!binding || binding->value.kind == VALUE_ARRAY ||
+			!eval_expected(ev, stmt->data.assign.value, env, stmt->data.assign.type, &value))
+		{
+			return EXEC_FAIL;
+		}
+		binding = lookup(env, stmt->data.assign.name);
+		binding->value = value;
+		return EXEC_NORMAL;
+	}
+	case STMT_ARRAY_ASSIGN:
+	{
+		Binding *binding = lookup(env, stmt->data.array_assign.name);
+		size_t index;
+		Value value;
+		if (!binding || binding->value.kind != VALUE_ARRAY)
+		{
+			return EXEC_FAIL;
+		}
+		ValueArray *array = binding->value.as.array;
+		if (!eval_index(ev, stmt->data.array_assign.index, env, array, &index) ||
+			!eval_expected(ev, stmt->data.array_assign.value, env, stmt->data.array_assign.element_type, &value))
+		{
+			return EXEC_FAIL;
+		}
+		array->items[index] = value;
+		return EXEC_NORMAL;
+	}
+	case STMT_WHILE:
+		for (;;)
+		{
+			int condition;
+			if (!eval_condition(ev, stmt->data.while_stmt.condition, env, &condition))
+			{
+				return EXEC_FAIL;
+			}
+			if (!condition)
+			{
+				return EXEC_NORMAL;
+			}
+			ExecStatus status = exec_statement(ev, stmt->data.while_stmt.body, env, return_type);
+			if (status != EXEC_NORMAL)
+			{
+				return status;
+			}
+		}
+	case STMT_FOR:
+	{
+		size_t mark = env->count;
+		ExecStatus status = exec_statement(ev, stmt->data.for_stmt.init, env, return_type);
+		while (status == EXEC_NORMAL)
+		{
+			int condition = 1;
+			if (stmt->data.for_stmt.condition && !eval_condition(ev, stmt->data.for_stmt.condition, env, &condition))
+			{
+				status = EXEC_FAIL;
+				break;
+			}
+			if (!condition)
+			{
+				break;
+			}
+			status = exec_statement(ev, stmt->data.for_stmt.body, env, return_type);
+			if (status == EXEC_NORMAL)
+			{
+				status = exec_statement(ev, stmt->data.for_stmt.post, env, return_type);
+			}
+		}
+		unwind(env, mark);
+		return status;
+	}
+	case STMT_EXPR:
+	{
+		Value ignored;
+		return stmt->data.expr && !eval_expression(ev, stmt->data.expr, env, &ignored) ? EXEC_FAIL : EXEC_NORMAL;
+	}
+	case STMT_RETURN:
+		if (!stmt->data.expr || !eval_expected(ev, stmt->data.expr, env, return_type, &ev->result))
+		{
+			return EXEC_FAIL;
+		}
+		return EXEC_RETURN;
+	}
+	return EXEC_FAIL;
+}
+
+static int eval_expected(Evaluator *ev, const AstExpr *expr, const Environment *env, TypeKind expected, Value *out)
+{
+	Value value;
+	return eval_expression(ev, expr, env, &value) && convert(value, expr->type, expected, out);
+}
+
+static int eval_condition(Evaluator *ev, const AstExpr *expr, const Environment *env, int *out)
+{
+	Value value;
+	return eval_expression(ev, expr, env, &value) && truthy(value, expr->type, out);
+}
+
+static int eval_expression(Evaluator *ev, const AstExpr *expr, const Environment *env, Value *out)
+{
+	if (!expr || !tick(ev))
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+		*out = literal_value(expr);
+		return out->kind != VALUE_NIL;
+	case EXPR_IDENTIFIER:
+	{
+		Binding *binding = lookup(env, expr->data.identifier);
+		if (!binding || binding->value.kind == VALUE_NIL || binding->value.kind == VALUE_ARRAY)
+		{
+			return 0;
+		}
+		*out = binding->value;
+		return 1;
+	}
+	case EXPR_BINARY:
+		return eval_binary(ev, expr, env, out);
+	case EXPR_UNARY:
+	{
+		Value operand;
+		if (expr->data.unary.op == UN_OP_NOT)
+		{
+			int condition;
+			if (!eval_condition(ev, expr->data.unary.operand, env, &condition))
+			{
+				return 0;
+			}
+			out->kind = VALUE_BOOL;
+			out->as.bool_value = !condition;
+			return 1;
+		}
+		if (!eval_expression(ev, expr->data.unary.operand, env, &operand))
+		{
+			return 0;
+		}
+		if (expr->data.unary.op == UN_OP_POS)
+		{
+			*out = operand;
+			return 1;
+		}
+		if (operand.kind == VALUE_INT)
+		{
+			out->kind = VALUE_INT;
+			out->as.int_value = (long long)(0ULL - (unsigned long long)operand.as.int_value);
+			if (ev->c32 && expr->type == TYPE_INT)
+			{
+				out->as.int_value = wrap_int32(out->as.int_value);
+			}
+			return 1;
+		}
+		if (operand.kind == VALUE_FLOAT)
+		{
+			out->kind = VALUE_FLOAT;
+			out->as.float_value = -operand.as.float_value;
+			return 1;
+		}
+		return 0;
+	}
+	case EXPR_CALL:
+		return call_function(ev, expr, env, out);
+	case EXPR_SUBSCRIPT:
+	{
+		const AstExpr *base = expr->data.subscript.array;
+		Binding *binding = base && base->kind == EXPR_IDENTIFIER ? lookup(env, base->data.identifier) : NULL;
+		size_t index;
+		if (!binding || binding->value.kind != VALUE_ARRAY ||
+			!eval_index(ev, expr->data.subscript.index, env, binding->value.as.array, &index))
+		{
+			return 0;
+		}
+		binding = lookup(env, base->data.identifier);
+		*out = binding->value.as.array->items[index];
+		return 1;
+	}
+	default:
+		return 0;
+	}
+}
+
+static int eval_binary(Evaluator *ev, const AstExpr *expr, const Environment *env, Value *out)
+{
+	AstBinaryOp op = expr->data.binary.op;
+	if (op == BIN_OP_AND || op == BIN_OP_OR)
+	{
+		int left;
+		int right;
+		if (!eval_condition(ev, expr->data.binary.left, env, &left))
+		{
+			return 0;
+		}
+		out->kind = VALUE_BOOL;
+		if ((op == BIN_OP_AND && !left) || (op == BIN_OP_OR && left))
+		{
+			out->as.bool_value = left;
+			return 1;
+		}
+		if (!eval_condition(ev, expr->data.binary.right, env, &right))
+		{
+			return 0;
+		}
+		out->as.bool_value = right;
+		return 1;
+	}
+
+	Value left;
+	Value right;
+	if (!eval_expression(ev, expr->data.binary.left, env, &left) || !eval_expression(ev, expr->data.binary.right, env, &right))
+	{
+		return 0;
+	}
+	if (op >= BIN_OP_EQ && op <= BIN_OP_GE)
+	{
+		return compare(op, left, right, out);
+	}
+	return arithmetic(op, left, right, ev->c32 && expr->type == TYPE_INT, out);
+}
+
+/* Mirrors the +1 codegen adds to every index; Lua normalises integral float
+ * keys, anything else would read nil at runtime. */
+static int eval_index(Evaluator *ev, const AstExpr *index, const Environment *env, const ValueArray *array, size_t *out)
+{
+	Value value;
+	long long position;
+	if (!eval_expression(ev, index, env, &value))
+	{
+		return 0;
+	}
+	if (value.kind == VALUE_INT)
+	{
+		position = value.as.int_value;
+	}
+	else if (value.kind == VALUE_FLOAT && value.as.float_value == floor(value.as.float_value) &&
+			 fabs(value.as.float_value) < 9007199254740992.0)
+	{
+		position = (long long)value.as.float_value;
+	}
+	else
+	{
+		return 0;
+	}
+	if (position < 0 || (unsigned long long)position >= array->count)
+	{
+		return 0;
+	}
+	*out = (size_t)position;
+	return 1;
+}
+
+static int arithmetic(AstBinaryOp op, Value left, Value right, int c_int, Value *out)
+{
+	if ((left.kind != VALUE_INT && left.kind != VALUE_FLOAT) || (right.kind != VALUE_INT && right.kind != VALUE_FLOAT))
+	{
+		return 0;
+	}
+	if (c_int)
+	{
+		if (left.kind != VALUE_INT || right.kind != VALUE_INT)
+		{
+			return 0;
+		}
+		long long x = left.as.int_value;
+		long long y = right.as.int_value;
+		unsigned long long a = (unsigned long long)x;
+		unsigned long long b = (unsigned long long)y;
+		out->kind = VALUE_INT;
+		switch (op)
+		{
+		case BIN_OP_ADD:
+			out->as.int_value = wrap_int32((long long)(a + b));
+			return 1;
+		case BIN_OP_SUB:
+			out->as.int_value = wrap_int32((long long)(a - b));
+			return 1;
+		case BIN_OP_MUL:
+			out->as.int_value = wrap_int32((long long)(a * b));
+			return 1;
+		case BIN_OP_DIV:
+			if (y == 0)
+			{
+				return 0;
+			}
+			out->as.int_value = wrap_int32(y == -1 ? (long long)(0ULL - a) : x / y);
+			return 1;
+		case BIN_OP_MOD:
+			if (y == 0)
+			{
+				return 0;
+			}
+			out->as.int_value = y == -1 ? 0 : x % y;
+			return 1;
+		default:
+			return 0;
+		}
+	}
+	if (left.kind == VALUE_INT && right.kind == VALUE_INT && op != BIN_OP_DIV)
+	{
+		unsigned long long a = (unsigned long long)left.as.int_value;
+		unsigned long long b = (unsigned long long)right.as.int_value;
+		out->kind = VALUE_INT;
+		switch (op)
+		{
+		case BIN_OP_ADD:
+			out->as.int_value = (long long)(a + b);
+			return 1;
+		case BIN_OP_SUB:
+			out->as.int_value = (long long)(a - b);
+			return 1;
+		case BIN_OP_MUL:
+			out->as.int_value = (long long)(a * b);
+			return 1;
+		case BIN_OP_MOD:
+		{
+			long long x = left.as.int_value;
+			long long y = right.as.int_value;
+			if (y == 0)
+			{
+				return 0;
+			}
+			if (y == -1)
+			{
+				out->as.int_value = 0;
+				return 1;
+			}
+			long long r = x % y;
+			if (r != 0 && ((r ^ y) < 0))
+			{
+				r += y;
+			}
+			out->as.int_value = r;
+			return 1;
+		}
+		default:
+			return 0;
+		}
+	}
+
+	double a;
+	double b;
+	as_double(left, &a);
+	as_double(right, &b);
+	out->kind = VALUE_FLOAT;
+	switch (op)
+	{
+	case BIN_OP_ADD:
+		out->as.float_value = a + b;
+		return 1;
+	case BIN_OP_SUB:
+		out->as.float_value = a - b;
+		return 1;
+	case BIN_OP_MUL:
+		out->as.float_value = a * b;
+		return 1;
+	case BIN_OP_DIV:
+		out->as.float_value = a / b;
+		return 1;
+	case BIN_OP_MOD:
+	{
+		double m = fmod(a, b);
+		if ((m > 0) ? b < 0 : (m < 0 && b != m))
+		{
+			m += b;
+		}
+		out->as.float_value = m;
+		return 1;
+	}
+	default:
+		return 0;
+	}
+}
+
+static int compare(AstBinaryOp op, Value left, Value right, Value *out)
+{
+	int result;
+	out->kind = VALUE_BOOL;
+	if (left.kind == VALUE_BOOL || right.kind == VALUE_BOOL)
+	{
+		if (op != BIN_OP_EQ && op != BIN_OP_NEQ)
+		{
+			return 0;
+		}
+		result = left.kind == right.kind && left.as.bool_value == right.as.bool_value;
+		out->as.bool_value = op == BIN_OP_EQ ? result : !result;
+		return 1;
+	}
+	if (left.kind == VALUE_INT && right.kind == VALUE_INT)
+	{
+		long long a = left.as.int_value;
+		long long b = right.as.int_value;
+		result = op == BIN_OP_EQ ? a == b : op == BIN_OP_NEQ ? a != b : op == BIN_OP_LT ? a < b
+												: op == BIN_OP_LE ? a <= b : op == BIN_OP_GT ? a > b : a >= b;
+		out->as.bool_value = result;
+		return 1;
+	}
+	double a;
+	double b;
+	if (!as_double(left, &a) || !as_double(right, &b))
+	{
+		return 0;
+	}
+	result = op == BIN_OP_EQ ? a == b : op == BIN_OP_NEQ ? a != b : op == BIN_OP_LT ? a < b
+											: op == BIN_OP_LE ? a <= b : op == BIN_OP_GT ? a > b : a >= b;
+	out->as.bool_value = result;
+	return 1;
+}
+
+/* Same decisions as emit_expression_expected in codegen_lua.c. */
+static int convert(Value value, TypeKind actual, TypeKind expected, Value *out)
+{
+	if (expected == TYPE_UNKNOWN || actual == TYPE_UNKNOWN || expected == actual)
+	{
+		*out = value;
+		return 1;
+	}
+	if (expected == TYPE_BOOL)
+	{
+		int condition;
+		if (!truthy(value, actual, &condition))
+		{
+			return 0;
+		}
+		out->kind = VALUE_BOOL;
+		out->as.bool_value = condition;
+		return 1;
+	}
+	if (expected == TYPE_INT && actual == TYPE_FLOAT)
+	{
+		if (value.kind == VALUE_INT)
+		{
+			*out = value;
+			return 1;
+		}
+		if (value.kind != VALUE_FLOAT)
+		{
+			return 0;
+		}
+		double floored = floor(value.as.float_value);
+		if (!(floored >= -9223372036854775808.0 && floored < 9223372036854775808.0))
+		{
+			return 0;
+		}
+		out->kind = VALUE_INT;
+		out->as.int_value = (long long)floored;
+		return 1;
+	}
+	if ((expected == TYPE_INT || expected == TYPE_FLOAT) && actual == TYPE_BOOL)
+	{
+		int condition;
+		if (!truthy(value, actual, &condition))
+		{
+			return 0;
+		}
+		out->kind = VALUE_INT;
+		out->as.int_value = condition ? 1 : 0;
+		return 1;
+	}
+	*out = value;
+	return 1;
+}
+
+/* Same decisions as emit_expression_as_bool in codegen_lua.c. */
+static int truthy(Value value, TypeKind type, int *out)
+{
+	if (type == TYPE_INT || type == TYPE_FLOAT)
+	{
+		double number;
+		if (value.kind == VALUE_INT)
+		{
+			*out = value.as.int_value != 0;
+			return 1;
+		}
+		if (!as_double(value, &number))
+		{
+			return 0;
+		}
+		*out = number != 0.0;
+		return 1;
+	}
+	switch (value.kind)
+	{
+	case VALUE_BOOL:
+		*out = value.as.bool_value;
+		return 1;
+	case VALUE_NIL:
+		*out = 0;
+		return 1;
+	default:
+		*out = 1;
+		return 1;
+	}
+}
+
+static int as_double(Value value, double *out)
+{
+	if (value.kind == VALUE_FLOAT)
+	{
+		*out = value.as.float_value;
+		return 1;
+	}
+	if (value.kind == VALUE_INT && value.as.int_value > -9007199254740992LL && value.as.int_value < 9007199254740992LL)
+	{
+		*out = (double)value.as.int_value;
+		return 1;
+	}
+	return 0;
+}
+
+/* Float literals are printed with %g, so Lua sees that spelling rather than
+ * the source value; "2.0" arrives as the integer 2. */
+static Value literal_value(const AstExpr *expr)
+{
+	Value value;
+	value.kind = VALUE_NIL;
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+		value.kind = VALUE_INT;
+		value.as.int_value = expr->data.int_value;
+		break;
+	case EXPR_BOOL_LITERAL:
+		value.kind = VALUE_BOOL;
+		value.as.bool_value = expr->data.bool_value ? 1 : 0;
+		break;
+	case EXPR_FLOAT_LITERAL:
+	{
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "%g", expr->data.float_value);
+		if (strpbrk(buffer, ".eni"))
+		{
+			value.kind = VALUE_FLOAT;
+			value.as.float_value = strtod(buffer, NULL);
+		}
+		else
+		{
+			value.kind = VALUE_INT;
+			value.as.int_value = strtoll(buffer, NULL, 10);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return value;
+}
+
+static AstExpr *value_to_literal(Value value)
+{
+	switch (value.kind)
+	{
+	case VALUE_INT:
+		return ast_expr_make_int(value.as.int_value);
+	case VALUE_BOOL:
+		return ast_expr_make_bool(value.as.bool_value);
+	case VALUE_FLOAT:
+	{
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "%g", value.as.float_value);
+		if (!strpbrk(buffer, ".e") || strpbrk(buffer, "ni") || strtod(buffer, NULL) != value.as.float_value)
+		{
+			return NULL;
+		}
+		return ast_expr_make_float(value.as.float_value);
+	}
+	default:
+		return NULL;
+	}
+}
+
+static const AstFunction *find_function(const AstProgram *program, const char *name)
+{
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		if (strcmp(program->functions.items[i]->name, name) == 0)
+		{
+			return program->functions.items[i];
+		}
+	}
+	return NULL;
+}
+
+static void bind(Environment *env, const char *name, Value value)
+{
+	ensure_capacity((void **)&env->items, sizeof(Binding), &env->capacity, env->count + 1);
+	env->items[env->count].name = name;
+	env->items[env->count].value = value;
+	env->count++;
+}
+
+static Binding *lookup(const Environment *env, const char *name)
+{
+	for (size_t i = env->count; i > 0; --i)
+	{
+		if (strcmp(env->items[i - 1].name, name) == 0)
+		{
+			return &env->items[i - 1];
+		}
+	}
+	return NULL;
+}
+
+static void unwind(Environment *env, size_t count)
+{
+	while (env->count > count)
+	{
+		Binding *binding = &env->items[--env->count];
+		if (binding->value.kind == VALUE_ARRAY)
+		{
+			free(binding->value.as.array->items);
+			free(binding->value.as.array);
+		}
+	}
+}
+
+static long long wrap_int32(long long value)
+{
+	unsigned long long bits = (unsigned long long)value & 0xFFFFFFFFULL;
+	return bits >= 0x80000000ULL ? (long long)bits - 0x100000000LL : (long long)bits;
+}
+
+static int tick(Evaluator *ev)
+{
+	return ++ev->steps <= ev->step_limit;
+}
+
+static void *xcalloc(size_t n, size_t size)
+{
+	void *ptr = calloc(n, size);
+	if (!ptr)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	return ptr;
+}
+
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed)
+{
+	if (*capacity >= needed)
+	{
+		return;
+	}
+	size_t new_capacity = (*capacity == 0) ? 4 : (*capacity * 2);
+	while (new_capacity < needed)
+	{
+		new_capacity *= 2;
+	}
+	void *new_buffer = realloc(*buffer, new_capacity * elem_size);
+	if (!new_buffer)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	*buffer = new_buffer;
+	*capacity = new_capacity;
+}
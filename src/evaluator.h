@@ -0,0 +1,10 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "ast.h"
+#include "options.h"
+#include "symbol_table.h"
+
+AstExpr *evaluator_call(const AstProgram *program, const FunctionTable *functions, const AstExpr *call, const CompilerOptions *options);
+
+#endif
@@ -0,0 +1,249 @@
+#include "layout.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Locals of the main chunk, out of Lua's 200, that functions may occupy; the
+ * rest is left to the runtime helpers. */
+#define CHUNK_LOCAL_LIMIT 180
+#define MEMOIZED_LOCALS 3
+#define LOOP_WEIGHT 16
+#define MAX_LOOP_DEPTH 4
+
+typedef struct
+{
+	const AstProgram *program;
+	size_t caller;
+	double *heat;
+	int *forward;
+} CallScan;
+
+static void scan_statement(CallScan *scan, const AstStmt *stmt, size_t loop_depth);
+static void scan_expression(CallScan *scan, const AstExpr *expr, size_t loop_depth);
+static size_t function_index(const AstProgram *program, const char *name);
+static size_t locals_needed(const FunctionSignature *signature, const CompilerOptions *options);
+static FunctionSignature *find_signature(FunctionTable *functions, const char *name);
+
+/* Chooses how each function is bound in the main chunk. Functions called
+ * before their definition are declared up front; when there are more than the
+ * chunk's locals can hold, the ones called least often, weighted by loop
+ * nesting or counted by a profile, move into a shared table and the rest stay
+ * upvalues. */
+void layout_functions(const AstProgram *program, FunctionTable *functions, const CompilerOptions *options, const Profile *profile)
+{
+	if (!program || !functions || !options)
+	{
+		return;
+	}
+	size_t count = program->functions.count;
+	if (count == 0)
+	{
+		return;
+	}
+
+	CallScan scan = {0};
+	scan.program = program;
+	scan.heat = calloc(count, sizeof(double));
+	scan.forward = calloc(count, sizeof(int));
+	size_t *order = malloc(count * sizeof(size_t));
+	if (!scan.heat || !scan.forward || !order)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		scan.caller = i;
+		const AstFunction *fn = program->functions.items[i];
+		for (size_t j = 0; j < fn->body.statements.count; ++j)
+		{
+			scan_statement(&scan, fn->body.statements.items[j], 0);
+		}
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		long long calls = profile_calls(profile, program->functions.items[i]->name);
+		if (calls >= 0)
+		{
+			scan.heat[i] = (double)calls;
+		}
+	}
+
+	size_t budget = CHUNK_LOCAL_LIMIT - 1 - program->constants.count;
+	size_t needed = 0;
+	size_t candidates = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const FunctionSignature *signature = find_signature(functions, program->functions.items[i]->name);
+		if (signature && strcmp(signature->name, "main") != 0)
+		{
+			needed += locals_needed(signature, options);
+			order[candidates++] = i;
+		}
+	}
+
+	/* Stable selection by heat; programs that fit skip it entirely. */
+	if (needed > budget)
+	{
+		for (size_t i = 1; i < candidates; ++i)
+		{
+			size_t current = order[i];
+			size_t j = i;
+			while (j > 0 && scan.heat[order[j - 1]] < scan.heat[current])
+			{
+				order[j] = order[j - 1];
+				--j;
+			}
+			order[j] = current;
+		}
+	}
+
+	size_t used = 0;
+	for (size_t i = 0; i < candidates; ++i)
+	{
+		size_t index = order[i];
+		FunctionSignature *signature = find_signature(functions, program->functions.items[index]->name);
+		size_t cost = locals_needed(signature, options);
+		if (needed <= budget || used + cost <= budget)
+		{
+			used += cost;
+			signature->storage = scan.forward[index] ? FUNCTION_FORWARD : FUNCTION_LOCAL;
+		}
+		else
+		{
+			signature->storage = FUNCTION_TABLE;
+		}
+	}
+
+	free(order);
+	free(scan.heat);
+	free(scan.forward);
+}
+
+static void scan_statement(CallScan *scan, const AstStmt *stmt, size_t loop_depth)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			scan_statement(scan, stmt->data.block.statements.items[i], loop_depth);
+		}
+		break;
+	case STMT_DECL:
+		scan_expression(scan, stmt->data.decl.init, loop_depth);
+		scan_expression(scan, stmt->data.decl.array_init, loop_depth);
+		break;
+	case STMT_ASSIGN:
+		scan_expression(scan, stmt->data.assign.value, loop_depth);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		scan_expression(scan, stmt->data.array_assign.index, loop_depth);
+		scan_expression(scan, stmt->data.array_assign.value, loop_depth);
+		break;
+	case STMT_WHILE:
+		scan_expression(scan, stmt->data.while_stmt.condition, loop_depth + 1);
+		scan_statement(scan, stmt->data.while_stmt.body, loop_depth + 1);
+		break;
+	case STMT_FOR:
+		scan_statement(scan, stmt->data.for_stmt.init, loop_depth);
+		scan_expression(scan, stmt->data.for_stmt.condition, loop_depth + 1);
+		scan_statement(scan, stmt->data.for_stmt.post, loop_depth + 1);
+		scan_statement(scan, stmt->data.for_stmt.body, loop_depth + 1);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		scan_expression(scan, stmt->data.expr, loop_depth);
+		break;
+	}
+}
+
+static void scan_expression(CallScan *scan, const AstExpr *expr, size_t loop_depth)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		scan_expression(scan, expr->data.binary.left, loop_depth);
+		scan_expression(scan, expr->data.binary.right, loop_depth);
+		break;
+	case EXPR_UNARY:
+		scan_expression(scan, expr->data.unary.operand, loop_depth);
+		break;
+	case EXPR_CALL:
+	{
+		size_t callee = function_index(scan->program, expr->data.call.callee);
+		if (callee < scan->program->functions.count)
+		{
+			double weight = 1.0;
+			for (size_t i = 0; i < loop_depth && i < MAX_LOOP_DEPTH; ++i)
+			{
+				weight *= LOOP_WEIGHT;
+			}
+			scan->heat[callee] += weight;
+			if (callee > scan->caller)
+			{
+				scan->forward[callee] = 1;
+			}
+		}
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			scan_expression(scan, expr->data.call.args.items[i], loop_depth);
+		}
+		break;
+	}
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			scan_expression(scan, expr->data.array_literal.elements.items[i], loop_depth);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		scan_expression(scan, expr->data.subscript.array, loop_depth);
+		scan_expression(scan, expr->data.subscript.index, loop_depth);
+		break;
+	default:
+		break;
+	}
+}
+
+static size_t function_index(const AstProgram *program, const char *name)
+{
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		if (strcmp(program->functions.items[i]->name, name) == 0)
+		{
+			return i;
+		}
+	}
+	return program->functions.count;
+}
+
+/* A memoized function also keeps its cache and its uncached body in locals;
+ * purity is enough to reserve room for that. */
+static size_t locals_needed(const FunctionSignature *signature, const CompilerOptions *options)
+{
+	return options->memoize == MEMOIZE_AUTO && signature->is_pure ? MEMOIZED_LOCALS : 1;
+}
+
+static FunctionSignature *find_signature(FunctionTable *functions, const char *name)
+{
+	for (size_t i = 0; i < functions->count; ++i)
+	{
+		if (strcmp(functions->items[i].name, name) == 0)
+		{
+			return &functions->items[i];
+		}
+	}
+	return NULL;
+}
@@ -0,0 +1,11 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include "ast.h"
+#include "options.h"
+#include "profile.h"
+#include "symbol_table.h"
+
+void layout_functions(const AstProgram *program, FunctionTable *functions, const CompilerOptions *options, const Profile *profile);
+
+#endif
@@ -0,0 +1,567 @@
+#include "locals.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Lua allows 200 active locals per function; the rest of the headroom covers
+ * the hidden state of numeric for loops and the locals codegen adds itself. */
+#define MAX_ACTIVE_LOCALS 180
+#define FOR_LOOP_LOCALS 4
+#define FRAME_NAME "__frame"
+
+static void allocate_function(AstFunction *fn);
+static void mark_const_in_list(AstStmtList *list);
+static void mark_const_in_statement(AstStmt *stmt);
+static size_t peak_in_list(const AstStmtList *list, size_t active);
+static size_t peak_in_statement(const AstStmt *stmt, size_t active);
+static void reuse_in_list(AstStmtList *list);
+static void reuse_in_statement(AstStmt *stmt);
+static int find_dead_slot(const AstStmtList *list, size_t position);
+static size_t last_use(const AstStmtList *list, size_t start, const char *name);
+static int declares_in_list(const AstStmtList *list, size_t start, const char *name);
+static int declares_in_statement(const AstStmt *stmt, const char *name);
+static int statement_mentions(const AstStmt *stmt, const char *name);
+static int spill_in_list(AstStmtList *list, size_t active, size_t *slots);
+static int spill_in_statement(AstStmt *stmt, size_t active, size_t *slots);
+static void rename_in_list(AstStmtList *list, size_t start, const char *from, const char *to);
+static int rename_in_statement(AstStmt *stmt, const char *from, const char *to);
+static void rename_in_expression(AstExpr *expr, const char *from, const char *to);
+static AstExpr *default_value(TypeKind type);
+static char *frame_slot(const char *name, size_t number);
+static char *dup_string(const char *src);
+
+/* Keeps every function under Lua's local variable limit. Only functions that
+ * would exceed it are touched: first, a local declared after the last use of
+ * an earlier local in the same block takes over that local's slot; whatever
+ * still does not fit lives in a per-function table. */
+void locals_allocate(AstProgram *program, const CompilerOptions *options)
+{
+	if (!program || !options)
+	{
+		return;
+	}
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		allocate_function(program->functions.items[i]);
+		if (options->lua_version == LUA_VERSION_54)
+		{
+			mark_const_in_list(&program->functions.items[i]->body.statements);
+		}
+	}
+	if (options->lua_version == LUA_VERSION_54)
+	{
+		mark_const_in_list(&program->constants);
+	}
+}
+
+static void allocate_function(AstFunction *fn)
+{
+	if (!fn || peak_in_list(&fn->body.statements, fn->params.count) <= MAX_ACTIVE_LOCALS)
+	{
+		return;
+	}
+	reuse_in_list(&fn->body.statements);
+	if (peak_in_list(&fn->body.statements, fn->params.count) <= MAX_ACTIVE_LOCALS)
+	{
+		return;
+	}
+	size_t slots = 0;
+	if (!spill_in_list(&fn->body.statements, fn->params.count + 1, &slots))
+	{
+		return;
+	}
+
+	AstStmtList rebuilt = ast_stmt_list_make();
+	ast_stmt_list_push(&rebuilt, ast_stmt_make_array_decl(TYPE_INT, dup_string(FRAME_NAME), 0, NULL));
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		ast_stmt_list_push(&rebuilt, fn->body.statements.items[i]);
+	}
+	free(fn->body.statements.items);
+	fn->body.statements = rebuilt;
+}
+
+/* A declaration nothing later in its block assigns (or redeclares, to keep
+ * the check simple) can be a Lua 5.4 <const>; for an array that also means
+ * its elements are never written. */
+static void mark_const_in_list(AstStmtList *list)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		if (stmt->kind != STMT_DECL)
+		{
+			mark_const_in_statement(stmt);
+			continue;
+		}
+		if (stmt->data.decl.spilled || (!stmt->data.decl.is_array && !stmt->data.decl.init))
+		{
+			continue;
+		}
+		int assigned = 0;
+		for (size_t j = i + 1; j < list->count && !assigned; ++j)
+		{
+			assigned = ast_stmt_assigns(list->items[j], stmt->data.decl.name);
+		}
+		stmt->data.decl.is_const = !assigned;
+	}
+}
+
+static void mark_const_in_statement(AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		mark_const_in_list(&stmt->data.block.statements);
+		break;
+	case STMT_WHILE:
+		mark_const_in_statement(stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+		mark_const_in_statement(stmt->data.for_stmt.body);
+		break;
+	default:
+		break;
+	}
+}
+
+static size_t peak_in_list(const AstStmtList *list, size_t active)
+{
+	size_t peak = active;
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		const AstStmt *stmt = list->items[i];
+		if (stmt->kind == STMT_DECL)
+		{
+			if (!stmt->data.decl.spilled)
+			{
+				++active;
+			}
+			if (active > peak)
+			{
+				peak = active;
+			}
+			continue;
+		}
+		size_t nested = peak_in_statement(stmt, active);
+		if (nested > peak)
+		{
+			peak = nested;
+		}
+	}
+	return peak;
+}
+
+static size_t peak_in_statement(const AstStmt *stmt, size_t active)
+{
+	if (!stmt)
+	{
+		return active;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		return peak_in_list(&stmt->data.block.statements, active);
+	case STMT_DECL:
+		return active + 1;
+	case STMT_WHILE:
+		return peak_in_statement(stmt->data.while_stmt.body, active);
+	case STMT_FOR:
+		if (stmt->data.for_stmt.init && stmt->data.for_stmt.init->kind == STMT_DECL)
+		{
+			active += FOR_LOOP_LOCALS;
+		}
+		return peak_in_statement(stmt->data.for_stmt.body, active);
+	default:
+		return active;
+	}
+}
+
+static void reuse_in_list(AstStmtList *list)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		reuse_in_statement(list->items[i]);
+	}
+
+	for (size_t j = 0; j < list->count; ++j)
+	{
+		AstStmt *decl = list->items[j];
+		if (decl->kind != STMT_DECL || decl->data.decl.is_array)
+		{
+			continue;
+		}
+		int slot = find_dead_slot(list, j);
+		if (slot < 0)
+		{
+			continue;
+		}
+		const char *target = list->items[slot]->data.decl.name;
+		rename_in_list(list, j + 1, decl->data.decl.name, target);
+
+		AstExpr *value = decl->data.decl.init ? decl->data.decl.init : default_value(decl->data.decl.type);
+		AstStmt *assign = ast_stmt_make_assign(dup_string(target), value);
+		assign->data.assign.type = decl->data.decl.type;
+		decl->data.decl.init = NULL;
+		ast_stmt_destroy(decl);
+		list->items[j] = assign;
+	}
+}
+
+static void reuse_in_statement(AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		reuse_in_list(&stmt->data.block.statements);
+		break;
+	case STMT_WHILE:
+		reuse_in_statement(stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+		reuse_in_statement(stmt->data.for_stmt.body);
+		break;
+	default:
+		break;
+	}
+}
+
+/* A scalar declared earlier in the same block whose last use comes before
+ * position, and which nothing after position could confuse with a newer
+ * declaration of the same name. */
+static int find_dead_slot(const AstStmtList *list, size_t position)
+{
+	for (size_t i = 0; i < position; ++i)
+	{
+		const AstStmt *candidate = list->items[i];
+		if (candidate->kind != STMT_DECL || candidate->data.decl.is_array)
+		{
+			continue;
+		}
+		const char *name = candidate->data.decl.name;
+		if (last_use(list, i + 1, name) >= position || declares_in_list(list, position, name))
+		{
+			continue;
+		}
+		return (int)i;
+	}
+	return -1;
+}
+
+/* Index of the last statement from start on that mentions name, or start - 1. */
+static size_t last_use(const AstStmtList *list, size_t start, const char *name)
+{
+	size_t last = start - 1;
+	for (size_t i = start; i < list->count; ++i)
+	{
+		if (statement_mentions(list->items[i], name))
+		{
+			last = i;
+		}
+	}
+	return last;
+}
+
+static int declares_in_list(const AstStmtList *list, size_t start, const char *name)
+{
+	for (size_t i = start; i < list->count; ++i)
+	{
+		if (declares_in_statement(list->items[i], name))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int declares_in_statement(const AstStmt *stmt, const char *name)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		return declares_in_list(&stmt->data.block.statements, 0, name);
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) == 0;
+	case STMT_WHILE:
+		return declares_in_statement(stmt->data.while_stmt.body, name);
+	case STMT_FOR:
+		return declares_in_statement(stmt->data.for_stmt.init, name) ||
+			   declares_in_statement(stmt->data.for_stmt.body, name);
+	default:
+		return 0;
+	}
+}
+
+static int statement_mentions(const AstStmt *stmt, const char *name)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (statement_mentions(stmt->data.block.statements.items[i], name))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) == 0 || ast_expr_references(stmt->data.decl.init, name) ||
+			   ast_expr_references(stmt->data.decl.array_init, name);
+	case STMT_ASSIGN:
+		return strcmp(stmt->data.assign.name, name) == 0 || ast_expr_references(stmt->data.assign.value, name);
+	case STMT_ARRAY_ASSIGN:
+		return strcmp(stmt->data.array_assign.name, name) == 0 ||
+			   ast_expr_references(stmt->data.array_assign.index, name) ||
+			   ast_expr_references(stmt->data.array_assign.value, name);
+	case STMT_WHILE:
+		return ast_expr_references(stmt->data.while_stmt.condition, name) ||
+			   statement_mentions(stmt->data.while_stmt.body, name);
+	case STMT_FOR:
+		return statement_mentions(stmt->data.for_stmt.init, name) ||
+			   ast_expr_references(stmt->data.for_stmt.condition, name) ||
+			   statement_mentions(stmt->data.for_stmt.post, name) ||
+			   statement_mentions(stmt->data.for_stmt.body, name);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return ast_expr_references(stmt->data.expr, name);
+	}
+	return 0;
+}
+
+/* Moves every declaration that would push the active count past the limit
+ * into the frame table. Each gets its own numbered slot, so a spilled local
+ * and a spilled shadowing local never share a field. Returns whether
+ * anything was spilled. */
+static int spill_in_list(AstStmtList *list, size_t active, size_t *slots)
+{
+	int spilled = 0;
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		if (stmt->kind != STMT_DECL)
+		{
+			spilled |= spill_in_statement(stmt, active, slots);
+			continue;
+		}
+		if (active < MAX_ACTIVE_LOCALS)
+		{
+			++active;
+			continue;
+		}
+		char *slot = frame_slot(stmt->data.decl.name, ++*slots);
+		rename_in_list(list, i + 1, stmt->data.decl.name, slot);
+		free(stmt->data.decl.name);
+		stmt->data.decl.name = slot;
+		stmt->data.decl.spilled = 1;
+		spilled = 1;
+	}
+	return spilled;
+}
+
+static int spill_in_statement(AstStmt *stmt, size_t active, size_t *slots)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		return spill_in_list(&stmt->data.block.statements, active, slots);
+	case STMT_WHILE:
+		return spill_in_statement(stmt->data.while_stmt.body, active, slots);
+	case STMT_FOR:
+		if (stmt->data.for_stmt.init && stmt->data.for_stmt.init->kind == STMT_DECL)
+		{
+			active += FOR_LOOP_LOCALS;
+		}
+		return spill_in_statement(stmt->data.for_stmt.body, active, slots);
+	default:
+		return 0;
+	}
+}
+
+static void rename_in_list(AstStmtList *list, size_t start, const char *from, const char *to)
+{
+	for (size_t i = start; i < list->count; ++i)
+	{
+		if (rename_in_statement(list->items[i], from, to))
+		{
+			return;
+		}
+	}
+}
+
+/* Returns 1 when stmt declares from again, which ends the scope being renamed. */
+static int rename_in_statement(AstStmt *stmt, const char *from, const char *to)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		rename_in_list(&stmt->data.block.statements, 0, from, to);
+		return 0;
+	case STMT_DECL:
+		rename_in_expression(stmt->data.decl.init, from, to);
+		rename_in_expression(stmt->data.decl.array_init, from, to);
+		return strcmp(stmt->data.decl.name, from) == 0;
+	case STMT_ASSIGN:
+		if (strcmp(stmt->data.assign.name, from) == 0)
+		{
+			free(stmt->data.assign.name);
+			stmt->data.assign.name = dup_string(to);
+		}
+		rename_in_expression(stmt->data.assign.value, from, to);
+		return 0;
+	case STMT_ARRAY_ASSIGN:
+		if (strcmp(stmt->data.array_assign.name, from) == 0)
+		{
+			free(stmt->data.array_assign.name);
+			stmt->data.array_assign.name = dup_string(to);
+		}
+		rename_in_expression(stmt->data.array_assign.index, from, to);
+		rename_in_expression(stmt->data.array_assign.value, from, to);
+		return 0;
+	case STMT_WHILE:
+		rename_in_expression(stmt->data.while_stmt.condition, from, to);
+		rename_in_statement(stmt->data.while_stmt.body, from, to);
+		return 0;
+	case STMT_FOR:
+		if (rename_in_statement(stmt->data.for_stmt.init, from, to))
+		{
+			return 0;
+		}
+		rename_in_expression(stmt->data.for_stmt.condition, from, to);
+		rename_in_statement(stmt->data.for_stmt.post, from, to);
+		rename_in_statement(stmt->data.for_stmt.body, from, to);
+		return 0;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		rename_in_expression(stmt->data.expr, from, to);
+		return 0;
+	}
+	return 0;
+}
+
+static void rename_in_expression(AstExpr *expr, const char *from, const char *to)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		if (strcmp(expr->data.identifier, from) == 0)
+		{
+			free(expr->data.identifier);
+			expr->data.identifier = dup_string(to);
+		}
+		break;
+	case EXPR_BINARY:
+		rename_in_expression(expr->data.binary.left, from, to);
+		rename_in_expression(expr->data.binary.right, from, to);
+		break;
+	case EXPR_UNARY:
+		rename_in_expression(expr->data.unary.operand, from, to);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			rename_in_expression(expr->data.call.args.items[i], from, to);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			rename_in_expression(expr->data.array_literal.elements.items[i], from, to);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		rename_in_expression(expr->data.subscript.array, from, to);
+		rename_in_expression(expr->data.subscript.index, from, to);
+		break;
+	default:
+		break;
+	}
+}
+
+static AstExpr *default_value(TypeKind type)
+{
+	AstExpr *value;
+	if (type == TYPE_FLOAT)
+	{
+		value = ast_expr_make_float(0.0);
+		value->type = TYPE_FLOAT;
+	}
+	else if (type == TYPE_BOOL)
+	{
+		value = ast_expr_make_bool(0);
+		value->type = TYPE_BOOL;
+	}
+	else
+	{
+		value = ast_expr_make_int(0);
+		value->type = TYPE_INT;
+	}
+	return value;
+}
+
+static char *frame_slot(const char *name, size_t number)
+{
+	size_t length = strlen(FRAME_NAME) + strlen(name) + 24;
+	char *slot = malloc(length);
+	if (!slot)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	snprintf(slot, length, "%s.%s_%zu", FRAME_NAME, name, number);
+	return slot;
+}
+
+static char *dup_string(const char *src)
+{
+	if (!src)
+	{
+		return NULL;
+	}
+	size_t len = strlen(src);
+	char *copy = malloc(len + 1);
+	if (!copy)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(copy, src, len + 1);
+	return copy;
+}
@@ -0,0 +1,9 @@
+#ifndef LOCALS_H
+#define LOCALS_H
+
+#include "ast.h"
+#include "options.h"
+
+void locals_allocate(AstProgram *program, const CompilerOptions *options);
+
+#endif
@@ -4,15 +4,31 @@
 #include <string.h>
 
 #include "ast.h"
+#include "range.h"
 #include "codegen_lua.h"
+#include "layout.h"
+#include "locals.h"
+#include "optimizer.h"
+#include "options.h"
+#include "profile.h"
+#include "purity.h"
 #include "semantic.h"
+#include "split.h"
 #include "parser.tab.h"
 
-static FILE *open_input(int argc, char **argv);
+static int parse_arguments(int argc, char **argv, CompilerOptions *options, const char **input_path);
+static FILE *open_input(const char *input_path);
 
 int main(int argc, char **argv)
 {
-	FILE *input = open_input(argc, argv);
+	CompilerOptions options;
+	const char *input_path = NULL;
+	if (!parse_arguments(argc, argv, &options, &input_path))
+	{
+		return EXIT_FAILURE;
+	}
+
+	FILE *input = open_input(input_path);
 	if (!input)
 	{
 		return EXIT_FAILURE;
@@ -39,8 +55,43 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
-	codegen_lua_emit(stdout, program, &sem_info.functions);
+	Profile profile = {0};
+	if (options.profile_use && !profile_load(&profile, options.profile_use))
+	{
+		semantic_info_free(&sem_info);
+		ast_program_destroy(program);
+		if (input != stdin)
+		{
+			fclose(input);
+		}
+		return EXIT_FAILURE;
+	}
+
+	profile_number_loops(program);
+	purity_analyze(program, &sem_info.functions);
+	optimizer_run(program, &sem_info.functions, &options, options.profile_use ? &profile : NULL);
+	range_analyze(program, &options);
+	/* c32 division truncates to an int, so every int stays whole. */
+	if (options.int_semantics == INT_SEMANTICS_C32)
+	{
+		sem_info.functions.fractional_ints = 0;
+	}
+	if (options.profile_generate)
+	{
+		profile_instrument(program);
+	}
+	split_expressions(program);
+	locals_allocate(program, &options);
+	layout_functions(program, &sem_info.functions, &options, options.profile_use ? &profile : NULL);
+
+	int status = EXIT_SUCCESS;
+	if (!codegen_lua_emit(stdout, program, &sem_info.functions, &options))
+	{
+		fprintf(stderr, "failed to write output: %s\n", strerror(errno));
+		status = EXIT_FAILURE;
+	}
 
+	profile_free(&profile);
 	semantic_info_free(&sem_info);
 	ast_program_destroy(program);
 
@@ -49,23 +100,45 @@ int main(int argc, char **argv)
 		fclose(input);
 	}
 
-	return EXIT_SUCCESS;
+	return status;
 }
 
-static FILE *open_input(int argc, char **argv)
+static int parse_arguments(int argc, char **argv, CompilerOptions *options, const char **input_path)
 {
-	if (argc > 2)
+	compiler_options_init(options);
+	for (int i = 1; i < argc; ++i)
 	{
-		fprintf(stderr, "Usage: %s [input.c]\n", argv[0]);
-		return NULL;
+		const char *arg = argv[i];
+		if (arg[0] == '-' && arg[1] != '\0')
+		{
+			if (!compiler_options_parse(options, arg))
+			{
+				fprintf(stderr, "unknown or invalid option '%s'\n", arg);
+				fprintf(stderr, "Usage: %s [options] [input.c]\n", argv[0]);
+				compiler_options_usage(stderr);
+				return 0;
+			}
+			continue;
+		}
+		if (*input_path)
+		{
+			fprintf(stderr, "Usage: %s [options] [input.c]\n", argv[0]);
+			compiler_options_usage(stderr);
+			return 0;
+		}
+		*input_path = arg;
 	}
+	return 1;
+}
 
-	if (argc == 2)
+static FILE *open_input(const char *input_path)
+{
+	if (input_path)
 	{
-		FILE *file = fopen(argv[1], "r");
+		FILE *file = fopen(input_path, "r");
 		if (!file)
 		{
-			fprintf(stderr, "failed to open '%s': %s\n", argv[1], strerror(errno));
+			fprintf(stderr, "failed to open '%s': %s\n", input_path, strerror(errno));
 			return NULL;
 		}
 		return file;
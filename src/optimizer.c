@@ -0,0 +1,4537 @@
+#include "optimizer.h"
+#include "evaluator.h"
+#include "purity.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCALARIZE_MAX_ELEMENTS 16
+#define HOISTED_TABLE_LIMIT 64
+#define RESET_UNROLL_LIMIT 8
+#define DERIVED_OFFSET_LIMIT 8
+
+typedef struct
+{
+	char **items;
+	size_t count;
+	size_t capacity;
+} NameSet;
+
+typedef struct
+{
+	const AstStmt **items;
+	size_t count;
+	size_t capacity;
+} StmtSet;
+
+typedef struct
+{
+	const CompilerOptions *options;
+	FunctionTable *functions;
+	const Profile *profile;
+	const char *function;
+	/* Locals of the current function declared without a value; Lua holds nil
+	 * in them until the first assignment. */
+	NameSet uninitialized;
+	size_t temp_counter;
+} OptimizerContext;
+
+typedef struct
+{
+	AstExpr *call;
+	size_t loop_depth;
+	long long count;
+} CallSite;
+
+typedef struct
+{
+	CallSite *items;
+	size_t count;
+	size_t capacity;
+} CallSiteList;
+
+typedef struct
+{
+	char *key;
+	char *clone_name;
+} Specialization;
+
+typedef struct
+{
+	Specialization *items;
+	size_t count;
+	size_t capacity;
+} SpecializationList;
+
+typedef struct
+{
+	const char *name;
+	AstExpr *start;
+	long long step;
+} InductionVariable;
+
+typedef struct
+{
+	long long factor;
+	char *name;
+	long long offsets[DERIVED_OFFSET_LIMIT];
+	size_t offset_uses[DERIVED_OFFSET_LIMIT];
+	size_t offset_count;
+} DerivedInduction;
+
+typedef struct
+{
+	DerivedInduction *items;
+	size_t count;
+	size_t capacity;
+} DerivedInductionList;
+
+typedef struct
+{
+	size_t index_uses;
+	size_t other_uses;
+} InductionUsage;
+
+typedef struct
+{
+	const AstExpr *index;
+	TypeKind type;
+	int written;
+	int valid;
+} ElementAccess;
+
+static void optimize_function(OptimizerContext *ctx, AstFunction *fn);
+static void evaluate_constant_calls(OptimizerContext *ctx, AstProgram *program);
+static void evaluate_in_statement(OptimizerContext *ctx, const AstProgram *program, AstStmt *stmt);
+static void evaluate_in_expression(OptimizerContext *ctx, const AstProgram *program, AstExpr **slot);
+static void specialize_call_sites(OptimizerContext *ctx, AstProgram *program);
+static void collect_call_sites_in_statement(OptimizerContext *ctx, AstStmt *stmt, size_t depth, long long count, CallSiteList *sites);
+static void collect_call_sites_in_expression(OptimizerContext *ctx, AstExpr *expr, size_t depth, long long count, CallSiteList *sites);
+static int compare_call_sites(const void *left, const void *right);
+static size_t find_function_index(const AstProgram *program, const char *name);
+static int constant_argument(const AstFunction *callee, size_t index, const AstExpr *arg);
+static char *specialization_key(const AstFunction *callee, const AstExpr *call);
+static AstFunction *clone_specialized(OptimizerContext *ctx, const AstFunction *callee, const AstExpr *call, const char *name);
+static void redirect_call(AstFunction *callee, AstExpr *call, const char *name);
+static void remove_unreached_originals(AstProgram *program, const SpecializationList *specializations);
+static size_t function_weight(const AstFunction *fn);
+static size_t statement_weight(const AstStmt *stmt);
+static size_t expression_weight(const AstExpr *expr);
+static void simplify_statements(AstStmtList *list);
+static int statement_returns(const AstStmt *stmt);
+static void eliminate_tail_recursion(OptimizerContext *ctx, AstFunction *fn);
+static int is_self_tail_call(const AstFunction *fn, const AstStmt *stmt);
+static void propagate_copies(OptimizerContext *ctx, AstStmtList *list);
+static int is_copy_declaration(const AstStmt *stmt);
+static void propagate_copies_in_statement(OptimizerContext *ctx, AstStmt *stmt);
+static void fuse_loops(AstStmt *stmt);
+static void fuse_loops_in_list(AstStmtList *list);
+static int loops_can_fuse(const AstStmt *first, const AstStmt *second);
+static int same_loop_header(const AstStmt *first, const AstStmt *second);
+static int header_references(const AstStmt *loop, const char *name);
+static AstStmt *fuse_loop_pair(AstStmt *first, AstStmt *second);
+static int statement_mentions(const AstStmt *stmt, const char *name);
+static int statement_is_fusible(const AstStmt *stmt);
+static int accessed_only_at(const AstStmt *stmt, const char *array, const char *index);
+static int expression_accessed_only_at(const AstExpr *expr, const char *array, const char *index);
+static void hoist_loop_invariants(OptimizerContext *ctx, AstStmt **slot);
+static void hoist_from_statement(OptimizerContext *ctx, AstStmt *stmt, const NameSet *assigned, AstStmtList *hoisted);
+static void hoist_from_expression(OptimizerContext *ctx, AstExpr **slot, const NameSet *assigned, AstStmtList *hoisted);
+static int expr_is_hoistable(const OptimizerContext *ctx, const AstExpr *expr, const NameSet *assigned);
+static int expr_is_invariant(const OptimizerContext *ctx, const AstExpr *expr, const NameSet *assigned);
+static void collect_uninitialized_names(const AstStmt *stmt, NameSet *set);
+static int expr_is_constant(const AstExpr *expr);
+static void rewrite_induction_variables(OptimizerContext *ctx, AstStmt **slot);
+static int match_induction_variable(const AstStmt *loop, InductionVariable *iv);
+static int match_induction_step(const AstExpr *value, const char *name, long long *step);
+static void derive_in_statement(OptimizerContext *ctx, AstStmt *stmt, const InductionVariable *iv, DerivedInductionList *derived);
+static void derive_in_expression(OptimizerContext *ctx, AstExpr *expr, const InductionVariable *iv, DerivedInductionList *derived);
+static void derive_in_index(OptimizerContext *ctx, AstExpr **slot, const InductionVariable *iv, DerivedInductionList *derived);
+static void derive_in_index_at(OptimizerContext *ctx, AstExpr **slot, const InductionVariable *iv, DerivedInductionList *derived, long long offset);
+static long long index_offset(const AstExpr *expr);
+static long long common_offset(const DerivedInduction *d);
+static int match_scaled_induction(const AstExpr *expr, const char *name, long long *factor);
+static void scan_usage_in_statement(const AstStmt *stmt, const char *name, InductionUsage *usage);
+static void scan_usage_in_expression(const AstExpr *expr, const char *name, InductionUsage *usage);
+static void scan_usage_in_index(const AstExpr *expr, const char *name, InductionUsage *usage);
+static int match_direct_comparison(AstExpr *condition, const char *name, AstExpr ***bound_slot);
+static void scalarize_arrays(OptimizerContext *ctx, AstStmtList *list);
+static int array_is_scalarizable(const AstStmt *decl, const AstStmtList *list, size_t start);
+static int constant_uses_in_statement(const AstStmt *stmt, const char *name, size_t size);
+static int constant_uses_in_expression(const AstExpr *expr, const char *name, size_t size);
+static void append_scalar_elements(AstStmtList *list, AstStmt *decl, const char *base);
+static void scalarize_statement(AstStmt **slot, const char *name, const char *base);
+static void scalarize_expression(AstExpr **slot, const char *name, const char *base);
+static char *element_name(const char *base, long long index);
+static void promote_array_elements(OptimizerContext *ctx, AstStmt **slot);
+static void collect_array_names(const AstStmt *stmt, NameSet *names);
+static void collect_array_names_in_expression(const AstExpr *expr, NameSet *names);
+static void scan_element_in_statement(const AstStmt *stmt, const char *name, ElementAccess *access);
+static void scan_element_in_expression(const AstExpr *expr, const char *name, ElementAccess *access);
+static void record_element_index(ElementAccess *access, const AstExpr *index, TypeKind type);
+static void promote_in_statement(AstStmt **slot, const char *name, const char *local);
+static void promote_in_expression(AstExpr **slot, const char *name, const char *local);
+static void narrow_condition_flags(AstFunction *fn);
+static void collect_int_locals(const AstStmt *stmt, NameSet *declared, NameSet *repeated);
+static int flag_uses_in_statement(const AstStmt *stmt, const char *name, size_t *reads);
+static int flag_uses_in_expression(const AstExpr *expr, const char *name, int in_condition, size_t *reads);
+static int is_flag_value(const AstExpr *expr);
+static void retype_flag_in_statement(AstStmt *stmt, const char *name);
+static void retype_flag_in_expression(AstExpr *expr, const char *name);
+static void hoist_constant_arrays(OptimizerContext *ctx, AstProgram *program, AstStmtList *list, int runs_once);
+static void hoist_constant_arrays_in_statement(OptimizerContext *ctx, AstProgram *program, AstStmt *stmt, int runs_once);
+static int is_constant_array(const AstStmt *decl, const AstStmtList *list, size_t start);
+static void reuse_loop_arrays(OptimizerContext *ctx, AstStmtList *list, StmtSet *hoisted);
+static int array_is_reusable(const AstStmt *loop, const AstStmtList *body, size_t index);
+static void build_array_reset(OptimizerContext *ctx, AstStmt *decl, const AstStmtList *body, size_t start, AstStmtList *reset);
+static int array_written_before_read(const AstStmt *decl, const AstStmtList *list, size_t start);
+static int loop_fills_array(AstStmt *loop, const char *name, size_t size);
+static AstStmt *make_element_store(const AstStmt *decl, AstExpr *index, AstExpr *value);
+static AstExpr *element_default(TypeKind type);
+static size_t replace_statement(AstStmtList *list, size_t index, AstStmtList *replacement);
+static void stmt_set_add(StmtSet *set, const AstStmt *stmt);
+static int stmt_set_contains(const StmtSet *set, const AstStmt *stmt);
+static void unroll_loops(OptimizerContext *ctx, AstStmt **slot);
+static int match_loop_bound(AstStmt *loop, const InductionVariable *iv, AstBinaryOp *op, AstExpr **bound);
+static int bound_holds(long long value, AstBinaryOp op, long long bound);
+static int unroll_nest_fully(OptimizerContext *ctx, AstStmt **slot, const InductionVariable *iv, AstBinaryOp op, const AstExpr *bound);
+static AstStmt *unroll_fully(OptimizerContext *ctx, const AstStmt *loop, const InductionVariable *iv, long long trip_count);
+static AstStmt *unroll_partially(OptimizerContext *ctx, AstStmt *loop, const InductionVariable *iv);
+static void append_body_copy(OptimizerContext *ctx, AstStmtList *list, const AstStmt *body, const char *name, const AstExpr *replacement);
+static void append_statements(AstStmtList *list, AstStmt *stmt);
+static void flatten_blocks(AstStmtList *list);
+static int declares_only(const AstStmt *block);
+static size_t statement_size(const AstStmt *stmt);
+static int contains_loop(const AstStmt *stmt);
+static int contains_return(const AstStmt *stmt);
+static int is_self_assignment(const AstStmt *stmt);
+static void fold_statement(OptimizerContext *ctx, AstStmt *stmt);
+static void fold_expression(OptimizerContext *ctx, AstExpr **slot);
+static int fold_condition(AstExpr **slot);
+static void substitute_in_statement(AstStmt *stmt, const char *name, const AstExpr *replacement);
+static void substitute_in_expression(AstExpr **slot, const char *name, const AstExpr *replacement);
+static int is_index_additive(const AstExpr *expr);
+static int is_identifier(const AstExpr *expr, const char *name);
+static AstExpr *add_constant(AstExpr *expr, long long value);
+static AstExpr *make_int(long long value);
+static long long fold_int(const OptimizerContext *ctx, long long value);
+static long long wrap_int32(long long value);
+static AstExpr *make_bool(int value);
+static AstExpr *make_binary(AstBinaryOp op, AstExpr *left, AstExpr *right, TypeKind type);
+static AstExpr *make_identifier(const char *name, TypeKind type);
+static AstStmt *wrap_with_prelude(AstStmt *stmt, AstStmtList *prelude);
+static void collect_assigned_names(const AstStmt *stmt, NameSet *set);
+static void name_set_add(NameSet *set, const char *name);
+static int name_set_contains(const NameSet *set, const char *name);
+static void name_set_free(NameSet *set);
+static char *make_temp_name(OptimizerContext *ctx, const char *prefix);
+static char *dup_string(const char *src);
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed);
+
+void optimizer_run(AstProgram *program, FunctionTable *functions, const CompilerOptions *options, const Profile *profile)
+{
+	if (!program || !functions || !options)
+	{
+		return;
+	}
+	OptimizerContext ctx = {0};
+	ctx.options = options;
+	ctx.functions = functions;
+	ctx.profile = profile;
+	evaluate_constant_calls(&ctx, program);
+	specialize_call_sites(&ctx, program);
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		AstFunction *fn = program->functions.items[i];
+		optimize_function(&ctx, fn);
+		hoist_constant_arrays(&ctx, program, &fn->body.statements, strcmp(fn->name, "main") == 0);
+	}
+}
+
+static void optimize_function(OptimizerContext *ctx, AstFunction *fn)
+{
+	if (!fn)
+	{
+		return;
+	}
+	ctx->function = fn->name;
+	eliminate_tail_recursion(ctx, fn);
+	propagate_copies(ctx, &fn->body.statements);
+	fuse_loops_in_list(&fn->body.statements);
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		collect_uninitialized_names(fn->body.statements.items[i], &ctx->uninitialized);
+	}
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		hoist_loop_invariants(ctx, &fn->body.statements.items[i]);
+	}
+	name_set_free(&ctx->uninitialized);
+	/* Instrumented builds keep loops whole so their counts match the source. */
+	if (ctx->options->unroll_loops && !ctx->options->profile_generate)
+	{
+		for (size_t i = 0; i < fn->body.statements.count; ++i)
+		{
+			unroll_loops(ctx, &fn->body.statements.items[i]);
+		}
+	}
+	scalarize_arrays(ctx, &fn->body.statements);
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		promote_array_elements(ctx, &fn->body.statements.items[i]);
+	}
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		rewrite_induction_variables(ctx, &fn->body.statements.items[i]);
+	}
+	StmtSet hoisted = {0};
+	reuse_loop_arrays(ctx, &fn->body.statements, &hoisted);
+	free(hoisted.items);
+	narrow_condition_flags(fn);
+}
+
+static void evaluate_constant_calls(OptimizerContext *ctx, AstProgram *program)
+{
+	if (ctx->options->eval_limit == 0)
+	{
+		return;
+	}
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		AstFunction *fn = program->functions.items[i];
+		for (size_t j = 0; j < fn->body.statements.count; ++j)
+		{
+			evaluate_in_statement(ctx, program, fn->body.statements.items[j]);
+		}
+	}
+}
+
+static void evaluate_in_statement(OptimizerContext *ctx, const AstProgram *program, AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			evaluate_in_statement(ctx, program, stmt->data.block.statements.items[i]);
+		}
+		break;
+	case STMT_DECL:
+		evaluate_in_expression(ctx, program, &stmt->data.decl.init);
+		evaluate_in_expression(ctx, program, &stmt->data.decl.array_init);
+		break;
+	case STMT_ASSIGN:
+		evaluate_in_expression(ctx, program, &stmt->data.assign.value);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		evaluate_in_expression(ctx, program, &stmt->data.array_assign.index);
+		evaluate_in_expression(ctx, program, &stmt->data.array_assign.value);
+		break;
+	case STMT_WHILE:
+		evaluate_in_expression(ctx, program, &stmt->data.while_stmt.condition);
+		evaluate_in_statement(ctx, program, stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+		evaluate_in_statement(ctx, program, stmt->data.for_stmt.init);
+		evaluate_in_expression(ctx, program, &stmt->data.for_stmt.condition);
+		evaluate_in_statement(ctx, program, stmt->data.for_stmt.post);
+		evaluate_in_statement(ctx, program, stmt->data.for_stmt.body);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		evaluate_in_expression(ctx, program, &stmt->data.expr);
+		break;
+	}
+}
+
+/* Innermost calls first, so pow2(pow2(2)) folds in two steps. */
+static void evaluate_in_expression(OptimizerContext *ctx, const AstProgram *program, AstExpr **slot)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		evaluate_in_expression(ctx, program, &expr->data.binary.left);
+		evaluate_in_expression(ctx, program, &expr->data.binary.right);
+		fold_expression(ctx, slot);
+		break;
+	case EXPR_UNARY:
+		evaluate_in_expression(ctx, program, &expr->data.unary.operand);
+		fold_expression(ctx, slot);
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			evaluate_in_expression(ctx, program, &expr->data.array_literal.elements.items[i]);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		evaluate_in_expression(ctx, program, &expr->data.subscript.index);
+		break;
+	case EXPR_CALL:
+	{
+		int literal_args = 1;
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			evaluate_in_expression(ctx, program, &expr->data.call.args.items[i]);
+			fold_expression(ctx, &expr->data.call.args.items[i]);
+			AstExpr *arg = expr->data.call.args.items[i];
+			if (arg->kind != EXPR_INT_LITERAL && arg->kind != EXPR_FLOAT_LITERAL && arg->kind != EXPR_BOOL_LITERAL)
+			{
+				literal_args = 0;
+			}
+		}
+		const FunctionSignature *signature = function_table_find(ctx->functions, expr->data.call.callee);
+		if (!literal_args || !signature || !signature->is_pure)
+		{
+			break;
+		}
+		AstExpr *result = evaluator_call(program, ctx->functions, expr, ctx->options);
+		if (result)
+		{
+			ast_expr_destroy(expr);
+			*slot = result;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+/* Clones a callee for each distinct set of literal arguments it receives and
+ * folds the constants into the clone. Call sites a profile counts most often,
+ * or without one those nested deepest in loops, are served first until the
+ * clones use up the --specialize-limit budget. Sites a profile never saw run,
+ * and without a profile sites outside any loop, are left alone. A clone that
+ * folds nothing away is not kept, and an original that no call reaches any
+ * more is dropped. */
+static void specialize_call_sites(OptimizerContext *ctx, AstProgram *program)
+{
+	size_t budget = ctx->options->specialize_limit;
+	if (budget == 0)
+	{
+		return;
+	}
+
+	CallSiteList sites = {0};
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		AstFunction *fn = program->functions.items[i];
+		long long calls = profile_calls(ctx->profile, fn->name);
+		ctx->function = fn->name;
+		for (size_t j = 0; j < fn->body.statements.count; ++j)
+		{
+			collect_call_sites_in_statement(ctx, fn->body.statements.items[j], 0, calls, &sites);
+		}
+	}
+	if (sites.count > 1)
+	{
+		qsort(sites.items, sites.count, sizeof(CallSite), compare_call_sites);
+	}
+
+	SpecializationList specializations = {0};
+	for (size_t i = 0; i < sites.count; ++i)
+	{
+		AstExpr *call = sites.items[i].call;
+		size_t index = find_function_index(program, call->data.call.callee);
+		if (index == program->functions.count || sites.items[i].count == 0 ||
+			(!ctx->profile && sites.items[i].loop_depth == 0))
+		{
+			continue;
+		}
+		AstFunction *callee = program->functions.items[index];
+		if (strcmp(callee->name, "main") == 0 || purity_function_calls(callee, callee->name) ||
+			call->data.call.args.count != callee->params.count)
+		{
+			continue;
+		}
+		char *key = specialization_key(callee, call);
+		if (!key)
+		{
+			continue;
+		}
+
+		const Specialization *known = NULL;
+		for (size_t j = 0; j < specializations.count; ++j)
+		{
+			if (strcmp(specializations.items[j].key, key) == 0)
+			{
+				known = &specializations.items[j];
+				break;
+			}
+		}
+		const char *clone_name = known ? known->clone_name : NULL;
+		if (known && !clone_name)
+		{
+			free(key);
+			continue;
+		}
+		if (!clone_name)
+		{
+			size_t size = 0;
+			for (size_t j = 0; j < callee->body.statements.count; ++j)
+			{
+				size += statement_size(callee->body.statements.items[j]);
+			}
+			if (size > budget)
+			{
+				free(key);
+				continue;
+			}
+
+			char buffer[256];
+			snprintf(buffer, sizeof(buffer), "%s__spec%zu", callee->name, ctx->temp_counter + 1);
+			AstFunction *clone = clone_specialized(ctx, callee, call, buffer);
+			ensure_capacity((void **)&specializations.items, sizeof(Specialization), &specializations.capacity, specializations.count + 1);
+			if (function_weight(clone) >= function_weight(callee))
+			{
+				ast_function_destroy(clone);
+				specializations.items[specializations.count].key = key;
+				specializations.items[specializations.count++].clone_name = NULL;
+				continue;
+			}
+			budget -= size;
+			++ctx->temp_counter;
+			const FunctionSignature *original = function_table_find(ctx->functions, callee->name);
+			int is_pure = original && original->is_pure;
+			FunctionSignature *signature = function_table_add(ctx->functions, clone->name, clone->return_type, &clone->params);
+			if (signature)
+			{
+				signature->is_pure = is_pure;
+			}
+
+			size_t position = index + 1;
+			size_t prefix = strlen(callee->name);
+			while (position < program->functions.count &&
+				   strncmp(program->functions.items[position]->name, callee->name, prefix) == 0 &&
+				   strncmp(program->functions.items[position]->name + prefix, "__spec", 6) == 0)
+			{
+				++position;
+			}
+			ast_program_add_function(program, clone);
+			memmove(&program->functions.items[position + 1], &program->functions.items[position],
+					(program->functions.count - position - 1) * sizeof(AstFunction *));
+			program->functions.items[position] = clone;
+
+			specializations.items[specializations.count].key = key;
+			specializations.items[specializations.count].clone_name = dup_string(clone->name);
+			clone_name = specializations.items[specializations.count++].clone_name;
+			key = NULL;
+		}
+		redirect_call(callee, call, clone_name);
+		free(key);
+	}
+	remove_unreached_originals(program, &specializations);
+
+	for (size_t i = 0; i < specializations.count; ++i)
+	{
+		free(specializations.items[i].key);
+		free(specializations.items[i].clone_name);
+	}
+	free(specializations.items);
+	free(sites.items);
+}
+
+static void collect_call_sites_in_statement(OptimizerContext *ctx, AstStmt *stmt, size_t depth, long long count, CallSiteList *sites)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			collect_call_sites_in_statement(ctx, stmt->data.block.statements.items[i], depth, count, sites);
+		}
+		break;
+	case STMT_DECL:
+		collect_call_sites_in_expression(ctx, stmt->data.decl.init, depth, count, sites);
+		collect_call_sites_in_expression(ctx, stmt->data.decl.array_init, depth, count, sites);
+		break;
+	case STMT_ASSIGN:
+		collect_call_sites_in_expression(ctx, stmt->data.assign.value, depth, count, sites);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		collect_call_sites_in_expression(ctx, stmt->data.array_assign.index, depth, count, sites);
+		collect_call_sites_in_expression(ctx, stmt->data.array_assign.value, depth, count, sites);
+		break;
+	case STMT_WHILE:
+	{
+		long long trips = profile_trips(ctx->profile, ctx->function, stmt->data.while_stmt.profile_id);
+		trips = trips >= 0 ? trips : count;
+		collect_call_sites_in_expression(ctx, stmt->data.while_stmt.condition, depth + 1, trips, sites);
+		collect_call_sites_in_statement(ctx, stmt->data.while_stmt.body, depth + 1, trips, sites);
+		break;
+	}
+	case STMT_FOR:
+	{
+		long long trips = profile_trips(ctx->profile, ctx->function, stmt->data.for_stmt.profile_id);
+		trips = trips >= 0 ? trips : count;
+		collect_call_sites_in_statement(ctx, stmt->data.for_stmt.init, depth, count, sites);
+		collect_call_sites_in_expression(ctx, stmt->data.for_stmt.condition, depth + 1, trips, sites);
+		collect_call_sites_in_statement(ctx, stmt->data.for_stmt.post, depth + 1, trips, sites);
+		collect_call_sites_in_statement(ctx, stmt->data.for_stmt.body, depth + 1, trips, sites);
+		break;
+	}
+	case STMT_EXPR:
+	case STMT_RETURN:
+		collect_call_sites_in_expression(ctx, stmt->data.expr, depth, count, sites);
+		break;
+	}
+}
+
+static void collect_call_sites_in_expression(OptimizerContext *ctx, AstExpr *expr, size_t depth, long long count, CallSiteList *sites)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		collect_call_sites_in_expression(ctx, expr->data.binary.left, depth, count, sites);
+		collect_call_sites_in_expression(ctx, expr->data.binary.right, depth, count, sites);
+		break;
+	case EXPR_UNARY:
+		collect_call_sites_in_expression(ctx, expr->data.unary.operand, depth, count, sites);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			fold_expression(ctx, &expr->data.call.args.items[i]);
+			collect_call_sites_in_expression(ctx, expr->data.call.args.items[i], depth, count, sites);
+		}
+		ensure_capacity((void **)&sites->items, sizeof(CallSite), &sites->capacity, sites->count + 1);
+		sites->items[sites->count].call = expr;
+		sites->items[sites->count].loop_depth = depth;
+		sites->items[sites->count].count = count;
+		sites->count++;
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			collect_call_sites_in_expression(ctx, expr->data.array_literal.elements.items[i], depth, count, sites);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		collect_call_sites_in_expression(ctx, expr->data.subscript.index, depth, count, sites);
+		break;
+	default:
+		break;
+	}
+}
+
+static int compare_call_sites(const void *left, const void *right)
+{
+	const CallSite *a = left;
+	const CallSite *b = right;
+	if (a->count != b->count)
+	{
+		return a->count > b->count ? -1 : 1;
+	}
+	if (a->loop_depth != b->loop_depth)
+	{
+		return a->loop_depth > b->loop_depth ? -1 : 1;
+	}
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static size_t find_function_index(const AstProgram *program, const char *name)
+{
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		if (strcmp(program->functions.items[i]->name, name) == 0)
+		{
+			return i;
+		}
+	}
+	return program->functions.count;
+}
+
+static int constant_argument(const AstFunction *callee, size_t index, const AstExpr *arg)
+{
+	const AstParam *param = &callee->params.items[index];
+	for (size_t i = 0; i < callee->body.statements.count; ++i)
+	{
+		if (ast_stmt_assigns(callee->body.statements.items[i], param->name))
+		{
+			return 0;
+		}
+	}
+	switch (param->type)
+	{
+	case TYPE_INT:
+		return arg->kind == EXPR_INT_LITERAL;
+	case TYPE_FLOAT:
+		return arg->kind == EXPR_FLOAT_LITERAL || arg->kind == EXPR_INT_LITERAL;
+	case TYPE_BOOL:
+		return arg->kind == EXPR_BOOL_LITERAL;
+	default:
+		return 0;
+	}
+}
+
+static char *specialization_key(const AstFunction *callee, const AstExpr *call)
+{
+	char buffer[512];
+	size_t length = (size_t)snprintf(buffer, sizeof(buffer), "%s", callee->name);
+	int any = 0;
+	for (size_t i = 0; i < call->data.call.args.count && length < sizeof(buffer); ++i)
+	{
+		const AstExpr *arg = call->data.call.args.items[i];
+		if (!constant_argument(callee, i, arg))
+		{
+			length += (size_t)snprintf(buffer + length, sizeof(buffer) - length, "|_");
+			continue;
+		}
+		any = 1;
+		switch (arg->kind)
+		{
+		case EXPR_INT_LITERAL:
+			length += (size_t)snprintf(buffer + length, sizeof(buffer) - length, "|%lld", arg->data.int_value);
+			break;
+		case EXPR_FLOAT_LITERAL:
+			length += (size_t)snprintf(buffer + length, sizeof(buffer) - length, "|%.17g", arg->data.float_value);
+			break;
+		default:
+			length += (size_t)snprintf(buffer + length, sizeof(buffer) - length, "|%s", arg->data.bool_value ? "true" : "false");
+			break;
+		}
+	}
+	if (!any || length >= sizeof(buffer))
+	{
+		return NULL;
+	}
+	return dup_string(buffer);
+}
+
+static AstFunction *clone_specialized(OptimizerContext *ctx, const AstFunction *callee, const AstExpr *call, const char *name)
+{
+	AstParamList params = ast_param_list_make();
+	AstStmtList statements = ast_stmt_list_make();
+	for (size_t i = 0; i < callee->body.statements.count; ++i)
+	{
+		ast_stmt_list_push(&statements, ast_stmt_clone(callee->body.statements.items[i]));
+	}
+
+	for (size_t i = 0; i < callee->params.count; ++i)
+	{
+		const AstParam *param = &callee->params.items[i];
+		const AstExpr *arg = call->data.call.args.items[i];
+		if (!constant_argument(callee, i, arg))
+		{
+			AstParam copy;
+			copy.name = dup_string(param->name);
+			copy.type = param->type;
+			ast_param_list_push(&params, copy);
+			continue;
+		}
+		AstExpr *value = param->type == TYPE_FLOAT && arg->kind == EXPR_INT_LITERAL
+							 ? ast_expr_make_float((double)arg->data.int_value)
+							 : ast_expr_clone(arg);
+		for (size_t j = 0; j < statements.count; ++j)
+		{
+			substitute_in_statement(statements.items[j], param->name, value);
+		}
+		ast_expr_destroy(value);
+	}
+
+	for (size_t i = 0; i < statements.count; ++i)
+	{
+		fold_statement(ctx, statements.items[i]);
+	}
+	simplify_statements(&statements);
+
+	AstBlock body = ast_block_from_list(&statements);
+	AstFunction *clone = ast_function_create(callee->return_type, dup_string(name), &params, &body);
+	clone->has_mandatory_return = callee->has_mandatory_return;
+	return clone;
+}
+
+/* Removes each specialized function that only its clones are now called in
+ * place of. */
+static void remove_unreached_originals(AstProgram *program, const SpecializationList *specializations)
+{
+	size_t kept = 0;
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		AstFunction *fn = program->functions.items[i];
+		int specialized = 0;
+		for (size_t j = 0; j < specializations->count && !specialized; ++j)
+		{
+			const char *key = specializations->items[j].key;
+			size_t length = strlen(fn->name);
+			specialized = specializations->items[j].clone_name && strncmp(key, fn->name, length) == 0 && key[length] == '|';
+		}
+		int reached = !specialized;
+		for (size_t j = 0; j < program->functions.count && !reached; ++j)
+		{
+			reached = j != i && purity_function_calls(program->functions.items[j], fn->name);
+		}
+		if (!reached)
+		{
+			ast_function_destroy(fn);
+			continue;
+		}
+		program->functions.items[kept++] = fn;
+	}
+	program->functions.count = kept;
+}
+
+/* Statements plus expression nodes, so a clone can be told apart from its
+ * original once folding has removed anything. */
+static size_t function_weight(const AstFunction *fn)
+{
+	size_t weight = 0;
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		weight += statement_weight(fn->body.statements.items[i]);
+	}
+	return weight;
+}
+
+static size_t statement_weight(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+	{
+		size_t weight = 1;
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			weight += statement_weight(stmt->data.block.statements.items[i]);
+		}
+		return weight;
+	}
+	case STMT_DECL:
+		return 1 + expression_weight(stmt->data.decl.init) + expression_weight(stmt->data.decl.array_init);
+	case STMT_ASSIGN:
+		return 1 + expression_weight(stmt->data.assign.value);
+	case STMT_ARRAY_ASSIGN:
+		return 1 + expression_weight(stmt->data.array_assign.index) + expression_weight(stmt->data.array_assign.value);
+	case STMT_WHILE:
+		return 1 + expression_weight(stmt->data.while_stmt.condition) + statement_weight(stmt->data.while_stmt.body);
+	case STMT_FOR:
+		return 1 + statement_weight(stmt->data.for_stmt.init) + expression_weight(stmt->data.for_stmt.condition) +
+			   statement_weight(stmt->data.for_stmt.post) + statement_weight(stmt->data.for_stmt.body);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return 1 + expression_weight(stmt->data.expr);
+	}
+	return 1;
+}
+
+static size_t expression_weight(const AstExpr *expr)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		return 1 + expression_weight(expr->data.binary.left) + expression_weight(expr->data.binary.right);
+	case EXPR_UNARY:
+		return 1 + expression_weight(expr->data.unary.operand);
+	case EXPR_CALL:
+	{
+		size_t weight = 1;
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			weight += expression_weight(expr->data.call.args.items[i]);
+		}
+		return weight;
+	}
+	case EXPR_ARRAY_LITERAL:
+	{
+		size_t weight = 1;
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			weight += expression_weight(expr->data.array_literal.elements.items[i]);
+		}
+		return weight;
+	}
+	case EXPR_SUBSCRIPT:
+		return 1 + expression_weight(expr->data.subscript.array) + expression_weight(expr->data.subscript.index);
+	default:
+		return 1;
+	}
+}
+
+static void redirect_call(AstFunction *callee, AstExpr *call, const char *name)
+{
+	AstExprList *args = &call->data.call.args;
+	size_t kept = 0;
+	for (size_t i = 0; i < args->count; ++i)
+	{
+		if (constant_argument(callee, i, args->items[i]))
+		{
+			ast_expr_destroy(args->items[i]);
+			continue;
+		}
+		args->items[kept++] = args->items[i];
+	}
+	args->count = kept;
+	free(call->data.call.callee);
+	call->data.call.callee = dup_string(name);
+}
+
+/* Drops while (false) loops, opens while (true) loops whose body always
+ * returns on the first pass, and cuts statements that follow a return. */
+static void simplify_statements(AstStmtList *list)
+{
+	size_t i = 0;
+	while (i < list->count)
+	{
+		AstStmt *stmt = list->items[i];
+		switch (stmt->kind)
+		{
+		case STMT_BLOCK:
+			simplify_statements(&stmt->data.block.statements);
+			break;
+		case STMT_WHILE:
+			if (stmt->data.while_stmt.body && stmt->data.while_stmt.body->kind == STMT_BLOCK)
+			{
+				simplify_statements(&stmt->data.while_stmt.body->data.block.statements);
+			}
+			break;
+		case STMT_FOR:
+			if (stmt->data.for_stmt.body && stmt->data.for_stmt.body->kind == STMT_BLOCK)
+			{
+				simplify_statements(&stmt->data.for_stmt.body->data.block.statements);
+			}
+			break;
+		default:
+			break;
+		}
+
+		if (stmt->kind == STMT_WHILE && stmt->data.while_stmt.condition->kind == EXPR_BOOL_LITERAL)
+		{
+			if (!stmt->data.while_stmt.condition->data.bool_value)
+			{
+				ast_stmt_destroy(stmt);
+				memmove(&list->items[i], &list->items[i + 1], (list->count - i - 1) * sizeof(AstStmt *));
+				--list->count;
+				continue;
+			}
+			if (statement_returns(stmt->data.while_stmt.body))
+			{
+				list->items[i] = stmt->data.while_stmt.body;
+				stmt->data.while_stmt.body = NULL;
+				ast_stmt_destroy(stmt);
+				stmt = list->items[i];
+			}
+		}
+
+		if (statement_returns(stmt))
+		{
+			for (size_t j = i + 1; j < list->count; ++j)
+			{
+				ast_stmt_destroy(list->items[j]);
+			}
+			list->count = i + 1;
+			break;
+		}
+		++i;
+	}
+}
+
+static int statement_returns(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+	if (stmt->kind == STMT_RETURN)
+	{
+		return 1;
+	}
+	if (stmt->kind == STMT_BLOCK && stmt->data.block.statements.count > 0)
+	{
+		return statement_returns(stmt->data.block.statements.items[stmt->data.block.statements.count - 1]);
+	}
+	return 0;
+}
+
+/* A trailing return f(args) in f becomes a parameter update at the end of a
+ * while (true) loop around the body. Arguments that a later argument still
+ * reads through the old parameter value are staged in temporaries first. */
+static void eliminate_tail_recursion(OptimizerContext *ctx, AstFunction *fn)
+{
+	AstStmtList *statements = &fn->body.statements;
+	if (strcmp(fn->name, "main") == 0 || statements->count == 0 ||
+		!is_self_tail_call(fn, statements->items[statements->count - 1]))
+	{
+		return;
+	}
+
+	AstStmt *tail = statements->items[--statements->count];
+	AstExprList *args = &tail->data.expr->data.call.args;
+	AstStmtList body = ast_stmt_list_make();
+	for (size_t i = 0; i < statements->count; ++i)
+	{
+		ast_stmt_list_push(&body, statements->items[i]);
+	}
+	statements->count = 0;
+
+	AstStmtList deferred = ast_stmt_list_make();
+	for (size_t i = 0; i < args->count; ++i)
+	{
+		const AstParam *param = &fn->params.items[i];
+		AstExpr *arg = args->items[i];
+		args->items[i] = NULL;
+		if (is_identifier(arg, param->name))
+		{
+			ast_expr_destroy(arg);
+			continue;
+		}
+
+		int read_later = 0;
+		for (size_t j = i + 1; j < args->count && !read_later; ++j)
+		{
+			read_later = ast_expr_references(args->items[j], param->name);
+		}
+
+		AstStmt *update;
+		if (read_later)
+		{
+			char *temp = make_temp_name(ctx, "__tail");
+			ast_stmt_list_push(&body, ast_stmt_make_decl(param->type, dup_string(temp), arg));
+			update = ast_stmt_make_assign(dup_string(param->name), make_identifier(temp, param->type));
+			update->data.assign.type = param->type;
+			ast_stmt_list_push(&deferred, update);
+			free(temp);
+			continue;
+		}
+		update = ast_stmt_make_assign(dup_string(param->name), arg);
+		update->data.assign.type = param->type;
+		ast_stmt_list_push(&body, update);
+	}
+	for (size_t i = 0; i < deferred.count; ++i)
+	{
+		ast_stmt_list_push(&body, deferred.items[i]);
+	}
+	free(deferred.items);
+	ast_stmt_destroy(tail);
+
+	AstBlock block = ast_block_from_list(&body);
+	AstExpr *forever = ast_expr_make_bool(1);
+	forever->type = TYPE_BOOL;
+	ast_stmt_list_push(statements, ast_stmt_make_while(forever, ast_stmt_make_block(&block)));
+}
+
+static int is_self_tail_call(const AstFunction *fn, const AstStmt *stmt)
+{
+	if (!stmt || stmt->kind != STMT_RETURN || !stmt->data.expr || stmt->data.expr->kind != EXPR_CALL)
+	{
+		return 0;
+	}
+	const AstExpr *call = stmt->data.expr;
+	return strcmp(call->data.call.callee, fn->name) == 0 && call->data.call.args.count == fn->params.count;
+}
+
+/* Forwards `T t = x;` and `T t = literal;` into the statements that follow
+ * until t or x is reassigned or redeclared, then drops t if nothing refers to
+ * it any more. A statement that reassigns one of them still gets its right-hand
+ * side rewritten, since that is evaluated before the store. */
+static void propagate_copies(OptimizerContext *ctx, AstStmtList *list)
+{
+	size_t i = 0;
+	while (i < list->count)
+	{
+		AstStmt *decl = list->items[i];
+		if (!is_copy_declaration(decl))
+		{
+			++i;
+			continue;
+		}
+
+		const char *name = decl->data.decl.name;
+		const AstExpr *source = decl->data.decl.init;
+		size_t j = i + 1;
+		for (; j < list->count; ++j)
+		{
+			AstStmt *stmt = list->items[j];
+			if (ast_stmt_assigns(stmt, name) ||
+				(source->kind == EXPR_IDENTIFIER && ast_stmt_assigns(stmt, source->data.identifier)))
+			{
+				if (stmt->kind == STMT_ASSIGN)
+				{
+					substitute_in_expression(&stmt->data.assign.value, name, source);
+					fold_expression(ctx, &stmt->data.assign.value);
+				}
+				break;
+			}
+			substitute_in_statement(stmt, name, source);
+			fold_statement(ctx, stmt);
+		}
+
+		int referenced = 0;
+		for (size_t k = j; k < list->count && !referenced; ++k)
+		{
+			referenced = statement_mentions(list->items[k], name);
+		}
+		if (referenced)
+		{
+			++i;
+			continue;
+		}
+		ast_stmt_destroy(decl);
+		memmove(&list->items[i], &list->items[i + 1], (list->count - i - 1) * sizeof(AstStmt *));
+		--list->count;
+	}
+
+	for (i = 0; i < list->count; ++i)
+	{
+		propagate_copies_in_statement(ctx, list->items[i]);
+	}
+}
+
+static int is_copy_declaration(const AstStmt *stmt)
+{
+	if (stmt->kind != STMT_DECL || stmt->data.decl.is_array || !stmt->data.decl.init)
+	{
+		return 0;
+	}
+	const AstExpr *init = stmt->data.decl.init;
+	if (init->type != stmt->data.decl.type)
+	{
+		return 0;
+	}
+	switch (init->kind)
+	{
+	case EXPR_INT_LITERAL:
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+		return 1;
+	case EXPR_IDENTIFIER:
+		return strcmp(init->data.identifier, stmt->data.decl.name) != 0;
+	default:
+		return 0;
+	}
+}
+
+static void propagate_copies_in_statement(OptimizerContext *ctx, AstStmt *stmt)
+{
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		propagate_copies(ctx, &stmt->data.block.statements);
+		break;
+	case STMT_WHILE:
+		if (stmt->data.while_stmt.body)
+		{
+			propagate_copies_in_statement(ctx, stmt->data.while_stmt.body);
+		}
+		break;
+	case STMT_FOR:
+		if (stmt->data.for_stmt.body)
+		{
+			propagate_copies_in_statement(ctx, stmt->data.for_stmt.body);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void fuse_loops(AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		fuse_loops_in_list(&stmt->data.block.statements);
+		break;
+	case STMT_WHILE:
+		fuse_loops(stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+		fuse_loops(stmt->data.for_stmt.body);
+		break;
+	default:
+		break;
+	}
+}
+
+static void fuse_loops_in_list(AstStmtList *list)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		fuse_loops(list->items[i]);
+	}
+
+	size_t i = 0;
+	while (i + 1 < list->count)
+	{
+		if (!loops_can_fuse(list->items[i], list->items[i + 1]))
+		{
+			++i;
+			continue;
+		}
+		list->items[i] = fuse_loop_pair(list->items[i], list->items[i + 1]);
+		memmove(&list->items[i + 1], &list->items[i + 2], (list->count - i - 2) * sizeof(AstStmt *));
+		--list->count;
+	}
+}
+
+/* Iteration j of the fused loop runs both bodies for the same value of i, so
+ * anything one body writes may only be touched by the other as name[i]. */
+static int loops_can_fuse(const AstStmt *first, const AstStmt *second)
+{
+	if (first->kind != STMT_FOR || second->kind != STMT_FOR || !same_loop_header(first, second))
+	{
+		return 0;
+	}
+
+	InductionVariable iv;
+	if (!match_induction_variable(first, &iv) || ast_stmt_assigns(second->data.for_stmt.body, iv.name))
+	{
+		return 0;
+	}
+	const AstStmt *first_body = first->data.for_stmt.body;
+	const AstStmt *second_body = second->data.for_stmt.body;
+	if (!statement_is_fusible(first_body) || !statement_is_fusible(second_body))
+	{
+		return 0;
+	}
+
+	NameSet assigned = {0};
+	collect_assigned_names(first_body, &assigned);
+	collect_assigned_names(second_body, &assigned);
+	int ok = 1;
+	for (size_t i = 0; ok && i < assigned.count; ++i)
+	{
+		const char *name = assigned.items[i];
+		if (header_references(first, name))
+		{
+			ok = 0;
+		}
+		else if (statement_mentions(first_body, name) && statement_mentions(second_body, name))
+		{
+			ok = accessed_only_at(first_body, name, iv.name) && accessed_only_at(second_body, name, iv.name);
+		}
+	}
+	name_set_free(&assigned);
+	return ok;
+}
+
+static int same_loop_header(const AstStmt *first, const AstStmt *second)
+{
+	const AstStmt *a = first->data.for_stmt.init;
+	const AstStmt *b = second->data.for_stmt.init;
+	if (!a || !b || a->kind != STMT_DECL || b->kind != STMT_DECL || a->data.decl.is_array || b->data.decl.is_array ||
+		a->data.decl.type != b->data.decl.type || strcmp(a->data.decl.name, b->data.decl.name) != 0 ||
+		!ast_expr_equal(a->data.decl.init, b->data.decl.init))
+	{
+		return 0;
+	}
+	if (!ast_expr_equal(first->data.for_stmt.condition, second->data.for_stmt.condition))
+	{
+		return 0;
+	}
+	a = first->data.for_stmt.post;
+	b = second->data.for_stmt.post;
+	return a && b && a->kind == STMT_ASSIGN && b->kind == STMT_ASSIGN &&
+		   strcmp(a->data.assign.name, b->data.assign.name) == 0 &&
+		   ast_expr_equal(a->data.assign.value, b->data.assign.value) &&
+		   !ast_expr_contains_call(first->data.for_stmt.init->data.decl.init) &&
+		   !ast_expr_contains_call(first->data.for_stmt.condition);
+}
+
+static int header_references(const AstStmt *loop, const char *name)
+{
+	return ast_expr_references(loop->data.for_stmt.init->data.decl.init, name) ||
+		   ast_expr_references(loop->data.for_stmt.condition, name) ||
+		   ast_expr_references(loop->data.for_stmt.post->data.assign.value, name);
+}
+
+static AstStmt *fuse_loop_pair(AstStmt *first, AstStmt *second)
+{
+	AstStmtList list = ast_stmt_list_make();
+	append_statements(&list, first->data.for_stmt.body);
+	append_statements(&list, second->data.for_stmt.body);
+	second->data.for_stmt.body = NULL;
+	ast_stmt_destroy(second);
+	AstBlock block = ast_block_from_list(&list);
+	first->data.for_stmt.body = ast_stmt_make_block(&block);
+	return first;
+}
+
+static int statement_mentions(const AstStmt *stmt, const char *name)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (statement_mentions(stmt->data.block.statements.items[i], name))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) == 0 || ast_expr_references(stmt->data.decl.init, name) ||
+			   ast_expr_references(stmt->data.decl.array_init, name);
+	case STMT_ASSIGN:
+		return strcmp(stmt->data.assign.name, name) == 0 || ast_expr_references(stmt->data.assign.value, name);
+	case STMT_ARRAY_ASSIGN:
+		return strcmp(stmt->data.array_assign.name, name) == 0 ||
+			   ast_expr_references(stmt->data.array_assign.index, name) ||
+			   ast_expr_references(stmt->data.array_assign.value, name);
+	case STMT_WHILE:
+		return ast_expr_references(stmt->data.while_stmt.condition, name) ||
+			   statement_mentions(stmt->data.while_stmt.body, name);
+	case STMT_FOR:
+		return statement_mentions(stmt->data.for_stmt.init, name) ||
+			   ast_expr_references(stmt->data.for_stmt.condition, name) ||
+			   statement_mentions(stmt->data.for_stmt.post, name) || statement_mentions(stmt->data.for_stmt.body, name);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return ast_expr_references(stmt->data.expr, name);
+	}
+	return 0;
+}
+
+/* Calls may print, and a return would skip the other body's remaining iterations. */
+static int statement_is_fusible(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return 1;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (!statement_is_fusible(stmt->data.block.statements.items[i]))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case STMT_DECL:
+		return !ast_expr_contains_call(stmt->data.decl.init) && !ast_expr_contains_call(stmt->data.decl.array_init);
+	case STMT_ASSIGN:
+		return !ast_expr_contains_call(stmt->data.assign.value);
+	case STMT_ARRAY_ASSIGN:
+		return !ast_expr_contains_call(stmt->data.array_assign.index) &&
+			   !ast_expr_contains_call(stmt->data.array_assign.value);
+	case STMT_WHILE:
+		return !ast_expr_contains_call(stmt->data.while_stmt.condition) &&
+			   statement_is_fusible(stmt->data.while_stmt.body);
+	case STMT_FOR:
+		return statement_is_fusible(stmt->data.for_stmt.init) &&
+			   !ast_expr_contains_call(stmt->data.for_stmt.condition) &&
+			   statement_is_fusible(stmt->data.for_stmt.post) && statement_is_fusible(stmt->data.for_stmt.body);
+	case STMT_EXPR:
+		return !ast_expr_contains_call(stmt->data.expr);
+	case STMT_RETURN:
+		return 0;
+	}
+	return 0;
+}
+
+static int accessed_only_at(const AstStmt *stmt, const char *array, const char *index)
+{
+	if (!stmt)
+	{
+		return 1;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (!accessed_only_at(stmt->data.block.statements.items[i], array, index))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, array) != 0 &&
+			   expression_accessed_only_at(stmt->data.decl.init, array, index) &&
+			   expression_accessed_only_at(stmt->data.decl.array_init, array, index);
+	case STMT_ASSIGN:
+		return strcmp(stmt->data.assign.name, array) != 0 &&
+			   expression_accessed_only_at(stmt->data.assign.value, array, index);
+	case STMT_ARRAY_ASSIGN:
+		if (strcmp(stmt->data.array_assign.name, array) == 0 && !is_identifier(stmt->data.array_assign.index, index))
+		{
+			return 0;
+		}
+		return expression_accessed_only_at(stmt->data.array_assign.index, array, index) &&
+			   expression_accessed_only_at(stmt->data.array_assign.value, array, index);
+	case STMT_WHILE:
+		return expression_accessed_only_at(stmt->data.while_stmt.condition, array, index) &&
+			   accessed_only_at(stmt->data.while_stmt.body, array, index);
+	case STMT_FOR:
+		return accessed_only_at(stmt->data.for_stmt.init, array, index) &&
+			   expression_accessed_only_at(stmt->data.for_stmt.condition, array, index) &&
+			   accessed_only_at(stmt->data.for_stmt.post, array, index) &&
+			   accessed_only_at(stmt->data.for_stmt.body, array, index);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return expression_accessed_only_at(stmt->data.expr, array, index);
+	}
+	return 0;
+}
+
+static int expression_accessed_only_at(const AstExpr *expr, const char *array, const char *index)
+{
+	if (!expr)
+	{
+		return 1;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		return strcmp(expr->data.identifier, array) != 0;
+	case EXPR_BINARY:
+		return expression_accessed_only_at(expr->data.binary.left, array, index) &&
+			   expression_accessed_only_at(expr->data.binary.right, array, index);
+	case EXPR_UNARY:
+		return expression_accessed_only_at(expr->data.unary.operand, array, index);
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			if (!expression_accessed_only_at(expr->data.call.args.items[i], array, index))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (!expression_accessed_only_at(expr->data.array_literal.elements.items[i], array, index))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_SUBSCRIPT:
+		if (is_identifier(expr->data.subscript.array, array))
+		{
+			return is_identifier(expr->data.subscript.index, index);
+		}
+		return expression_accessed_only_at(expr->data.subscript.array, array, index) &&
+			   expression_accessed_only_at(expr->data.subscript.index, array, index);
+	default:
+		return 1;
+	}
+}
+
+static void hoist_loop_invariants(OptimizerContext *ctx, AstStmt **slot)
+{
+	AstStmt *stmt = *slot;
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			hoist_loop_invariants(ctx, &stmt->data.block.statements.items[i]);
+		}
+		break;
+	case STMT_WHILE:
+	case STMT_FOR:
+	{
+		AstStmt **body_slot = stmt->kind == STMT_WHILE ? &stmt->data.while_stmt.body : &stmt->data.for_stmt.body;
+		/* A body that always returns runs at most once, so there is nothing to
+		 * gain from hoisting out of it. */
+		if (statement_returns(*body_slot))
+		{
+			hoist_loop_invariants(ctx, body_slot);
+			break;
+		}
+		NameSet assigned = {0};
+		AstStmtList hoisted = ast_stmt_list_make();
+		collect_assigned_names(stmt, &assigned);
+		AstExpr **condition = stmt->kind == STMT_WHILE ? &stmt->data.while_stmt.condition : &stmt->data.for_stmt.condition;
+		/* An invariant condition as a whole is evaluated as often before the
+		 * loop as in it. */
+		if (!*condition || !expr_is_hoistable(ctx, *condition, &assigned))
+		{
+			hoist_from_expression(ctx, condition, &assigned, &hoisted);
+		}
+		if (stmt->kind == STMT_FOR)
+		{
+			hoist_from_statement(ctx, stmt->data.for_stmt.post, &assigned, &hoisted);
+		}
+		hoist_from_statement(ctx, *body_slot, &assigned, &hoisted);
+		name_set_free(&assigned);
+
+		hoist_loop_invariants(ctx, body_slot);
+
+		*slot = wrap_with_prelude(stmt, &hoisted);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+static void hoist_from_statement(OptimizerContext *ctx, AstStmt *stmt, const NameSet *assigned, AstStmtList *hoisted)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			hoist_from_statement(ctx, stmt->data.block.statements.items[i], assigned, hoisted);
+		}
+		break;
+	case STMT_DECL:
+		hoist_from_expression(ctx, &stmt->data.decl.init, assigned, hoisted);
+		hoist_from_expression(ctx, &stmt->data.decl.array_init, assigned, hoisted);
+		break;
+	case STMT_ASSIGN:
+		hoist_from_expression(ctx, &stmt->data.assign.value, assigned, hoisted);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		hoist_from_expression(ctx, &stmt->data.array_assign.index, assigned, hoisted);
+		hoist_from_expression(ctx, &stmt->data.array_assign.value, assigned, hoisted);
+		break;
+	case STMT_WHILE:
+		hoist_from_expression(ctx, &stmt->data.while_stmt.condition, assigned, hoisted);
+		if (!statement_returns(stmt->data.while_stmt.body))
+		{
+			hoist_from_statement(ctx, stmt->data.while_stmt.body, assigned, hoisted);
+		}
+		break;
+	case STMT_FOR:
+		hoist_from_statement(ctx, stmt->data.for_stmt.init, assigned, hoisted);
+		hoist_from_expression(ctx, &stmt->data.for_stmt.condition, assigned, hoisted);
+		if (!statement_returns(stmt->data.for_stmt.body))
+		{
+			hoist_from_statement(ctx, stmt->data.for_stmt.post, assigned, hoisted);
+			hoist_from_statement(ctx, stmt->data.for_stmt.body, assigned, hoisted);
+		}
+		break;
+	case STMT_EXPR:
+		hoist_from_expression(ctx, &stmt->data.expr, assigned, hoisted);
+		break;
+	case STMT_RETURN:
+		/* A return runs once per call; hoisting would only add work. */
+		break;
+	}
+}
+
+static void hoist_from_expression(OptimizerContext *ctx, AstExpr **slot, const NameSet *assigned, AstStmtList *hoisted)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	if (expr_is_hoistable(ctx, expr, assigned))
+	{
+		TypeKind type = expr->type;
+		const char *name = NULL;
+		for (size_t i = 0; i < hoisted->count; ++i)
+		{
+			AstStmt *decl = hoisted->items[i];
+			if (ast_expr_equal(decl->data.decl.init, expr))
+			{
+				name = decl->data.decl.name;
+				break;
+			}
+		}
+		if (name)
+		{
+			ast_expr_destroy(expr);
+		}
+		else
+		{
+			AstStmt *decl = ast_stmt_make_decl(type, make_temp_name(ctx, "__licm"), expr);
+			ast_stmt_list_push(hoisted, decl);
+			name = decl->data.decl.name;
+		}
+		*slot = make_identifier(name, type);
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		hoist_from_expression(ctx, &expr->data.binary.left, assigned, hoisted);
+		hoist_from_expression(ctx, &expr->data.binary.right, assigned, hoisted);
+		break;
+	case EXPR_UNARY:
+		hoist_from_expression(ctx, &expr->data.unary.operand, assigned, hoisted);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			hoist_from_expression(ctx, &expr->data.call.args.items[i], assigned, hoisted);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			hoist_from_expression(ctx, &expr->data.array_literal.elements.items[i], assigned, hoisted);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		hoist_from_expression(ctx, &expr->data.subscript.index, assigned, hoisted);
+		break;
+	default:
+		break;
+	}
+}
+
+static int expr_is_hoistable(const OptimizerContext *ctx, const AstExpr *expr, const NameSet *assigned)
+{
+	if (expr->kind != EXPR_BINARY && !(expr->kind == EXPR_UNARY && expr->data.unary.op != UN_OP_POS))
+	{
+		return 0;
+	}
+	if (expr->type == TYPE_UNKNOWN || expr->type == TYPE_VOID || expr->type == TYPE_ARRAY)
+	{
+		return 0;
+	}
+	return expr_is_invariant(ctx, expr, assigned) && !expr_is_constant(expr);
+}
+
+/* Hoisted code runs even when the loop body would not, so only expressions that can never raise a Lua error qualify.
+ * That rules out locals that may still be nil. */
+static int expr_is_invariant(const OptimizerContext *ctx, const AstExpr *expr, const NameSet *assigned)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+	case EXPR_STRING_LITERAL:
+		return 1;
+	case EXPR_IDENTIFIER:
+		return expr->type != TYPE_ARRAY && !name_set_contains(assigned, expr->data.identifier) &&
+			   !name_set_contains(&ctx->uninitialized, expr->data.identifier);
+	case EXPR_BINARY:
+		/* Under c32, int division traps on zero just like %. */
+		if (expr->data.binary.op == BIN_OP_MOD ||
+			(expr->data.binary.op == BIN_OP_DIV && expr->type == TYPE_INT && ctx->options->int_semantics == INT_SEMANTICS_C32))
+		{
+			const AstExpr *divisor = expr->data.binary.right;
+			int nonzero = (divisor->kind == EXPR_INT_LITERAL && divisor->data.int_value != 0) ||
+						  (divisor->kind == EXPR_FLOAT_LITERAL && divisor->data.float_value != 0.0);
+			if (!nonzero)
+			{
+				return 0;
+			}
+		}
+		return expr_is_invariant(ctx, expr->data.binary.left, assigned) &&
+			   expr_is_invariant(ctx, expr->data.binary.right, assigned);
+	case EXPR_UNARY:
+		return expr_is_invariant(ctx, expr->data.unary.operand, assigned);
+	case EXPR_CALL:
+	case EXPR_ARRAY_LITERAL:
+	case EXPR_SUBSCRIPT:
+		return 0;
+	}
+	return 0;
+}
+
+static void collect_uninitialized_names(const AstStmt *stmt, NameSet *set)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			collect_uninitialized_names(stmt->data.block.statements.items[i], set);
+		}
+		break;
+	case STMT_DECL:
+		if (!stmt->data.decl.is_array && !stmt->data.decl.init)
+		{
+			name_set_add(set, stmt->data.decl.name);
+		}
+		break;
+	case STMT_WHILE:
+		collect_uninitialized_names(stmt->data.while_stmt.body, set);
+		break;
+	case STMT_FOR:
+		collect_uninitialized_names(stmt->data.for_stmt.init, set);
+		collect_uninitialized_names(stmt->data.for_stmt.body, set);
+		break;
+	default:
+		break;
+	}
+}
+
+/* Lua arrays start at 1, so every a[i] costs an extra ADD. For canonical
+ * for-loops, scaled uses c * i in subscripts get their own incrementally
+ * updated variable, and when subscripts dominate the uses of i the loop is
+ * rebased so i holds the 1-based value and the shift folds away in codegen. */
+static void rewrite_induction_variables(OptimizerContext *ctx, AstStmt **slot)
+{
+	AstStmt *stmt = *slot;
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			rewrite_induction_variables(ctx, &stmt->data.block.statements.items[i]);
+		}
+		break;
+	case STMT_WHILE:
+		rewrite_induction_variables(ctx, &stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+	{
+		InductionVariable iv;
+		if (!match_induction_variable(stmt, &iv))
+		{
+			rewrite_induction_variables(ctx, &stmt->data.for_stmt.body);
+			break;
+		}
+
+		AstStmtList prelude = ast_stmt_list_make();
+		if (iv.start->type == TYPE_INT && !ast_expr_contains_call(iv.start))
+		{
+			DerivedInductionList derived = {0};
+			derive_in_statement(ctx, stmt->data.for_stmt.body, &iv, &derived);
+			if (derived.count > 0)
+			{
+				AstStmtList updates = ast_stmt_list_make();
+				for (size_t i = 0; i < derived.count; ++i)
+				{
+					const DerivedInduction *d = &derived.items[i];
+					/* The variable holds the 1-based index of the most common
+					 * access, so that one needs no add at all. */
+					long long shift = common_offset(d) + 1;
+					AstExpr *init = iv.start->kind == EXPR_INT_LITERAL
+										? make_int(d->factor * iv.start->data.int_value + shift)
+										: add_constant(make_binary(BIN_OP_MUL, make_int(d->factor), ast_expr_clone(iv.start), TYPE_INT), shift);
+					ast_stmt_list_push(&prelude, ast_stmt_make_decl(TYPE_INT, dup_string(d->name), init));
+					AstExpr *rebased = make_binary(BIN_OP_SUB, make_identifier(d->name, TYPE_INT), make_int(shift), TYPE_INT);
+					substitute_in_statement(stmt->data.for_stmt.body, d->name, rebased);
+					ast_expr_destroy(rebased);
+					long long increment = d->factor * iv.step;
+					AstStmt *update = ast_stmt_make_assign(dup_string(d->name),
+														  make_binary(increment < 0 ? BIN_OP_SUB : BIN_OP_ADD,
+																	  make_identifier(d->name, TYPE_INT),
+																	  make_int(increment < 0 ? -increment : increment),
+																	  TYPE_INT));
+					update->data.assign.type = TYPE_INT;
+					ast_stmt_list_push(&updates, update);
+					free(d->name);
+				}
+				free(derived.items);
+				fold_statement(ctx, stmt->data.for_stmt.body);
+
+				AstStmt *body = stmt->data.for_stmt.body;
+				if (!body || body->kind != STMT_BLOCK)
+				{
+					AstStmtList list = ast_stmt_list_make();
+					if (body)
+					{
+						ast_stmt_list_push(&list, body);
+					}
+					AstBlock block = ast_block_from_list(&list);
+					body = ast_stmt_make_block(&block);
+					stmt->data.for_stmt.body = body;
+				}
+				for (size_t i = 0; i < updates.count; ++i)
+				{
+					ast_stmt_list_push(&body->data.block.statements, updates.items[i]);
+				}
+				free(updates.items);
+			}
+		}
+
+		InductionUsage usage = {0};
+		AstExpr **bound_slot = NULL;
+		scan_usage_in_statement(stmt->data.for_stmt.body, iv.name, &usage);
+		int direct = match_direct_comparison(stmt->data.for_stmt.condition, iv.name, &bound_slot);
+		if (!direct)
+		{
+			scan_usage_in_expression(stmt->data.for_stmt.condition, iv.name, &usage);
+		}
+		if (usage.index_uses > usage.other_uses)
+		{
+			AstStmt *init = stmt->data.for_stmt.init;
+			init->data.decl.init = add_constant(init->data.decl.init, 1);
+			AstExpr *shifted = make_binary(BIN_OP_SUB, make_identifier(iv.name, TYPE_INT), make_int(1), TYPE_INT);
+			if (direct)
+			{
+				*bound_slot = add_constant(*bound_slot, 1);
+			}
+			else
+			{
+				substitute_in_expression(&stmt->data.for_stmt.condition, iv.name, shifted);
+				fold_expression(ctx, &stmt->data.for_stmt.condition);
+			}
+			substitute_in_statement(stmt->data.for_stmt.body, iv.name, shifted);
+			fold_statement(ctx, stmt->data.for_stmt.body);
+			ast_expr_destroy(shifted);
+		}
+
+		rewrite_induction_variables(ctx, &stmt->data.for_stmt.body);
+		*slot = wrap_with_prelude(stmt, &prelude);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+static int match_induction_variable(const AstStmt *loop, InductionVariable *iv)
+{
+	const AstStmt *init = loop->data.for_stmt.init;
+	const AstStmt *post = loop->data.for_stmt.post;
+	if (!init || init->kind != STMT_DECL || init->data.decl.is_array || init->data.decl.type != TYPE_INT || !init->data.decl.init)
+	{
+		return 0;
+	}
+	const char *name = init->data.decl.name;
+	if (!post || post->kind != STMT_ASSIGN || strcmp(post->data.assign.name, name) != 0)
+	{
+		return 0;
+	}
+	long long step = 0;
+	if (!match_induction_step(post->data.assign.value, name, &step))
+	{
+		return 0;
+	}
+	NameSet assigned = {0};
+	collect_assigned_names(loop->data.for_stmt.body, &assigned);
+	int modified = name_set_contains(&assigned, name);
+	name_set_free(&assigned);
+	if (modified)
+	{
+		return 0;
+	}
+	iv->name = name;
+	iv->start = init->data.decl.init;
+	iv->step = step;
+	return 1;
+}
+
+static int match_induction_step(const AstExpr *value, const char *name, long long *step)
+{
+	if (!value || value->kind != EXPR_BINARY || value->type != TYPE_INT)
+	{
+		return 0;
+	}
+	const AstExpr *left = value->data.binary.left;
+	const AstExpr *right = value->data.binary.right;
+	if (value->data.binary.op == BIN_OP_ADD)
+	{
+		if (is_identifier(left, name) && right->kind == EXPR_INT_LITERAL)
+		{
+			*step = right->data.int_value;
+		}
+		else if (left->kind == EXPR_INT_LITERAL && is_identifier(right, name))
+		{
+			*step = left->data.int_value;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+	else if (value->data.binary.op == BIN_OP_SUB && is_identifier(left, name) && right->kind == EXPR_INT_LITERAL)
+	{
+		*step = -right->data.int_value;
+	}
+	else
+	{
+		return 0;
+	}
+	return *step != 0;
+}
+
+static void derive_in_statement(OptimizerContext *ctx, AstStmt *stmt, const InductionVariable *iv, DerivedInductionList *derived)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			derive_in_statement(ctx, stmt->data.block.statements.items[i], iv, derived);
+		}
+		break;
+	case STMT_DECL:
+		derive_in_expression(ctx, stmt->data.decl.init, iv, derived);
+		derive_in_expression(ctx, stmt->data.decl.array_init, iv, derived);
+		break;
+	case STMT_ASSIGN:
+		derive_in_expression(ctx, stmt->data.assign.value, iv, derived);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		derive_in_index(ctx, &stmt->data.array_assign.index, iv, derived);
+		derive_in_expression(ctx, stmt->data.array_assign.value, iv, derived);
+		break;
+	case STMT_WHILE:
+		derive_in_expression(ctx, stmt->data.while_stmt.condition, iv, derived);
+		derive_in_statement(ctx, stmt->data.while_stmt.body, iv, derived);
+		break;
+	case STMT_FOR:
+		derive_in_statement(ctx, stmt->data.for_stmt.init, iv, derived);
+		derive_in_expression(ctx, stmt->data.for_stmt.condition, iv, derived);
+		derive_in_statement(ctx, stmt->data.for_stmt.post, iv, derived);
+		derive_in_statement(ctx, stmt->data.for_stmt.body, iv, derived);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		derive_in_expression(ctx, stmt->data.expr, iv, derived);
+		break;
+	}
+}
+
+static void derive_in_expression(OptimizerContext *ctx, AstExpr *expr, const InductionVariable *iv, DerivedInductionList *derived)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		derive_in_expression(ctx, expr->data.binary.left, iv, derived);
+		derive_in_expression(ctx, expr->data.binary.right, iv, derived);
+		break;
+	case EXPR_UNARY:
+		derive_in_expression(ctx, expr->data.unary.operand, iv, derived);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			derive_in_expression(ctx, expr->data.call.args.items[i], iv, derived);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			derive_in_expression(ctx, expr->data.array_literal.elements.items[i], iv, derived);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		derive_in_index(ctx, &expr->data.subscript.index, iv, derived);
+		break;
+	default:
+		break;
+	}
+}
+
+static void derive_in_index(OptimizerContext *ctx, AstExpr **slot, const InductionVariable *iv, DerivedInductionList *derived)
+{
+	derive_in_index_at(ctx, slot, iv, derived, index_offset(*slot));
+}
+
+/* offset is the literal part of the whole index the slot belongs to. */
+static void derive_in_index_at(OptimizerContext *ctx, AstExpr **slot, const InductionVariable *iv, DerivedInductionList *derived, long long offset)
+{
+	AstExpr *expr = *slot;
+	long long factor = 0;
+	if (is_index_additive(expr))
+	{
+		derive_in_index_at(ctx, &expr->data.binary.left, iv, derived, offset);
+		derive_in_index_at(ctx, &expr->data.binary.right, iv, derived, offset);
+		return;
+	}
+	if (!match_scaled_induction(expr, iv->name, &factor))
+	{
+		derive_in_expression(ctx, expr, iv, derived);
+		return;
+	}
+
+	DerivedInduction *d = NULL;
+	for (size_t i = 0; i < derived->count; ++i)
+	{
+		if (derived->items[i].factor == factor)
+		{
+			d = &derived->items[i];
+			break;
+		}
+	}
+	if (!d)
+	{
+		ensure_capacity((void **)&derived->items, sizeof(DerivedInduction), &derived->capacity, derived->count + 1);
+		d = &derived->items[derived->count++];
+		d->factor = factor;
+		d->name = make_temp_name(ctx, "__iv");
+		d->offset_count = 0;
+	}
+	size_t k = 0;
+	while (k < d->offset_count && d->offsets[k] != offset)
+	{
+		++k;
+	}
+	if (k < DERIVED_OFFSET_LIMIT)
+	{
+		if (k == d->offset_count)
+		{
+			d->offsets[k] = offset;
+			d->offset_uses[k] = 0;
+			d->offset_count++;
+		}
+		d->offset_uses[k]++;
+	}
+	ast_expr_destroy(expr);
+	*slot = make_identifier(d->name, TYPE_INT);
+}
+
+static long long index_offset(const AstExpr *expr)
+{
+	if (expr->kind == EXPR_INT_LITERAL)
+	{
+		return expr->data.int_value;
+	}
+	if (!is_index_additive(expr))
+	{
+		return 0;
+	}
+	long long right = index_offset(expr->data.binary.right);
+	return index_offset(expr->data.binary.left) + (expr->data.binary.op == BIN_OP_SUB ? -right : right);
+}
+
+static long long common_offset(const DerivedInduction *d)
+{
+	size_t best = 0;
+	for (size_t i = 1; i < d->offset_count; ++i)
+	{
+		if (d->offset_uses[i] > d->offset_uses[best])
+		{
+			best = i;
+		}
+	}
+	return d->offset_count > 0 ? d->offsets[best] : 0;
+}
+
+static int match_scaled_induction(const AstExpr *expr, const char *name, long long *factor)
+{
+	if (!expr || expr->kind != EXPR_BINARY || expr->type != TYPE_INT || expr->data.binary.op != BIN_OP_MUL)
+	{
+		return 0;
+	}
+	const AstExpr *left = expr->data.binary.left;
+	const AstExpr *right = expr->data.binary.right;
+	if (is_identifier(left, name) && right->kind == EXPR_INT_LITERAL)
+	{
+		*factor = right->data.int_value;
+	}
+	else if (left->kind == EXPR_INT_LITERAL && is_identifier(right, name))
+	{
+		*factor = left->data.int_value;
+	}
+	else
+	{
+		return 0;
+	}
+	return *factor != 0 && *factor != 1;
+}
+
+/* Local arrays of a few elements that are only ever indexed by integer
+ * literals become one local per element. Runs after unrolling, which is what
+ * turns most loop indices into literals. */
+static void scalarize_arrays(OptimizerContext *ctx, AstStmtList *list)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		switch (stmt->kind)
+		{
+		case STMT_BLOCK:
+			scalarize_arrays(ctx, &stmt->data.block.statements);
+			break;
+		case STMT_WHILE:
+			if (stmt->data.while_stmt.body && stmt->data.while_stmt.body->kind == STMT_BLOCK)
+			{
+				scalarize_arrays(ctx, &stmt->data.while_stmt.body->data.block.statements);
+			}
+			break;
+		case STMT_FOR:
+			if (stmt->data.for_stmt.body && stmt->data.for_stmt.body->kind == STMT_BLOCK)
+			{
+				scalarize_arrays(ctx, &stmt->data.for_stmt.body->data.block.statements);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *decl = list->items[i];
+		if (!array_is_scalarizable(decl, list, i + 1))
+		{
+			continue;
+		}
+		/* Elements get temporary names so they cannot collide with a
+		 * user local such as a__1. */
+		char prefix[48];
+		snprintf(prefix, sizeof(prefix), "__%.40s", decl->data.decl.name);
+		char *base = make_temp_name(ctx, prefix);
+		for (size_t j = i + 1; j < list->count; ++j)
+		{
+			scalarize_statement(&list->items[j], decl->data.decl.name, base);
+		}
+
+		AstStmtList rebuilt = ast_stmt_list_make();
+		for (size_t j = 0; j < i; ++j)
+		{
+			ast_stmt_list_push(&rebuilt, list->items[j]);
+		}
+		append_scalar_elements(&rebuilt, decl, base);
+		free(base);
+		size_t resume = rebuilt.count;
+		for (size_t j = i + 1; j < list->count; ++j)
+		{
+			ast_stmt_list_push(&rebuilt, list->items[j]);
+		}
+		ast_stmt_destroy(decl);
+		free(list->items);
+		*list = rebuilt;
+		i = resume - 1;
+	}
+}
+
+static int array_is_scalarizable(const AstStmt *decl, const AstStmtList *list, size_t start)
+{
+	if (decl->kind != STMT_DECL || !decl->data.decl.is_array || decl->data.decl.array_size == 0 ||
+		decl->data.decl.array_size > SCALARIZE_MAX_ELEMENTS)
+	{
+		return 0;
+	}
+	TypeKind type = decl->data.decl.type;
+	if (type != TYPE_INT && type != TYPE_FLOAT && type != TYPE_BOOL)
+	{
+		return 0;
+	}
+	const AstExpr *init = decl->data.decl.array_init;
+	if (init && (init->kind != EXPR_ARRAY_LITERAL || init->data.array_literal.elements.count > decl->data.decl.array_size))
+	{
+		return 0;
+	}
+	for (size_t i = start; i < list->count; ++i)
+	{
+		if (!constant_uses_in_statement(list->items[i], decl->data.decl.name, decl->data.decl.array_size))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Also rejects a redeclaration of the name, which would shadow the array. */
+static int constant_uses_in_statement(const AstStmt *stmt, const char *name, size_t size)
+{
+	if (!stmt)
+	{
+		return 1;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (!constant_uses_in_statement(stmt->data.block.statements.items[i], name, size))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) != 0 && constant_uses_in_expression(stmt->data.decl.init, name, size) &&
+			   constant_uses_in_expression(stmt->data.decl.array_init, name, size);
+	case STMT_ASSIGN:
+		return strcmp(stmt->data.assign.name, name) != 0 && constant_uses_in_expression(stmt->data.assign.value, name, size);
+	case STMT_ARRAY_ASSIGN:
+		if (strcmp(stmt->data.array_assign.name, name) == 0)
+		{
+			const AstExpr *index = stmt->data.array_assign.index;
+			if (index->kind != EXPR_INT_LITERAL || index->data.int_value < 0 || (size_t)index->data.int_value >= size)
+			{
+				return 0;
+			}
+		}
+		return constant_uses_in_expression(stmt->data.array_assign.index, name, size) &&
+			   constant_uses_in_expression(stmt->data.array_assign.value, name, size);
+	case STMT_WHILE:
+		return constant_uses_in_expression(stmt->data.while_stmt.condition, name, size) &&
+			   constant_uses_in_statement(stmt->data.while_stmt.body, name, size);
+	case STMT_FOR:
+		return constant_uses_in_statement(stmt->data.for_stmt.init, name, size) &&
+			   constant_uses_in_expression(stmt->data.for_stmt.condition, name, size) &&
+			   constant_uses_in_statement(stmt->data.for_stmt.post, name, size) &&
+			   constant_uses_in_statement(stmt->data.for_stmt.body, name, size);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return constant_uses_in_expression(stmt->data.expr, name, size);
+	}
+	return 0;
+}
+
+static int constant_uses_in_expression(const AstExpr *expr, const char *name, size_t size)
+{
+	if (!expr)
+	{
+		return 1;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		return strcmp(expr->data.identifier, name) != 0;
+	case EXPR_BINARY:
+		return constant_uses_in_expression(expr->data.binary.left, name, size) &&
+			   constant_uses_in_expression(expr->data.binary.right, name, size);
+	case EXPR_UNARY:
+		return constant_uses_in_expression(expr->data.unary.operand, name, size);
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			if (!constant_uses_in_expression(expr->data.call.args.items[i], name, size))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (!constant_uses_in_expression(expr->data.array_literal.elements.items[i], name, size))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_SUBSCRIPT:
+		if (is_identifier(expr->data.subscript.array, name))
+		{
+			const AstExpr *index = expr->data.subscript.index;
+			return index->kind == EXPR_INT_LITERAL && index->data.int_value >= 0 && (size_t)index->data.int_value < size;
+		}
+		return constant_uses_in_expression(expr->data.subscript.array, name, size) &&
+			   constant_uses_in_expression(expr->data.subscript.index, name, size);
+	default:
+		return 1;
+	}
+}
+
+static void append_scalar_elements(AstStmtList *list, AstStmt *decl, const char *base)
+{
+	TypeKind type = decl->data.decl.type;
+	AstExpr *init = decl->data.decl.array_init;
+	for (size_t i = 0; i < decl->data.decl.array_size; ++i)
+	{
+		AstExpr *value;
+		if (init && i < init->data.array_literal.elements.count)
+		{
+			value = init->data.array_literal.elements.items[i];
+			init->data.array_literal.elements.items[i] = NULL;
+		}
+		else if (type == TYPE_INT)
+		{
+			value = make_int(0);
+		}
+		else if (type == TYPE_FLOAT)
+		{
+			value = ast_expr_make_float(0.0);
+		}
+		else
+		{
+			value = make_bool(0);
+		}
+		ast_stmt_list_push(list, ast_stmt_make_decl(type, element_name(base, (long long)i), value));
+	}
+}
+
+static void scalarize_statement(AstStmt **slot, const char *name, const char *base)
+{
+	AstStmt *stmt = *slot;
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			scalarize_statement(&stmt->data.block.statements.items[i], name, base);
+		}
+		break;
+	case STMT_DECL:
+		scalarize_expression(&stmt->data.decl.init, name, base);
+		scalarize_expression(&stmt->data.decl.array_init, name, base);
+		break;
+	case STMT_ASSIGN:
+		scalarize_expression(&stmt->data.assign.value, name, base);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		scalarize_expression(&stmt->data.array_assign.value, name, base);
+		if (strcmp(stmt->data.array_assign.name, name) == 0)
+		{
+			AstStmt *assign = ast_stmt_make_assign(element_name(base, stmt->data.array_assign.index->data.int_value),
+												   stmt->data.array_assign.value);
+			assign->data.assign.type = stmt->data.array_assign.element_type;
+			stmt->data.array_assign.value = NULL;
+			ast_stmt_destroy(stmt);
+			*slot = assign;
+		}
+		break;
+	case STMT_WHILE:
+		scalarize_expression(&stmt->data.while_stmt.condition, name, base);
+		scalarize_statement(&stmt->data.while_stmt.body, name, base);
+		break;
+	case STMT_FOR:
+		scalarize_statement(&stmt->data.for_stmt.init, name, base);
+		scalarize_expression(&stmt->data.for_stmt.condition, name, base);
+		scalarize_statement(&stmt->data.for_stmt.post, name, base);
+		scalarize_statement(&stmt->data.for_stmt.body, name, base);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		scalarize_expression(&stmt->data.expr, name, base);
+		break;
+	}
+}
+
+static void scalarize_expression(AstExpr **slot, const char *name, const char *base)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		scalarize_expression(&expr->data.binary.left, name, base);
+		scalarize_expression(&expr->data.binary.right, name, base);
+		break;
+	case EXPR_UNARY:
+		scalarize_expression(&expr->data.unary.operand, name, base);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			scalarize_expression(&expr->data.call.args.items[i], name, base);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			scalarize_expression(&expr->data.array_literal.elements.items[i], name, base);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		if (is_identifier(expr->data.subscript.array, name))
+		{
+			char *element = element_name(base, expr->data.subscript.index->data.int_value);
+			AstExpr *replacement = make_identifier(element, expr->type);
+			free(element);
+			ast_expr_destroy(expr);
+			*slot = replacement;
+			break;
+		}
+		scalarize_expression(&expr->data.subscript.index, name, base);
+		break;
+	default:
+		break;
+	}
+}
+
+static char *element_name(const char *base, long long index)
+{
+	char buffer[256];
+	snprintf(buffer, sizeof(buffer), "%s_%lld", base, index);
+	return dup_string(buffer);
+}
+
+/* An array that a loop only touches at one invariant index lives in a local
+ * for the duration of the loop: loaded once before it and, if the loop writes
+ * it, stored back once after. Arrays never leave their function, so a return
+ * from inside the loop needs no store. */
+static void promote_array_elements(OptimizerContext *ctx, AstStmt **slot)
+{
+	AstStmt *stmt = *slot;
+	/* The load runs even when the loop does not, so under --bounds-check it
+	 * could trap on an index the loop never uses. */
+	if (!stmt || ctx->options->bounds_check)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			promote_array_elements(ctx, &stmt->data.block.statements.items[i]);
+		}
+		return;
+	case STMT_WHILE:
+		promote_array_elements(ctx, &stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+		promote_array_elements(ctx, &stmt->data.for_stmt.body);
+		break;
+	default:
+		return;
+	}
+
+	NameSet names = {0};
+	AstStmtList list = ast_stmt_list_make();
+	AstStmtList stores = ast_stmt_list_make();
+	collect_array_names(stmt, &names);
+	for (size_t i = 0; i < names.count; ++i)
+	{
+		const char *name = names.items[i];
+		ElementAccess access = {NULL, TYPE_UNKNOWN, 0, 1};
+		scan_element_in_statement(stmt, name, &access);
+		if (!access.valid || !access.index || ast_expr_contains_call(access.index) ||
+			!ast_expr_invariant_in(access.index, stmt))
+		{
+			continue;
+		}
+
+		AstExpr *index = ast_expr_clone(access.index);
+		char *local = make_temp_name(ctx, "__elem");
+		promote_in_statement(&stmt, name, local);
+
+		AstExpr *load = ast_expr_make_subscript(make_identifier(name, TYPE_ARRAY), ast_expr_clone(index));
+		load->type = access.type;
+		ast_stmt_list_push(&list, ast_stmt_make_decl(access.type, dup_string(local), load));
+		if (access.written)
+		{
+			AstStmt *store = ast_stmt_make_array_assign(dup_string(name), index, make_identifier(local, access.type));
+			store->data.array_assign.element_type = access.type;
+			ast_stmt_list_push(&stores, store);
+		}
+		else
+		{
+			ast_expr_destroy(index);
+		}
+		free(local);
+	}
+	name_set_free(&names);
+
+	if (list.count == 0)
+	{
+		free(list.items);
+		return;
+	}
+	ast_stmt_list_push(&list, stmt);
+	for (size_t i = 0; i < stores.count; ++i)
+	{
+		ast_stmt_list_push(&list, stores.items[i]);
+	}
+	free(stores.items);
+	AstBlock block = ast_block_from_list(&list);
+	*slot = ast_stmt_make_block(&block);
+}
+
+static void collect_array_names(const AstStmt *stmt, NameSet *names)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			collect_array_names(stmt->data.block.statements.items[i], names);
+		}
+		break;
+	case STMT_DECL:
+		collect_array_names_in_expression(stmt->data.decl.init, names);
+		collect_array_names_in_expression(stmt->data.decl.array_init, names);
+		break;
+	case STMT_ASSIGN:
+		collect_array_names_in_expression(stmt->data.assign.value, names);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		name_set_add(names, stmt->data.array_assign.name);
+		collect_array_names_in_expression(stmt->data.array_assign.index, names);
+		collect_array_names_in_expression(stmt->data.array_assign.value, names);
+		break;
+	case STMT_WHILE:
+		collect_array_names_in_expression(stmt->data.while_stmt.condition, names);
+		collect_array_names(stmt->data.while_stmt.body, names);
+		break;
+	case STMT_FOR:
+		collect_array_names(stmt->data.for_stmt.init, names);
+		collect_array_names_in_expression(stmt->data.for_stmt.condition, names);
+		collect_array_names(stmt->data.for_stmt.post, names);
+		collect_array_names(stmt->data.for_stmt.body, names);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		collect_array_names_in_expression(stmt->data.expr, names);
+		break;
+	}
+}
+
+static void collect_array_names_in_expression(const AstExpr *expr, NameSet *names)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		collect_array_names_in_expression(expr->data.binary.left, names);
+		collect_array_names_in_expression(expr->data.binary.right, names);
+		break;
+	case EXPR_UNARY:
+		collect_array_names_in_expression(expr->data.unary.operand, names);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			collect_array_names_in_expression(expr->data.call.args.items[i], names);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			collect_array_names_in_expression(expr->data.array_literal.elements.items[i], names);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		if (expr->data.subscript.array && expr->data.subscript.array->kind == EXPR_IDENTIFIER)
+		{
+			name_set_add(names, expr->data.subscript.array->data.identifier);
+		}
+		collect_array_names_in_expression(expr->data.subscript.index, names);
+		break;
+	default:
+		break;
+	}
+}
+
+static void scan_element_in_statement(const AstStmt *stmt, const char *name, ElementAccess *access)
+{
+	if (!stmt || !access->valid)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			scan_element_in_statement(stmt->data.block.statements.items[i], name, access);
+		}
+		break;
+	case STMT_DECL:
+		if (strcmp(stmt->data.decl.name, name) == 0)
+		{
+			access->valid = 0;
+		}
+		scan_element_in_expression(stmt->data.decl.init, name, access);
+		scan_element_in_expression(stmt->data.decl.array_init, name, access);
+		break;
+	case STMT_ASSIGN:
+		if (strcmp(stmt->data.assign.name, name) == 0)
+		{
+			access->valid = 0;
+		}
+		scan_element_in_expression(stmt->data.assign.value, name, access);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		scan_element_in_expression(stmt->data.array_assign.index, name, access);
+		scan_element_in_expression(stmt->data.array_assign.value, name, access);
+		if (strcmp(stmt->data.array_assign.name, name) == 0)
+		{
+			record_element_index(access, stmt->data.array_assign.index, stmt->data.array_assign.element_type);
+			access->written = 1;
+		}
+		break;
+	case STMT_WHILE:
+		scan_element_in_expression(stmt->data.while_stmt.condition, name, access);
+		scan_element_in_statement(stmt->data.while_stmt.body, name, access);
+		break;
+	case STMT_FOR:
+		scan_element_in_statement(stmt->data.for_stmt.init, name, access);
+		scan_element_in_expression(stmt->data.for_stmt.condition, name, access);
+		scan_element_in_statement(stmt->data.for_stmt.post, name, access);
+		scan_element_in_statement(stmt->data.for_stmt.body, name, access);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		scan_element_in_expression(stmt->data.expr, name, access);
+		break;
+	}
+}
+
+static void scan_element_in_expression(const AstExpr *expr, const char *name, ElementAccess *access)
+{
+	if (!expr || !access->valid)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		if (strcmp(expr->data.identifier, name) == 0)
+		{
+			access->valid = 0;
+		}
+		break;
+	case EXPR_BINARY:
+		scan_element_in_expression(expr->data.binary.left, name, access);
+		scan_element_in_expression(expr->data.binary.right, name, access);
+		break;
+	case EXPR_UNARY:
+		scan_element_in_expression(expr->data.unary.operand, name, access);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			scan_element_in_expression(expr->data.call.args.items[i], name, access);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			scan_element_in_expression(expr->data.array_literal.elements.items[i], name, access);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		scan_element_in_expression(expr->data.subscript.index, name, access);
+		if (is_identifier(expr->data.subscript.array, name))
+		{
+			record_element_index(access, expr->data.subscript.index, expr->type);
+		}
+		else
+		{
+			scan_element_in_expression(expr->data.subscript.array, name, access);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void record_element_index(ElementAccess *access, const AstExpr *index, TypeKind type)
+{
+	if (!access->index)
+	{
+		access->index = index;
+		access->type = type;
+		return;
+	}
+	if (!ast_expr_equal(access->index, index))
+	{
+		access->valid = 0;
+	}
+}
+
+static void promote_in_statement(AstStmt **slot, const char *name, const char *local)
+{
+	AstStmt *stmt = *slot;
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			promote_in_statement(&stmt->data.block.statements.items[i], name, local);
+		}
+		break;
+	case STMT_DECL:
+		promote_in_expression(&stmt->data.decl.init, name, local);
+		promote_in_expression(&stmt->data.decl.array_init, name, local);
+		break;
+	case STMT_ASSIGN:
+		promote_in_expression(&stmt->data.assign.value, name, local);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		promote_in_expression(&stmt->data.array_assign.index, name, local);
+		promote_in_expression(&stmt->data.array_assign.value, name, local);
+		if (strcmp(stmt->data.array_assign.name, name) == 0)
+		{
+			AstStmt *assign = ast_stmt_make_assign(dup_string(local), stmt->data.array_assign.value);
+			assign->data.assign.type = stmt->data.array_assign.element_type;
+			stmt->data.array_assign.value = NULL;
+			ast_stmt_destroy(stmt);
+			*slot = assign;
+		}
+		break;
+	case STMT_WHILE:
+		promote_in_expression(&stmt->data.while_stmt.condition, name, local);
+		promote_in_statement(&stmt->data.while_stmt.body, name, local);
+		break;
+	case STMT_FOR:
+		promote_in_statement(&stmt->data.for_stmt.init, name, local);
+		promote_in_expression(&stmt->data.for_stmt.condition, name, local);
+		promote_in_statement(&stmt->data.for_stmt.post, name, local);
+		promote_in_statement(&stmt->data.for_stmt.body, name, local);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		promote_in_expression(&stmt->data.expr, name, local);
+		break;
+	}
+}
+
+static void promote_in_expression(AstExpr **slot, const char *name, const char *local)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		promote_in_expression(&expr->data.binary.left, name, local);
+		promote_in_expression(&expr->data.binary.right, name, local);
+		break;
+	case EXPR_UNARY:
+		promote_in_expression(&expr->data.unary.operand, name, local);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			promote_in_expression(&expr->data.call.args.items[i], name, local);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			promote_in_expression(&expr->data.array_literal.elements.items[i], name, local);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		if (is_identifier(expr->data.subscript.array, name))
+		{
+			AstExpr *replacement = make_identifier(local, expr->type);
+			ast_expr_destroy(expr);
+			*slot = replacement;
+			break;
+		}
+		promote_in_expression(&expr->data.subscript.index, name, local);
+		break;
+	default:
+		break;
+	}
+}
+
+/* Bottom-up so that an unrolled inner loop counts towards the size of its parent. */
+/* An int local that only ever holds 0, 1 or a comparison and is only read as
+ * a truth value is kept as a Lua boolean, so conditions use it directly
+ * instead of comparing against 0 and stores skip the `and 1 or 0` round trip. */
+static void narrow_condition_flags(AstFunction *fn)
+{
+	NameSet declared = {0};
+	NameSet repeated = {0};
+	for (size_t i = 0; i < fn->params.count; ++i)
+	{
+		name_set_add(&repeated, fn->params.items[i].name);
+	}
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		collect_int_locals(fn->body.statements.items[i], &declared, &repeated);
+	}
+
+	for (size_t i = 0; i < declared.count; ++i)
+	{
+		const char *name = declared.items[i];
+		if (name_set_contains(&repeated, name))
+		{
+			continue;
+		}
+		int narrowable = 1;
+		size_t reads = 0;
+		for (size_t j = 0; j < fn->body.statements.count && narrowable; ++j)
+		{
+			narrowable = flag_uses_in_statement(fn->body.statements.items[j], name, &reads);
+		}
+		if (!narrowable || reads == 0)
+		{
+			continue;
+		}
+		for (size_t j = 0; j < fn->body.statements.count; ++j)
+		{
+			retype_flag_in_statement(fn->body.statements.items[j], name);
+		}
+	}
+
+	name_set_free(&declared);
+	name_set_free(&repeated);
+}
+
+static void collect_int_locals(const AstStmt *stmt, NameSet *declared, NameSet *repeated)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			collect_int_locals(stmt->data.block.statements.items[i], declared, repeated);
+		}
+		break;
+	case STMT_DECL:
+		if (name_set_contains(declared, stmt->data.decl.name) || stmt->data.decl.is_array ||
+			stmt->data.decl.type != TYPE_INT)
+		{
+			name_set_add(repeated, stmt->data.decl.name);
+		}
+		name_set_add(declared, stmt->data.decl.name);
+		break;
+	case STMT_WHILE:
+		collect_int_locals(stmt->data.while_stmt.body, declared, repeated);
+		break;
+	case STMT_FOR:
+		collect_int_locals(stmt->data.for_stmt.init, declared, repeated);
+		collect_int_locals(stmt->data.for_stmt.post, declared, repeated);
+		collect_int_locals(stmt->data.for_stmt.body, declared, repeated);
+		break;
+	default:
+		break;
+	}
+}
+
+static int flag_uses_in_statement(const AstStmt *stmt, const char *name, size_t *reads)
+{
+	if (!stmt)
+	{
+		return 1;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (!flag_uses_in_statement(stmt->data.block.statements.items[i], name, reads))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case STMT_DECL:
+		if (strcmp(stmt->data.decl.name, name) == 0 && stmt->data.decl.init && !is_flag_value(stmt->data.decl.init))
+		{
+			return 0;
+		}
+		return flag_uses_in_expression(stmt->data.decl.init, name, 0, reads) &&
+			   flag_uses_in_expression(stmt->data.decl.array_init, name, 0, reads);
+	case STMT_ASSIGN:
+		if (strcmp(stmt->data.assign.name, name) == 0 && !is_flag_value(stmt->data.assign.value))
+		{
+			return 0;
+		}
+		return flag_uses_in_expression(stmt->data.assign.value, name, 0, reads);
+	case STMT_ARRAY_ASSIGN:
+		return flag_uses_in_expression(stmt->data.array_assign.index, name, 0, reads) &&
+			   flag_uses_in_expression(stmt->data.array_assign.value, name, 0, reads);
+	case STMT_WHILE:
+		return flag_uses_in_expression(stmt->data.while_stmt.condition, name, 1, reads) &&
+			   flag_uses_in_statement(stmt->data.while_stmt.body, name, reads);
+	case STMT_FOR:
+		return flag_uses_in_statement(stmt->data.for_stmt.init, name, reads) &&
+			   flag_uses_in_expression(stmt->data.for_stmt.condition, name, 1, reads) &&
+			   flag_uses_in_statement(stmt->data.for_stmt.post, name, reads) &&
+			   flag_uses_in_statement(stmt->data.for_stmt.body, name, reads);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return flag_uses_in_expression(stmt->data.expr, name, 0, reads);
+	}
+	return 0;
+}
+
+static int flag_uses_in_expression(const AstExpr *expr, const char *name, int in_condition, size_t *reads)
+{
+	if (!expr)
+	{
+		return 1;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		if (strcmp(expr->data.identifier, name) != 0)
+		{
+			return 1;
+		}
+		*reads += 1;
+		return in_condition;
+	case EXPR_BINARY:
+	{
+		int logical = expr->data.binary.op == BIN_OP_AND || expr->data.binary.op == BIN_OP_OR;
+		return flag_uses_in_expression(expr->data.binary.left, name, logical, reads) &&
+			   flag_uses_in_expression(expr->data.binary.right, name, logical, reads);
+	}
+	case EXPR_UNARY:
+		return flag_uses_in_expression(expr->data.unary.operand, name, expr->data.unary.op == UN_OP_NOT, reads);
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			if (!flag_uses_in_expression(expr->data.call.args.items[i], name, 0, reads))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (!flag_uses_in_expression(expr->data.array_literal.elements.items[i], name, 0, reads))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_SUBSCRIPT:
+		return flag_uses_in_expression(expr->data.subscript.array, name, 0, reads) &&
+			   flag_uses_in_expression(expr->data.subscript.index, name, 0, reads);
+	default:
+		return 1;
+	}
+}
+
+static int is_flag_value(const AstExpr *expr)
+{
+	if (expr->kind == EXPR_INT_LITERAL)
+	{
+		return expr->data.int_value == 0 || expr->data.int_value == 1;
+	}
+	return expr->type == TYPE_BOOL;
+}
+
+static void retype_flag_in_statement(AstStmt *stmt, const char *name)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			retype_flag_in_statement(stmt->data.block.statements.items[i], name);
+		}
+		break;
+	case STMT_DECL:
+		if (strcmp(stmt->data.decl.name, name) == 0)
+		{
+			stmt->data.decl.type = TYPE_BOOL;
+		}
+		retype_flag_in_expression(stmt->data.decl.init, name);
+		break;
+	case STMT_ASSIGN:
+		if (strcmp(stmt->data.assign.name, name) == 0)
+		{
+			stmt->data.assign.type = TYPE_BOOL;
+		}
+		retype_flag_in_expression(stmt->data.assign.value, name);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		retype_flag_in_expression(stmt->data.array_assign.index, name);
+		retype_flag_in_expression(stmt->data.array_assign.value, name);
+		break;
+	case STMT_WHILE:
+		retype_flag_in_expression(stmt->data.while_stmt.condition, name);
+		retype_flag_in_statement(stmt->data.while_stmt.body, name);
+		break;
+	case STMT_FOR:
+		retype_flag_in_statement(stmt->data.for_stmt.init, name);
+		retype_flag_in_expression(stmt->data.for_stmt.condition, name);
+		retype_flag_in_statement(stmt->data.for_stmt.post, name);
+		retype_flag_in_statement(stmt->data.for_stmt.body, name);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		retype_flag_in_expression(stmt->data.expr, name);
+		break;
+	}
+}
+
+static void retype_flag_in_expression(AstExpr *expr, const char *name)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		if (strcmp(expr->data.identifier, name) == 0)
+		{
+			expr->type = TYPE_BOOL;
+		}
+		break;
+	case EXPR_BINARY:
+		retype_flag_in_expression(expr->data.binary.left, name);
+		retype_flag_in_expression(expr->data.binary.right, name);
+		break;
+	case EXPR_UNARY:
+		retype_flag_in_expression(expr->data.unary.operand, name);
+		break;
+	default:
+		break;
+	}
+}
+
+/* A local array whose literal initializer is never written to is built once
+ * at chunk level, and the declaration just binds the shared table. Arrays
+ * cannot leave their function, so nothing else can write it either. Code that
+ * runs only once, the top level of main, gains nothing and is left alone. */
+static void hoist_constant_arrays(OptimizerContext *ctx, AstProgram *program, AstStmtList *list, int runs_once)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		if (stmt->kind != STMT_DECL)
+		{
+			hoist_constant_arrays_in_statement(ctx, program, stmt, runs_once);
+			continue;
+		}
+		if (runs_once || program->constants.count >= HOISTED_TABLE_LIMIT || !is_constant_array(stmt, list, i + 1))
+		{
+			continue;
+		}
+		char *name = make_temp_name(ctx, "__const");
+		ast_stmt_list_push(&program->constants, ast_stmt_make_array_decl(stmt->data.decl.type, dup_string(name),
+																		  stmt->data.decl.array_size, stmt->data.decl.array_init));
+		stmt->data.decl.array_init = make_identifier(name, TYPE_ARRAY);
+		free(name);
+	}
+}
+
+static void hoist_constant_arrays_in_statement(OptimizerContext *ctx, AstProgram *program, AstStmt *stmt, int runs_once)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		hoist_constant_arrays(ctx, program, &stmt->data.block.statements, runs_once);
+		break;
+	case STMT_WHILE:
+		hoist_constant_arrays_in_statement(ctx, program, stmt->data.while_stmt.body, 0);
+		break;
+	case STMT_FOR:
+		hoist_constant_arrays_in_statement(ctx, program, stmt->data.for_stmt.body, 0);
+		break;
+	default:
+		break;
+	}
+}
+
+static int is_constant_array(const AstStmt *decl, const AstStmtList *list, size_t start)
+{
+	const AstExpr *init = decl->data.decl.array_init;
+	if (!decl->data.decl.is_array || decl->data.decl.array_size == 0 || !init || init->kind != EXPR_ARRAY_LITERAL)
+	{
+		return 0;
+	}
+	/* Only literals: anything folding left behind, such as a division by
+	 * zero, must not start failing when the chunk loads. */
+	for (size_t i = 0; i < init->data.array_literal.elements.count; ++i)
+	{
+		AstExpr *element = init->data.array_literal.elements.items[i];
+		if (element->kind != EXPR_INT_LITERAL && element->kind != EXPR_FLOAT_LITERAL && element->kind != EXPR_BOOL_LITERAL)
+		{
+			return 0;
+		}
+	}
+	for (size_t i = start; i < list->count; ++i)
+	{
+		if (ast_stmt_assigns(list->items[i], decl->data.decl.name))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Arrays never escape a function here: they cannot be passed, returned or
+ * copied, so a table declared in a loop body dies with the iteration. It is
+ * allocated once ahead of the loop and reset in place instead. Inner loops
+ * are handled first, so a table keeps moving out while the enclosing loops
+ * allow it; only the innermost position pays for the reset. */
+static void reuse_loop_arrays(OptimizerContext *ctx, AstStmtList *list, StmtSet *hoisted)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		AstStmt *body = NULL;
+		if (stmt->kind == STMT_BLOCK)
+		{
+			reuse_loop_arrays(ctx, &stmt->data.block.statements, hoisted);
+			continue;
+		}
+		if (stmt->kind == STMT_WHILE)
+		{
+			body = stmt->data.while_stmt.body;
+		}
+		else if (stmt->kind == STMT_FOR)
+		{
+			body = stmt->data.for_stmt.body;
+		}
+		if (!body || body->kind != STMT_BLOCK)
+		{
+			continue;
+		}
+		AstStmtList *statements = &body->data.block.statements;
+		reuse_loop_arrays(ctx, statements, hoisted);
+
+		AstStmtList outside = ast_stmt_list_make();
+		size_t j = 0;
+		while (j < statements->count)
+		{
+			AstStmt *decl = statements->items[j];
+			if (!array_is_reusable(stmt, statements, j))
+			{
+				++j;
+				continue;
+			}
+			AstStmtList reset = ast_stmt_list_make();
+			if (!stmt_set_contains(hoisted, decl))
+			{
+				build_array_reset(ctx, decl, statements, j + 1, &reset);
+				stmt_set_add(hoisted, decl);
+			}
+			ast_expr_destroy(decl->data.decl.array_init);
+			decl->data.decl.array_init = NULL;
+			ast_stmt_list_push(&outside, decl);
+			j += replace_statement(statements, j, &reset);
+		}
+		if (outside.count == 0)
+		{
+			continue;
+		}
+
+		int shadows = 0;
+		for (size_t k = 0; k < list->count && !shadows; ++k)
+		{
+			for (size_t m = 0; k != i && m < outside.count && !shadows; ++m)
+			{
+				shadows = statement_mentions(list->items[k], outside.items[m]->data.decl.name);
+			}
+		}
+		if (shadows)
+		{
+			ast_stmt_list_push(&outside, stmt);
+			AstBlock block = ast_block_from_list(&outside);
+			list->items[i] = ast_stmt_make_block(&block);
+			continue;
+		}
+		ast_stmt_list_push(&outside, stmt);
+		i += replace_statement(list, i, &outside) - 1;
+	}
+}
+
+static int array_is_reusable(const AstStmt *loop, const AstStmtList *body, size_t index)
+{
+	const AstStmt *decl = body->items[index];
+	if (decl->kind != STMT_DECL || !decl->data.decl.is_array || decl->data.decl.array_size == 0)
+	{
+		return 0;
+	}
+	const char *name = decl->data.decl.name;
+	const AstExpr *init = decl->data.decl.array_init;
+	if (init && (init->kind != EXPR_ARRAY_LITERAL || ast_expr_references(init, name)))
+	{
+		return 0;
+	}
+	/* Read-only literal tables are shared at chunk level instead. */
+	if (is_constant_array(decl, body, index + 1))
+	{
+		return 0;
+	}
+	if (loop->kind == STMT_WHILE && ast_expr_references(loop->data.while_stmt.condition, name))
+	{
+		return 0;
+	}
+	if (loop->kind == STMT_FOR &&
+		(statement_mentions(loop->data.for_stmt.init, name) || ast_expr_references(loop->data.for_stmt.condition, name) ||
+		 statement_mentions(loop->data.for_stmt.post, name)))
+	{
+		return 0;
+	}
+	for (size_t i = 0; i < index; ++i)
+	{
+		if (statement_mentions(body->items[i], name))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void build_array_reset(OptimizerContext *ctx, AstStmt *decl, const AstStmtList *body, size_t start, AstStmtList *reset)
+{
+	AstExpr *init = decl->data.decl.array_init;
+	size_t size = decl->data.decl.array_size;
+	size_t given = init ? init->data.array_literal.elements.count : 0;
+	int skippable = array_written_before_read(decl, body, start);
+	for (size_t i = 0; i < given && skippable; ++i)
+	{
+		skippable = !ast_expr_contains_call(init->data.array_literal.elements.items[i]);
+	}
+	if (skippable)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < given; ++i)
+	{
+		AstExpr *value = init->data.array_literal.elements.items[i];
+		init->data.array_literal.elements.items[i] = NULL;
+		ast_stmt_list_push(reset, make_element_store(decl, make_int((long long)i), value));
+	}
+	if (size - given <= RESET_UNROLL_LIMIT)
+	{
+		for (size_t i = given; i < size; ++i)
+		{
+			ast_stmt_list_push(reset, make_element_store(decl, make_int((long long)i), element_default(decl->data.decl.type)));
+		}
+		return;
+	}
+
+	char *counter = make_temp_name(ctx, "__reset");
+	AstStmt *init_counter = ast_stmt_make_decl(TYPE_INT, dup_string(counter), make_int((long long)given));
+	AstExpr *condition = make_binary(BIN_OP_LT, make_identifier(counter, TYPE_INT), make_int((long long)size), TYPE_BOOL);
+	AstStmt *post = ast_stmt_make_assign(dup_string(counter), add_constant(make_identifier(counter, TYPE_INT), 1));
+	post->data.assign.type = TYPE_INT;
+	AstStmtList stores = ast_stmt_list_make();
+	ast_stmt_list_push(&stores, make_element_store(decl, make_identifier(counter, TYPE_INT), element_default(decl->data.decl.type)));
+	AstBlock block = ast_block_from_list(&stores);
+	ast_stmt_list_push(reset, ast_stmt_make_for(init_counter, condition, post, ast_stmt_make_block(&block)));
+	free(counter);
+}
+
+static int array_written_before_read(const AstStmt *decl, const AstStmtList *list, size_t start)
+{
+	const char *name = decl->data.decl.name;
+	size_t size = decl->data.decl.array_size;
+	unsigned char *written = calloc(size, 1);
+	if (!written)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	size_t remaining = size;
+	for (size_t i = start; i < list->count && remaining > 0; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		if (stmt->kind == STMT_ARRAY_ASSIGN && strcmp(stmt->data.array_assign.name, name) == 0 &&
+			stmt->data.array_assign.index->kind == EXPR_INT_LITERAL && !ast_expr_references(stmt->data.array_assign.value, name))
+		{
+			long long index = stmt->data.array_assign.index->data.int_value;
+			if (index >= 0 && (size_t)index < size && !written[index])
+			{
+				written[index] = 1;
+				remaining--;
+			}
+			continue;
+		}
+		if (loop_fills_array(stmt, name, size))
+		{
+			remaining = 0;
+			break;
+		}
+		if (statement_mentions(stmt, name))
+		{
+			break;
+		}
+	}
+	free(written);
+	return remaining == 0;
+}
+
+/* Matches `for (int i = 0; i < size; i = i + 1) { ...; name[i] = v; ... }`
+ * where nothing ahead of the store touches the array. */
+static int loop_fills_array(AstStmt *loop, const char *name, size_t size)
+{
+	InductionVariable iv;
+	AstBinaryOp op;
+	AstExpr *bound = NULL;
+	if (loop->kind != STMT_FOR || !match_induction_variable(loop, &iv) || !match_loop_bound(loop, &iv, &op, &bound))
+	{
+		return 0;
+	}
+	if (iv.step != 1 || iv.start->kind != EXPR_INT_LITERAL || iv.start->data.int_value != 0 || bound->kind != EXPR_INT_LITERAL)
+	{
+		return 0;
+	}
+	long long last = op == BIN_OP_LT ? bound->data.int_value - 1 : bound->data.int_value;
+	if (last < (long long)size - 1 || ast_expr_references(loop->data.for_stmt.condition, name))
+	{
+		return 0;
+	}
+	const AstStmt *body = loop->data.for_stmt.body;
+	if (!body || body->kind != STMT_BLOCK)
+	{
+		return 0;
+	}
+	for (size_t i = 0; i < body->data.block.statements.count; ++i)
+	{
+		const AstStmt *stmt = body->data.block.statements.items[i];
+		if (stmt->kind == STMT_ARRAY_ASSIGN && strcmp(stmt->data.array_assign.name, name) == 0)
+		{
+			return is_identifier(stmt->data.array_assign.index, iv.name) && !ast_expr_references(stmt->data.array_assign.value, name);
+		}
+		if (statement_mentions(stmt, name))
+		{
+			return 0;
+		}
+	}
+	return 0;
+}
+
+static AstStmt *make_element_store(const AstStmt *decl, AstExpr *index, AstExpr *value)
+{
+	AstStmt *store = ast_stmt_make_array_assign(dup_string(decl->data.decl.name), index, value);
+	store->data.array_assign.element_type = decl->data.decl.type;
+	return store;
+}
+
+static AstExpr *element_default(TypeKind type)
+{
+	switch (type)
+	{
+	case TYPE_FLOAT:
+		return ast_expr_make_float(0.0);
+	case TYPE_BOOL:
+		return make_bool(0);
+	case TYPE_STRING:
+		return ast_expr_make_string(dup_string(""));
+	default:
+		return make_int(0);
+	}
+}
+
+/* Replaces list->items[index] with the statements of replacement, which is
+ * consumed, and returns how many were inserted. */
+static size_t replace_statement(AstStmtList *list, size_t index, AstStmtList *replacement)
+{
+	size_t inserted = replacement->count;
+	size_t tail = list->count - index - 1;
+	if (inserted > 1)
+	{
+		ensure_capacity((void **)&list->items, sizeof(AstStmt *), &list->capacity, list->count + inserted - 1);
+	}
+	memmove(&list->items[index + inserted], &list->items[index + 1], tail * sizeof(AstStmt *));
+	if (inserted > 0)
+	{
+		memcpy(&list->items[index], replacement->items, inserted * sizeof(AstStmt *));
+	}
+	list->count = list->count + inserted - 1;
+	free(replacement->items);
+	replacement->items = NULL;
+	replacement->count = 0;
+	replacement->capacity = 0;
+	return inserted;
+}
+
+static void stmt_set_add(StmtSet *set, const AstStmt *stmt)
+{
+	ensure_capacity((void **)&set->items, sizeof(AstStmt *), &set->capacity, set->count + 1);
+	set->items[set->count++] = stmt;
+}
+
+static int stmt_set_contains(const StmtSet *set, const AstStmt *stmt)
+{
+	for (size_t i = 0; i < set->count; ++i)
+	{
+		if (set->items[i] == stmt)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void unroll_loops(OptimizerContext *ctx, AstStmt **slot)
+{
+	AstStmt *stmt = *slot;
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			unroll_loops(ctx, &stmt->data.block.statements.items[i]);
+		}
+		break;
+	case STMT_WHILE:
+		unroll_loops(ctx, &stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+	{
+		InductionVariable iv;
+		AstBinaryOp op;
+		AstExpr *bound = NULL;
+		int matched = match_induction_variable(stmt, &iv) && match_loop_bound(stmt, &iv, &op, &bound);
+		/* A profile rules out loops that never ran, and partial unrolling of
+		 * loops that on average end before one unrolled iteration. */
+		long long trips = profile_trips(ctx->profile, ctx->function, stmt->data.for_stmt.profile_id);
+		long long entries = profile_entries(ctx->profile, ctx->function, stmt->data.for_stmt.profile_id);
+		int eligible = matched && trips != 0 && !contains_return(stmt->data.for_stmt.body);
+		if (eligible && unroll_nest_fully(ctx, slot, &iv, op, bound))
+		{
+			break;
+		}
+
+		unroll_loops(ctx, &stmt->data.for_stmt.body);
+		if (!eligible)
+		{
+			break;
+		}
+
+		size_t size = statement_size(stmt->data.for_stmt.body);
+		size_t limit = ctx->options->unroll_limit;
+		size_t factor = ctx->options->unroll_factor;
+		if (entries > 0 && trips > 0 && (size_t)(trips / entries) < factor)
+		{
+			break;
+		}
+		if (factor > 1 && size * factor <= limit && !contains_loop(stmt->data.for_stmt.body) &&
+			ast_expr_invariant_in(bound, stmt->data.for_stmt.body))
+		{
+			*slot = unroll_partially(ctx, stmt, &iv);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+/* Outer loops are unrolled before their inner loops so that the copies see the
+ * induction variable as a literal: locals it initialises are propagated and the
+ * inner loops are decided again with literal bounds. The nest is kept only if
+ * the whole result fits the unroll limit. */
+static int unroll_nest_fully(OptimizerContext *ctx, AstStmt **slot, const InductionVariable *iv, AstBinaryOp op, const AstExpr *bound)
+{
+	AstStmt *loop = *slot;
+	if (iv->start->kind != EXPR_INT_LITERAL || bound->kind != EXPR_INT_LITERAL)
+	{
+		return 0;
+	}
+
+	size_t size = statement_size(loop->data.for_stmt.body);
+	size_t limit = ctx->options->unroll_limit;
+	size_t max_trips = limit / (size > 0 ? size : 1);
+	long long trip_count = 0;
+	for (long long value = iv->start->data.int_value; bound_holds(value, op, bound->data.int_value); value += iv->step)
+	{
+		if ((size_t)++trip_count > max_trips)
+		{
+			return 0;
+		}
+	}
+
+	size_t temp_counter = ctx->temp_counter;
+	AstStmt *unrolled = unroll_fully(ctx, loop, iv, trip_count);
+	propagate_copies(ctx, &unrolled->data.block.statements);
+	unroll_loops(ctx, &unrolled);
+	flatten_blocks(&unrolled->data.block.statements);
+	if (statement_size(unrolled) > limit)
+	{
+		ast_stmt_destroy(unrolled);
+		ctx->temp_counter = temp_counter;
+		return 0;
+	}
+	*slot = unrolled;
+	ast_stmt_destroy(loop);
+	return 1;
+}
+
+static int match_loop_bound(AstStmt *loop, const InductionVariable *iv, AstBinaryOp *op, AstExpr **bound)
+{
+	AstExpr *condition = loop->data.for_stmt.condition;
+	if (!condition || condition->kind != EXPR_BINARY)
+	{
+		return 0;
+	}
+	AstBinaryOp cmp = condition->data.binary.op;
+	AstExpr *left = condition->data.binary.left;
+	AstExpr *right = condition->data.binary.right;
+	if (is_identifier(left, iv->name))
+	{
+		*bound = right;
+	}
+	else if (is_identifier(right, iv->name))
+	{
+		*bound = left;
+		switch (cmp)
+		{
+		case BIN_OP_LT:
+			cmp = BIN_OP_GT;
+			break;
+		case BIN_OP_LE:
+			cmp = BIN_OP_GE;
+			break;
+		case BIN_OP_GT:
+			cmp = BIN_OP_LT;
+			break;
+		case BIN_OP_GE:
+			cmp = BIN_OP_LE;
+			break;
+		default:
+			return 0;
+		}
+	}
+	else
+	{
+		return 0;
+	}
+	if ((*bound)->type != TYPE_INT || ast_expr_references(*bound, iv->name) || ast_expr_contains_call(*bound))
+	{
+		return 0;
+	}
+	if ((cmp == BIN_OP_LT || cmp == BIN_OP_LE) && iv->step > 0)
+	{
+		*op = cmp;
+		return 1;
+	}
+	if ((cmp == BIN_OP_GT || cmp == BIN_OP_GE) && iv->step < 0)
+	{
+		*op = cmp;
+		return 1;
+	}
+	return 0;
+}
+
+static int bound_holds(long long value, AstBinaryOp op, long long bound)
+{
+	switch (op)
+	{
+	case BIN_OP_LT:
+		return value < bound;
+	case BIN_OP_LE:
+		return value <= bound;
+	case BIN_OP_GT:
+		return value > bound;
+	case BIN_OP_GE:
+		return value >= bound;
+	default:
+		return 0;
+	}
+}
+
+static AstStmt *unroll_fully(OptimizerContext *ctx, const AstStmt *loop, const InductionVariable *iv, long long trip_count)
+{
+	AstStmtList list = ast_stmt_list_make();
+	long long value = iv->start->data.int_value;
+	for (long long i = 0; i < trip_count; ++i, value += iv->step)
+	{
+		AstExpr *replacement = make_int(value);
+		append_body_copy(ctx, &list, loop->data.for_stmt.body, iv->name, replacement);
+		ast_expr_destroy(replacement);
+	}
+	AstBlock block = ast_block_from_list(&list);
+	return ast_stmt_make_block(&block);
+}
+
+/* for (int i = e0; i < n; i = i + k) body becomes
+ *   { int u = e0;
+ *     for (int i = u; i < n - (F - 1) * k; i = i + F * k) { body[i] ... body[i + (F - 1) * k]; u = i + F * k; }
+ *     for (int i = u; i < n; i = i + k) body }
+ * so both halves keep the canonical shape the numeric-for lowering expects. */
+static AstStmt *unroll_partially(OptimizerContext *ctx, AstStmt *loop, const InductionVariable *iv)
+{
+	long long factor = (long long)ctx->options->unroll_factor;
+	char *resume = make_temp_name(ctx, "__unroll");
+	AstStmtList outer = ast_stmt_list_make();
+	AstStmt *init = loop->data.for_stmt.init;
+
+	ast_stmt_list_push(&outer, ast_stmt_make_decl(TYPE_INT, dup_string(resume), init->data.decl.init));
+	init->data.decl.init = make_identifier(resume, TYPE_INT);
+
+	AstStmtList copies = ast_stmt_list_make();
+	for (long long i = 0; i < factor; ++i)
+	{
+		AstExpr *replacement = i == 0 ? make_identifier(iv->name, TYPE_INT)
+									  : add_constant(make_identifier(iv->name, TYPE_INT), i * iv->step);
+		append_body_copy(ctx, &copies, loop->data.for_stmt.body, iv->name, replacement);
+		ast_expr_destroy(replacement);
+	}
+	AstStmt *advance = ast_stmt_make_assign(dup_string(resume), add_constant(make_identifier(iv->name, TYPE_INT), factor * iv->step));
+	advance->data.assign.type = TYPE_INT;
+	ast_stmt_list_push(&copies, advance);
+	AstBlock copies_block = ast_block_from_list(&copies);
+
+	AstStmt *main_loop = ast_stmt_make_for(ast_stmt_clone(init),
+										   ast_expr_clone(loop->data.for_stmt.condition),
+										   ast_stmt_clone(loop->data.for_stmt.post),
+										   ast_stmt_make_block(&copies_block));
+	AstExpr **main_bound = main_loop->data.for_stmt.condition->data.binary.left->kind == EXPR_IDENTIFIER &&
+								   strcmp(main_loop->data.for_stmt.condition->data.binary.left->data.identifier, iv->name) == 0
+							   ? &main_loop->data.for_stmt.condition->data.binary.right
+							   : &main_loop->data.for_stmt.condition->data.binary.left;
+	*main_bound = add_constant(*main_bound, -(factor - 1) * iv->step);
+	AstExpr *step = main_loop->data.for_stmt.post->data.assign.value;
+	AstExpr **step_literal = step->data.binary.right->kind == EXPR_INT_LITERAL ? &step->data.binary.right : &step->data.binary.left;
+	(*step_literal)->data.int_value *= factor;
+
+	ast_stmt_list_push(&outer, main_loop);
+	ast_stmt_list_push(&outer, loop);
+	free(resume);
+	AstBlock block = ast_block_from_list(&outer);
+	return ast_stmt_make_block(&block);
+}
+
+static void append_body_copy(OptimizerContext *ctx, AstStmtList *list, const AstStmt *body, const char *name, const AstExpr *replacement)
+{
+	if (!body)
+	{
+		return;
+	}
+	AstStmt *copy = ast_stmt_clone(body);
+	substitute_in_statement(copy, name, replacement);
+	fold_statement(ctx, copy);
+	if (is_self_assignment(copy))
+	{
+		ast_stmt_destroy(copy);
+		return;
+	}
+	append_statements(list, copy);
+}
+
+/* Splices a block into the list unless it declares locals that must stay scoped. */
+static void append_statements(AstStmtList *list, AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+	if (stmt->kind != STMT_BLOCK)
+	{
+		ast_stmt_list_push(list, stmt);
+		return;
+	}
+	for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+	{
+		if (stmt->data.block.statements.items[i]->kind == STMT_DECL)
+		{
+			ast_stmt_list_push(list, stmt);
+			return;
+		}
+	}
+	for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+	{
+		ast_stmt_list_push(list, stmt->data.block.statements.items[i]);
+	}
+	free(stmt->data.block.statements.items);
+	free(stmt);
+}
+
+/* Splices nested blocks that no longer declare anything and drops blocks left
+ * holding only declarations, whose locals nothing can read. */
+static void flatten_blocks(AstStmtList *list)
+{
+	AstStmtList items = *list;
+	*list = ast_stmt_list_make();
+	for (size_t i = 0; i < items.count; ++i)
+	{
+		AstStmt *stmt = items.items[i];
+		if (stmt->kind == STMT_BLOCK)
+		{
+			flatten_blocks(&stmt->data.block.statements);
+			if (declares_only(stmt))
+			{
+				ast_stmt_destroy(stmt);
+				continue;
+			}
+		}
+		append_statements(list, stmt);
+	}
+	free(items.items);
+}
+
+static int declares_only(const AstStmt *block)
+{
+	for (size_t i = 0; i < block->data.block.statements.count; ++i)
+	{
+		const AstStmt *stmt = block->data.block.statements.items[i];
+		if (stmt->kind != STMT_DECL || (stmt->data.decl.init && ast_expr_contains_call(stmt->data.decl.init)) ||
+			(stmt->data.decl.array_init && ast_expr_contains_call(stmt->data.decl.array_init)))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static size_t statement_size(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+	{
+		size_t size = 0;
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			size += statement_size(stmt->data.block.statements.items[i]);
+		}
+		return size;
+	}
+	case STMT_WHILE:
+		return 1 + statement_size(stmt->data.while_stmt.body);
+	case STMT_FOR:
+		return 1 + statement_size(stmt->data.for_stmt.init) + statement_size(stmt->data.for_stmt.post) +
+			   statement_size(stmt->data.for_stmt.body);
+	default:
+		return 1;
+	}
+}
+
+static int contains_loop(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+	if (stmt->kind == STMT_WHILE || stmt->kind == STMT_FOR)
+	{
+		return 1;
+	}
+	if (stmt->kind == STMT_BLOCK)
+	{
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (contains_loop(stmt->data.block.statements.items[i]))
+			{
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/* Copies of a body that returns would put the return mid-block. */
+static int contains_return(const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_RETURN:
+		return 1;
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (contains_return(stmt->data.block.statements.items[i]))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case STMT_WHILE:
+		return contains_return(stmt->data.while_stmt.body);
+	case STMT_FOR:
+		return contains_return(stmt->data.for_stmt.body);
+	default:
+		return 0;
+	}
+}
+
+static int is_self_assignment(const AstStmt *stmt)
+{
+	return stmt && stmt->kind == STMT_ASSIGN && is_identifier(stmt->data.assign.value, stmt->data.assign.name);
+}
+
+static void fold_statement(OptimizerContext *ctx, AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+	{
+		/* Substituting a literal 0 leaves x = x + 0 behind; once folded it is
+		 * a self-assignment and can go. */
+		AstStmtList *list = &stmt->data.block.statements;
+		size_t kept = 0;
+		for (size_t i = 0; i < list->count; ++i)
+		{
+			fold_statement(ctx, list->items[i]);
+			if (is_self_assignment(list->items[i]))
+			{
+				ast_stmt_destroy(list->items[i]);
+				continue;
+			}
+			list->items[kept++] = list->items[i];
+		}
+		list->count = kept;
+		break;
+	}
+	case STMT_DECL:
+		fold_expression(ctx, &stmt->data.decl.init);
+		fold_expression(ctx, &stmt->data.decl.array_init);
+		break;
+	case STMT_ASSIGN:
+		fold_expression(ctx, &stmt->data.assign.value);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		fold_expression(ctx, &stmt->data.array_assign.index);
+		fold_expression(ctx, &stmt->data.array_assign.value);
+		break;
+	case STMT_WHILE:
+		fold_expression(ctx, &stmt->data.while_stmt.condition);
+		fold_statement(ctx, stmt->data.while_stmt.body);
+		break;
+	case STMT_FOR:
+		fold_statement(ctx, stmt->data.for_stmt.init);
+		fold_expression(ctx, &stmt->data.for_stmt.condition);
+		fold_statement(ctx, stmt->data.for_stmt.post);
+		fold_statement(ctx, stmt->data.for_stmt.body);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		fold_expression(ctx, &stmt->data.expr);
+		break;
+	}
+}
+
+/* Folds integer +, - and * over literals and drops +0 / *1, which is what
+ * substituting literals or shifted induction variables leaves behind. */
+static void fold_expression(OptimizerContext *ctx, AstExpr **slot)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		fold_expression(ctx, &expr->data.binary.left);
+		fold_expression(ctx, &expr->data.binary.right);
+		break;
+	case EXPR_UNARY:
+		fold_expression(ctx, &expr->data.unary.operand);
+		if (expr->data.unary.op == UN_OP_NEG && expr->data.unary.operand->kind == EXPR_INT_LITERAL)
+		{
+			long long value = (long long)(0ULL - (unsigned long long)expr->data.unary.operand->data.int_value);
+			ast_expr_destroy(expr);
+			*slot = make_int(fold_int(ctx, value));
+		}
+		else if (expr->data.unary.op == UN_OP_NOT && expr->data.unary.operand->kind == EXPR_BOOL_LITERAL)
+		{
+			int value = !expr->data.unary.operand->data.bool_value;
+			ast_expr_destroy(expr);
+			*slot = make_bool(value);
+		}
+		return;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			fold_expression(ctx, &expr->data.call.args.items[i]);
+		}
+		return;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			fold_expression(ctx, &expr->data.array_literal.elements.items[i]);
+		}
+		return;
+	case EXPR_SUBSCRIPT:
+		fold_expression(ctx, &expr->data.subscript.index);
+		return;
+	default:
+		return;
+	}
+
+	AstExpr *left = expr->data.binary.left;
+	AstExpr *right = expr->data.binary.right;
+	AstBinaryOp op = expr->data.binary.op;
+	if (fold_condition(slot))
+	{
+		return;
+	}
+	if (expr->type != TYPE_INT || (op != BIN_OP_ADD && op != BIN_OP_SUB && op != BIN_OP_MUL))
+	{
+		return;
+	}
+	if (left->kind == EXPR_INT_LITERAL && right->kind == EXPR_INT_LITERAL)
+	{
+		unsigned long long a = (unsigned long long)left->data.int_value;
+		unsigned long long b = (unsigned long long)right->data.int_value;
+		unsigned long long result = op == BIN_OP_ADD ? a + b : op == BIN_OP_SUB ? a - b : a * b;
+		ast_expr_destroy(expr);
+		*slot = make_int(fold_int(ctx, (long long)result));
+		return;
+	}
+
+	AstExpr *keep = NULL;
+	if (op == BIN_OP_ADD && left->kind == EXPR_INT_LITERAL && left->data.int_value == 0)
+	{
+		keep = right;
+		expr->data.binary.right = NULL;
+	}
+	else if ((op == BIN_OP_ADD || op == BIN_OP_SUB) && right->kind == EXPR_INT_LITERAL && right->data.int_value == 0)
+	{
+		keep = left;
+		expr->data.binary.left = NULL;
+	}
+	else if (op == BIN_OP_MUL && left->kind == EXPR_INT_LITERAL && left->data.int_value == 1)
+	{
+		keep = right;
+		expr->data.binary.right = NULL;
+	}
+	else if (op == BIN_OP_MUL && right->kind == EXPR_INT_LITERAL && right->data.int_value == 1)
+	{
+		keep = left;
+		expr->data.binary.left = NULL;
+	}
+	if (keep)
+	{
+		if (keep->type != TYPE_INT)
+		{
+			if (expr->data.binary.left)
+			{
+				expr->data.binary.right = keep;
+			}
+			else
+			{
+				expr->data.binary.left = keep;
+			}
+			return;
+		}
+		ast_expr_destroy(expr);
+		*slot = keep;
+		return;
+	}
+
+	if ((op == BIN_OP_ADD || op == BIN_OP_SUB) && right->kind == EXPR_INT_LITERAL && is_index_additive(left) &&
+		left->data.binary.right->kind == EXPR_INT_LITERAL)
+	{
+		long long value = op == BIN_OP_ADD ? right->data.int_value : -right->data.int_value;
+		expr->data.binary.left = NULL;
+		ast_expr_destroy(expr);
+		*slot = add_constant(left, value);
+	}
+}
+
+/* Comparisons of integer literals and && / || with a literal operand, which
+ * is what substituting constant parameters leaves in loop conditions. */
+static int fold_condition(AstExpr **slot)
+{
+	AstExpr *expr = *slot;
+	AstExpr *left = expr->data.binary.left;
+	AstExpr *right = expr->data.binary.right;
+	AstBinaryOp op = expr->data.binary.op;
+
+	if (left->kind == EXPR_INT_LITERAL && right->kind == EXPR_INT_LITERAL && op >= BIN_OP_EQ && op <= BIN_OP_GE)
+	{
+		long long a = left->data.int_value;
+		long long b = right->data.int_value;
+		int value = op == BIN_OP_EQ ? a == b : op == BIN_OP_NEQ ? a != b : op == BIN_OP_LT ? a < b
+												: op == BIN_OP_LE ? a <= b : op == BIN_OP_GT ? a > b : a >= b;
+		ast_expr_destroy(expr);
+		*slot = make_bool(value);
+		return 1;
+	}
+	if (left->kind == EXPR_BOOL_LITERAL && right->kind == EXPR_BOOL_LITERAL && (op == BIN_OP_EQ || op == BIN_OP_NEQ))
+	{
+		int value = (left->data.bool_value == right->data.bool_value) == (op == BIN_OP_EQ);
+		ast_expr_destroy(expr);
+		*slot = make_bool(value);
+		return 1;
+	}
+	if (op != BIN_OP_AND && op != BIN_OP_OR)
+	{
+		return 0;
+	}
+
+	int absorbing = op == BIN_OP_OR;
+	AstExpr *keep = NULL;
+	if (left->kind == EXPR_BOOL_LITERAL)
+	{
+		if (left->data.bool_value == absorbing)
+		{
+			ast_expr_destroy(expr);
+			*slot = make_bool(absorbing);
+			return 1;
+		}
+		keep = right;
+	}
+	else if (right->kind == EXPR_BOOL_LITERAL && right->data.bool_value != absorbing)
+	{
+		keep = left;
+	}
+	if (!keep || keep->type != TYPE_BOOL)
+	{
+		return 0;
+	}
+	if (keep == left)
+	{
+		expr->data.binary.left = NULL;
+	}
+	else
+	{
+		expr->data.binary.right = NULL;
+	}
+	ast_expr_destroy(expr);
+	*slot = keep;
+	return 1;
+}
+
+static void scan_usage_in_statement(const AstStmt *stmt, const char *name, InductionUsage *usage)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			scan_usage_in_statement(stmt->data.block.statements.items[i], name, usage);
+		}
+		break;
+	case STMT_DECL:
+		scan_usage_in_expression(stmt->data.decl.init, name, usage);
+		scan_usage_in_expression(stmt->data.decl.array_init, name, usage);
+		break;
+	case STMT_ASSIGN:
+		scan_usage_in_expression(stmt->data.assign.value, name, usage);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		scan_usage_in_index(stmt->data.array_assign.index, name, usage);
+		scan_usage_in_expression(stmt->data.array_assign.value, name, usage);
+		break;
+	case STMT_WHILE:
+		scan_usage_in_expression(stmt->data.while_stmt.condition, name, usage);
+		scan_usage_in_statement(stmt->data.while_stmt.body, name, usage);
+		break;
+	case STMT_FOR:
+		scan_usage_in_statement(stmt->data.for_stmt.init, name, usage);
+		scan_usage_in_expression(stmt->data.for_stmt.condition, name, usage);
+		scan_usage_in_statement(stmt->data.for_stmt.post, name, usage);
+		scan_usage_in_statement(stmt->data.for_stmt.body, name, usage);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		scan_usage_in_expression(stmt->data.expr, name, usage);
+		break;
+	}
+}
+
+static void scan_usage_in_expression(const AstExpr *expr, const char *name, InductionUsage *usage)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		if (strcmp(expr->data.identifier, name) == 0)
+		{
+			usage->other_uses++;
+		}
+		break;
+	case EXPR_BINARY:
+		scan_usage_in_expression(expr->data.binary.left, name, usage);
+		scan_usage_in_expression(expr->data.binary.right, name, usage);
+		break;
+	case EXPR_UNARY:
+		scan_usage_in_expression(expr->data.unary.operand, name, usage);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			scan_usage_in_expression(expr->data.call.args.items[i], name, usage);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			scan_usage_in_expression(expr->data.array_literal.elements.items[i], name, usage);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		scan_usage_in_index(expr->data.subscript.index, name, usage);
+		break;
+	default:
+		break;
+	}
+}
+
+static void scan_usage_in_index(const AstExpr *expr, const char *name, InductionUsage *usage)
+{
+	if (is_index_additive(expr))
+	{
+		scan_usage_in_index(expr->data.binary.left, name, usage);
+		scan_usage_in_index(expr->data.binary.right, name, usage);
+	}
+	else if (is_identifier(expr, name))
+	{
+		usage->index_uses++;
+	}
+	else
+	{
+		scan_usage_in_expression(expr, name, usage);
+	}
+}
+
+static int match_direct_comparison(AstExpr *condition, const char *name, AstExpr ***bound_slot)
+{
+	if (!condition || condition->kind != EXPR_BINARY)
+	{
+		return 0;
+	}
+	switch (condition->data.binary.op)
+	{
+	case BIN_OP_EQ:
+	case BIN_OP_NEQ:
+	case BIN_OP_LT:
+	case BIN_OP_LE:
+	case BIN_OP_GT:
+	case BIN_OP_GE:
+		break;
+	default:
+		return 0;
+	}
+	AstExpr **left = &condition->data.binary.left;
+	AstExpr **right = &condition->data.binary.right;
+	if (is_identifier(*left, name) && !ast_expr_references(*right, name) && (*right)->type == TYPE_INT)
+	{
+		*bound_slot = right;
+		return 1;
+	}
+	if (is_identifier(*right, name) && !ast_expr_references(*left, name) && (*left)->type == TYPE_INT)
+	{
+		*bound_slot = left;
+		return 1;
+	}
+	return 0;
+}
+
+static void substitute_in_statement(AstStmt *stmt, const char *name, const AstExpr *replacement)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			substitute_in_statement(stmt->data.block.statements.items[i], name, replacement);
+		}
+		break;
+	case STMT_DECL:
+		substitute_in_expression(&stmt->data.decl.init, name, replacement);
+		substitute_in_expression(&stmt->data.decl.array_init, name, replacement);
+		break;
+	case STMT_ASSIGN:
+		substitute_in_expression(&stmt->data.assign.value, name, replacement);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		substitute_in_expression(&stmt->data.array_assign.index, name, replacement);
+		substitute_in_expression(&stmt->data.array_assign.value, name, replacement);
+		break;
+	case STMT_WHILE:
+		substitute_in_expression(&stmt->data.while_stmt.condition, name, replacement);
+		substitute_in_statement(stmt->data.while_stmt.body, name, replacement);
+		break;
+	case STMT_FOR:
+		substitute_in_statement(stmt->data.for_stmt.init, name, replacement);
+		substitute_in_expression(&stmt->data.for_stmt.condition, name, replacement);
+		substitute_in_statement(stmt->data.for_stmt.post, name, replacement);
+		substitute_in_statement(stmt->data.for_stmt.body, name, replacement);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		substitute_in_expression(&stmt->data.expr, name, replacement);
+		break;
+	}
+}
+
+static void substitute_in_expression(AstExpr **slot, const char *name, const AstExpr *replacement)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_IDENTIFIER:
+		if (strcmp(expr->data.identifier, name) == 0)
+		{
+			*slot = ast_expr_clone(replacement);
+			ast_expr_destroy(expr);
+		}
+		break;
+	case EXPR_BINARY:
+		substitute_in_expression(&expr->data.binary.left, name, replacement);
+		substitute_in_expression(&expr->data.binary.right, name, replacement);
+		break;
+	case EXPR_UNARY:
+		substitute_in_expression(&expr->data.unary.operand, name, replacement);
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			substitute_in_expression(&expr->data.call.args.items[i], name, replacement);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			substitute_in_expression(&expr->data.array_literal.elements.items[i], name, replacement);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+		substitute_in_expression(&expr->data.subscript.index, name, replacement);
+		break;
+	default:
+		break;
+	}
+}
+
+static int is_index_additive(const AstExpr *expr)
+{
+	return expr && expr->kind == EXPR_BINARY && expr->type == TYPE_INT &&
+		   (expr->data.binary.op == BIN_OP_ADD || expr->data.binary.op == BIN_OP_SUB);
+}
+
+static int is_identifier(const AstExpr *expr, const char *name)
+{
+	return expr && expr->kind == EXPR_IDENTIFIER && strcmp(expr->data.identifier, name) == 0;
+}
+
+static AstExpr *add_constant(AstExpr *expr, long long value)
+{
+	if (expr->kind == EXPR_INT_LITERAL)
+	{
+		expr->data.int_value = (long long)((unsigned long long)expr->data.int_value + (unsigned long long)value);
+		return expr;
+	}
+	/* Offsets are only merged while the sum and its negation still fit. */
+	if (is_index_additive(expr) && expr->data.binary.right->kind == EXPR_INT_LITERAL &&
+		expr->data.binary.right->data.int_value != LLONG_MIN)
+	{
+		AstExpr *right = expr->data.binary.right;
+		long long offset = expr->data.binary.op == BIN_OP_ADD ? right->data.int_value : -right->data.int_value;
+		if ((value > 0 && offset > LLONG_MAX - value) || (value < 0 && offset <= LLONG_MIN - value))
+		{
+			return make_binary(BIN_OP_ADD, expr, make_int(value), TYPE_INT);
+		}
+		offset += value;
+		if (offset == 0)
+		{
+			AstExpr *left = expr->data.binary.left;
+			expr->data.binary.left = NULL;
+			ast_expr_destroy(expr);
+			return left;
+		}
+		expr->data.binary.op = offset > 0 ? BIN_OP_ADD : BIN_OP_SUB;
+		right->data.int_value = offset > 0 ? offset : -offset;
+		return expr;
+	}
+	TypeKind type = expr->type == TYPE_FLOAT ? TYPE_FLOAT : TYPE_INT;
+	return make_binary(BIN_OP_ADD, expr, make_int(value), type);
+}
+
+static AstExpr *make_int(long long value)
+{
+	return ast_expr_make_int(value);
+}
+
+static long long fold_int(const OptimizerContext *ctx, long long value)
+{
+	return ctx->options->int_semantics == INT_SEMANTICS_C32 ? wrap_int32(value) : value;
+}
+
+static long long wrap_int32(long long value)
+{
+	unsigned long long bits = (unsigned long long)value & 0xFFFFFFFFULL;
+	return bits >= 0x80000000ULL ? (long long)bits - 0x100000000LL : (long long)bits;
+}
+
+static AstExpr *make_bool(int value)
+{
+	return ast_expr_make_bool(value);
+}
+
+static AstExpr *make_binary(AstBinaryOp op, AstExpr *left, AstExpr *right, TypeKind type)
+{
+	AstExpr *expr = ast_expr_make_binary(op, left, right);
+	expr->type = type;
+	return expr;
+}
+
+static AstExpr *make_identifier(const char *name, TypeKind type)
+{
+	AstExpr *expr = ast_expr_make_identifier(dup_string(name));
+	expr->type = type;
+	return expr;
+}
+
+static AstStmt *wrap_with_prelude(AstStmt *stmt, AstStmtList *prelude)
+{
+	if (prelude->count == 0)
+	{
+		return stmt;
+	}
+	ast_stmt_list_push(prelude, stmt);
+	AstBlock block = ast_block_from_list(prelude);
+	return ast_stmt_make_block(&block);
+}
+
+static int expr_is_constant(const AstExpr *expr)
+{
+	if (!expr)
+	{
+		return 1;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+	case EXPR_STRING_LITERAL:
+		return 1;
+	case EXPR_BINARY:
+		return expr_is_constant(expr->data.binary.left) && expr_is_constant(expr->data.binary.right);
+	case EXPR_UNARY:
+		return expr_is_constant(expr->data.unary.operand);
+	default:
+		return 0;
+	}
+}
+
+static void collect_assigned_names(const AstStmt *stmt, NameSet *set)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			collect_assigned_names(stmt->data.block.statements.items[i], set);
+		}
+		break;
+	case STMT_DECL:
+		name_set_add(set, stmt->data.decl.name);
+		break;
+	case STMT_ASSIGN:
+		name_set_add(set, stmt->data.assign.name);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		name_set_add(set, stmt->data.array_assign.name);
+		break;
+	case STMT_WHILE:
+		collect_assigned_names(stmt->data.while_stmt.body, set);
+		break;
+	case STMT_FOR:
+		collect_assigned_names(stmt->data.for_stmt.init, set);
+		collect_assigned_names(stmt->data.for_stmt.post, set);
+		collect_assigned_names(stmt->data.for_stmt.body, set);
+		break;
+	case STMT_EXPR:
+	case STMT_RETURN:
+		break;
+	}
+}
+
+static void name_set_add(NameSet *set, const char *name)
+{
+	if (name_set_contains(set, name))
+	{
+		return;
+	}
+	ensure_capacity((void **)&set->items, sizeof(char *), &set->capacity, set->count + 1);
+	set->items[set->count++] = dup_string(name);
+}
+
+static int name_set_contains(const NameSet *set, const char *name)
+{
+	for (size_t i = 0; i < set->count; ++i)
+	{
+		if (strcmp(set->items[i], name) == 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void name_set_free(NameSet *set)
+{
+	for (size_t i = 0; i < set->count; ++i)
+	{
+		free(set->items[i]);
+	}
+	free(set->items);
+	set->items = NULL;
+	set->count = 0;
+	set->capacity = 0;
+}
+
+static char *make_temp_name(OptimizerContext *ctx, const char *prefix)
+{
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "%s%zu", prefix, ++ctx->temp_counter);
+	return dup_string(buffer);
+}
+
+static char *dup_string(const char *src)
+{
+	if (!src)
+	{
+		return NULL;
+	}
+	size_t len = strlen(src) + 1;
+	char *copy = malloc(len);
+	if (!copy)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(copy, src, len);
+	return copy;
+}
+
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed)
+{
+	if (*capacity >= needed)
+	{
+		return;
+	}
+	size_t new_capacity = (*capacity == 0) ? 4 : (*capacity * 2);
+	while (new_capacity < needed)
+	{
+		new_capacity *= 2;
+	}
+	void *new_buffer = realloc(*buffer, new_capacity * elem_size);
+	if (!new_buffer)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	*buffer = new_buffer;
+	*capacity = new_capacity;
+}
@@ -0,0 +1,11 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "ast.h"
+#include "options.h"
+#include "profile.h"
+#include "symbol_table.h"
+
+void optimizer_run(AstProgram *program, FunctionTable *functions, const CompilerOptions *options, const Profile *profile);
+
+#endif
@@ -0,0 +1,162 @@
+#include "options.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *option_value(const char *arg, const char *prefix);
+static int parse_size(const char *text, size_t *value);
+
+void compiler_options_init(CompilerOptions *options)
+{
+	if (!options)
+	{
+		return;
+	}
+	options->unroll_loops = 0;
+	options->unroll_factor = 4;
+	options->unroll_limit = 64;
+	options->memoize = MEMOIZE_NONE;
+	options->specialize_limit = 64;
+	options->eval_limit = 100000;
+	options->bounds_check = 0;
+	options->int_semantics = INT_SEMANTICS_LUA;
+	options->lua_version = LUA_VERSION_53;
+	options->profile_generate = NULL;
+	options->profile_use = NULL;
+}
+
+int compiler_options_parse(CompilerOptions *options, const char *arg)
+{
+	const char *value;
+	if (!options || !arg)
+	{
+		return 0;
+	}
+	if (strcmp(arg, "-funroll-loops") == 0)
+	{
+		options->unroll_loops = 1;
+		return 1;
+	}
+	if (strcmp(arg, "-fno-unroll-loops") == 0)
+	{
+		options->unroll_loops = 0;
+		return 1;
+	}
+	if (strcmp(arg, "--bounds-check") == 0)
+	{
+		options->bounds_check = 1;
+		return 1;
+	}
+	if ((value = option_value(arg, "--unroll-factor=")) != NULL)
+	{
+		return parse_size(value, &options->unroll_factor) && options->unroll_factor > 0;
+	}
+	if ((value = option_value(arg, "--unroll-limit=")) != NULL)
+	{
+		return parse_size(value, &options->unroll_limit);
+	}
+	if ((value = option_value(arg, "--specialize-limit=")) != NULL)
+	{
+		return parse_size(value, &options->specialize_limit);
+	}
+	if ((value = option_value(arg, "--eval-limit=")) != NULL)
+	{
+		return parse_size(value, &options->eval_limit);
+	}
+	if ((value = option_value(arg, "--profile-generate=")) != NULL)
+	{
+		options->profile_generate = value;
+		return *value != '\0';
+	}
+	if ((value = option_value(arg, "--profile-use=")) != NULL)
+	{
+		options->profile_use = value;
+		return *value != '\0';
+	}
+	if ((value = option_value(arg, "--memoize=")) != NULL)
+	{
+		if (strcmp(value, "auto") == 0)
+		{
+			options->memoize = MEMOIZE_AUTO;
+			return 1;
+		}
+		if (strcmp(value, "none") == 0)
+		{
+			options->memoize = MEMOIZE_NONE;
+			return 1;
+		}
+		return 0;
+	}
+	if ((value = option_value(arg, "--int-semantics=")) != NULL)
+	{
+		if (strcmp(value, "lua") == 0)
+		{
+			options->int_semantics = INT_SEMANTICS_LUA;
+			return 1;
+		}
+		if (strcmp(value, "c32") == 0)
+		{
+			options->int_semantics = INT_SEMANTICS_C32;
+			return 1;
+		}
+		return 0;
+	}
+	if ((value = option_value(arg, "--lua-version=")) != NULL)
+	{
+		if (strcmp(value, "5.3") == 0)
+		{
+			options->lua_version = LUA_VERSION_53;
+			return 1;
+		}
+		if (strcmp(value, "5.4") == 0)
+		{
+			options->lua_version = LUA_VERSION_54;
+			return 1;
+		}
+		return 0;
+	}
+	return 0;
+}
+
+void compiler_options_usage(FILE *out)
+{
+	fputs("Options:\n", out);
+	fputs("  -funroll-loops         unroll for-loops with a canonical induction variable\n", out);
+	fputs("  -fno-unroll-loops      disable loop unrolling (default)\n", out);
+	fputs("  --unroll-factor=N      copies of the body per partially unrolled iteration (default 4)\n", out);
+	fputs("  --unroll-limit=N       statement budget for an unrolled loop (default 64)\n", out);
+	fputs("  --specialize-limit=N   statement budget for clones specialized on literal arguments (default 64, 0 disables)\n", out);
+	fputs("  --eval-limit=N         step budget for evaluating pure calls with literal arguments (default 100000, 0 disables)\n", out);
+	fputs("  --memoize=auto|none    cache results of pure recursive functions (default none)\n", out);
+	fputs("  --bounds-check         trap on out-of-range array indices that cannot be proven safe\n", out);
+	fputs("  --int-semantics=lua|c32  int arithmetic as Lua integers or wrapping 32-bit C ints (default lua)\n", out);
+	fputs("  --lua-version=5.3|5.4  target Lua version; 5.4 declares never-reassigned locals <const> (default 5.3)\n", out);
+	fputs("  --profile-generate=FILE  count calls and loop iterations and write them to FILE when main returns\n", out);
+	fputs("  --profile-use=FILE     guide specialization, unrolling and function layout with counts from FILE\n", out);
+}
+
+static const char *option_value(const char *arg, const char *prefix)
+{
+	size_t len = strlen(prefix);
+	if (strncmp(arg, prefix, len) != 0)
+	{
+		return NULL;
+	}
+	return arg + len;
+}
+
+static int parse_size(const char *text, size_t *value)
+{
+	if (!text || *text < '0' || *text > '9')
+	{
+		return 0;
+	}
+	char *end = NULL;
+	unsigned long long parsed = strtoull(text, &end, 10);
+	if (!end || *end != '\0')
+	{
+		return 0;
+	}
+	*value = (size_t)parsed;
+	return 1;
+}
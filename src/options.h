@@ -0,0 +1,44 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum
+{
+	MEMOIZE_NONE,
+	MEMOIZE_AUTO
+} MemoizeMode;
+
+typedef enum
+{
+	INT_SEMANTICS_LUA,
+	INT_SEMANTICS_C32
+} IntSemantics;
+
+typedef enum
+{
+	LUA_VERSION_53,
+	LUA_VERSION_54
+} LuaVersion;
+
+typedef struct
+{
+	int unroll_loops;
+	size_t unroll_factor;
+	size_t unroll_limit;
+	MemoizeMode memoize;
+	size_t specialize_limit;
+	size_t eval_limit;
+	int bounds_check;
+	IntSemantics int_semantics;
+	LuaVersion lua_version;
+	const char *profile_generate;
+	const char *profile_use;
+} CompilerOptions;
+
+void compiler_options_init(CompilerOptions *options);
+int compiler_options_parse(CompilerOptions *options, const char *arg);
+void compiler_options_usage(FILE *out);
+
+#endif
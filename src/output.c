@@ -0,0 +1,183 @@
+#include "output.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define OUTPUT_INITIAL_CAPACITY 65536
+
+static const char INDENT_TABS[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
+static void reserve(OutputBuffer *out, size_t extra);
+static void output_unsigned(OutputBuffer *out, unsigned long long value, int negative);
+
+void output_init(OutputBuffer *out)
+{
+	out->data = NULL;
+	out->length = 0;
+	out->capacity = 0;
+}
+
+void output_free(OutputBuffer *out)
+{
+	free(out->data);
+	output_init(out);
+}
+
+/* Hands the NUL-terminated text to the caller, who frees it, and leaves the
+ * buffer empty. */
+char *output_release(OutputBuffer *out, size_t *length)
+{
+	reserve(out, 1);
+	out->data[out->length] = '\0';
+	char *data = out->data;
+	if (length)
+	{
+		*length = out->length;
+	}
+	output_init(out);
+	return data;
+}
+
+/* Writes everything with as few write calls as the descriptor allows; streams
+ * without one fall back to a single fwrite. */
+int output_flush(OutputBuffer *out, FILE *file)
+{
+	if (fflush(file) != 0)
+	{
+		return 0;
+	}
+	int fd = fileno(file);
+	if (fd < 0)
+	{
+		return fwrite(out->data, 1, out->length, file) == out->length && fflush(file) == 0;
+	}
+	size_t written = 0;
+	while (written < out->length)
+	{
+		ssize_t result = write(fd, out->data + written, out->length - written);
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return 0;
+		}
+		written += (size_t)result;
+	}
+	return 1;
+}
+
+void output_char(OutputBuffer *out, char c)
+{
+	if (out->length == out->capacity)
+	{
+		reserve(out, 1);
+	}
+	out->data[out->length++] = c;
+}
+
+void output_string(OutputBuffer *out, const char *text)
+{
+	output_bytes(out, text, strlen(text));
+}
+
+void output_bytes(OutputBuffer *out, const char *bytes, size_t length)
+{
+	reserve(out, length);
+	memcpy(out->data + out->length, bytes, length);
+	out->length += length;
+}
+
+void output_int(OutputBuffer *out, long long value)
+{
+	if (value < 0)
+	{
+		output_unsigned(out, 0ULL - (unsigned long long)value, 1);
+	}
+	else
+	{
+		output_unsigned(out, (unsigned long long)value, 0);
+	}
+}
+
+void output_size(OutputBuffer *out, size_t value)
+{
+	output_unsigned(out, value, 0);
+}
+
+void output_indent(OutputBuffer *out, int depth)
+{
+	size_t remaining = depth > 0 ? (size_t)depth : 0;
+	while (remaining > 0)
+	{
+		size_t chunk = remaining < sizeof(INDENT_TABS) - 1 ? remaining : sizeof(INDENT_TABS) - 1;
+		output_bytes(out, INDENT_TABS, chunk);
+		remaining -= chunk;
+	}
+}
+
+/* Formats straight into the buffer, growing it once if the text does not fit. */
+void output_format(OutputBuffer *out, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	va_list retry;
+	va_copy(retry, args);
+	size_t available = out->capacity - out->length;
+	int needed = vsnprintf(out->data ? out->data + out->length : NULL, available, format, args);
+	va_end(args);
+	if (needed < 0)
+	{
+		va_end(retry);
+		return;
+	}
+	if ((size_t)needed >= available)
+	{
+		reserve(out, (size_t)needed + 1);
+		vsnprintf(out->data + out->length, (size_t)needed + 1, format, retry);
+	}
+	va_end(retry);
+	out->length += (size_t)needed;
+}
+
+static void reserve(OutputBuffer *out, size_t extra)
+{
+	if (out->capacity - out->length >= extra)
+	{
+		return;
+	}
+	size_t needed = out->length + extra;
+	size_t new_capacity = out->capacity ? out->capacity * 2 : OUTPUT_INITIAL_CAPACITY;
+	while (new_capacity < needed)
+	{
+		new_capacity *= 2;
+	}
+	char *new_data = realloc(out->data, new_capacity);
+	if (!new_data)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	out->data = new_data;
+	out->capacity = new_capacity;
+}
+
+static void output_unsigned(OutputBuffer *out, unsigned long long value, int negative)
+{
+	char digits[24];
+	size_t start = sizeof(digits);
+	do
+	{
+		digits[--start] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value > 0);
+	if (negative)
+	{
+		digits[--start] = '-';
+	}
+	output_bytes(out, digits + start, sizeof(digits) - start);
+}
@@ -0,0 +1,29 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/* Growable byte buffer the code generator writes into; the finished text is
+ * written out in one go or handed to the caller. */
+typedef struct
+{
+	char *data;
+	size_t length;
+	size_t capacity;
+} OutputBuffer;
+
+void output_init(OutputBuffer *out);
+void output_free(OutputBuffer *out);
+char *output_release(OutputBuffer *out, size_t *length);
+int output_flush(OutputBuffer *out, FILE *file);
+
+void output_char(OutputBuffer *out, char c);
+void output_string(OutputBuffer *out, const char *text);
+void output_bytes(OutputBuffer *out, const char *bytes, size_t length);
+void output_int(OutputBuffer *out, long long value);
+void output_size(OutputBuffer *out, size_t value);
+void output_indent(OutputBuffer *out, int depth);
+void output_format(OutputBuffer *out, const char *format, ...);
+
+#endif
@@ -0,0 +1,416 @@
+#include "profile.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILE_LINE_MAX 512
+
+typedef struct
+{
+	char **names;
+	size_t count;
+	size_t capacity;
+	char *function;
+} Instrumenter;
+
+static void number_loops_in_statement(AstStmt *stmt, size_t *next);
+static void instrument_list(Instrumenter *inst, AstStmtList *list);
+static void instrument_loop_body(Instrumenter *inst, AstStmt **slot, size_t loop);
+static AstStmt *make_counter(Instrumenter *inst, const char *kind, size_t loop);
+static void insert_statement(AstStmtList *list, size_t index, AstStmt *stmt);
+static size_t loop_id(const AstStmt *stmt);
+static size_t source_name_length(const char *name);
+static const ProfileRecord *find_record(const Profile *profile, const char *function, size_t loop);
+static ProfileRecord *add_record(Profile *profile, const char *function, size_t loop);
+static char *dup_string(const char *src);
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed);
+
+/* Numbers the loops of each function from 1 in source order. Runs before the
+ * optimizer so the instrumented and the profile-guided build agree on the
+ * numbering; clones copy the numbers and loops the optimizer makes get 0. */
+void profile_number_loops(AstProgram *program)
+{
+	if (!program)
+	{
+		return;
+	}
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		AstFunction *fn = program->functions.items[i];
+		size_t next = 1;
+		for (size_t j = 0; j < fn->body.statements.count; ++j)
+		{
+			number_loops_in_statement(fn->body.statements.items[j], &next);
+		}
+	}
+}
+
+/* Counts calls of every function and entries and iterations of every numbered
+ * loop in a chunk-level table. The line each counter is written under is kept
+ * in a second table; specialized clones share the counters of their source
+ * function. */
+void profile_instrument(AstProgram *program)
+{
+	if (!program)
+	{
+		return;
+	}
+	Instrumenter inst = {0};
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		AstFunction *fn = program->functions.items[i];
+		size_t length = source_name_length(fn->name);
+		inst.function = malloc(length + 1);
+		if (!inst.function)
+		{
+			fprintf(stderr, "out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(inst.function, fn->name, length);
+		inst.function[length] = '\0';
+		AstStmt *calls = make_counter(&inst, "calls", 0);
+		instrument_list(&inst, &fn->body.statements);
+		insert_statement(&fn->body.statements, 0, calls);
+		free(inst.function);
+		inst.function = NULL;
+	}
+	if (inst.count == 0)
+	{
+		return;
+	}
+
+	AstExprList names = ast_expr_list_make();
+	for (size_t i = 0; i < inst.count; ++i)
+	{
+		AstExpr *name = ast_expr_make_string(inst.names[i]);
+		name->type = TYPE_STRING;
+		ast_expr_list_push(&names, name);
+	}
+	AstExpr *init = ast_expr_make_array_literal(&names);
+	init->type = TYPE_ARRAY;
+	ast_stmt_list_push(&program->constants, ast_stmt_make_array_decl(TYPE_STRING, dup_string(PROFILE_NAMES), inst.count, init));
+	ast_stmt_list_push(&program->constants, ast_stmt_make_array_decl(TYPE_INT, dup_string(PROFILE_COUNTERS), inst.count, NULL));
+	free(inst.names);
+}
+
+/* Reads "calls NAME COUNT", "entries NAME LOOP COUNT" and "trips NAME LOOP
+ * COUNT" lines. Repeated lines add up, so the profiles of several runs can
+ * simply be concatenated. */
+int profile_load(Profile *profile, const char *path)
+{
+	if (!profile || !path)
+	{
+		return 0;
+	}
+	FILE *file = fopen(path, "r");
+	if (!file)
+	{
+		fprintf(stderr, "failed to open '%s': %s\n", path, strerror(errno));
+		return 0;
+	}
+
+	char line[PROFILE_LINE_MAX];
+	char kind[16];
+	char name[PROFILE_LINE_MAX];
+	size_t line_number = 0;
+	while (fgets(line, sizeof(line), file))
+	{
+		++line_number;
+		size_t loop = 0;
+		long long count = 0;
+		int valid = 0;
+		if (sscanf(line, "%15s", kind) != 1)
+		{
+			continue;
+		}
+		if (strcmp(kind, "calls") == 0)
+		{
+			valid = sscanf(line, "%*s %511s %lld", name, &count) == 2;
+		}
+		else if (strcmp(kind, "entries") == 0 || strcmp(kind, "trips") == 0)
+		{
+			valid = sscanf(line, "%*s %511s %zu %lld", name, &loop, &count) == 3 && loop > 0;
+		}
+		if (!valid || count < 0)
+		{
+			fprintf(stderr, "%s:%zu: malformed profile line\n", path, line_number);
+			fclose(file);
+			return 0;
+		}
+		ProfileRecord *record = add_record(profile, name, loop);
+		if (strcmp(kind, "trips") == 0)
+		{
+			record->trips += count;
+		}
+		else
+		{
+			record->entries += count;
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+void profile_free(Profile *profile)
+{
+	if (!profile)
+	{
+		return;
+	}
+	for (size_t i = 0; i < profile->count; ++i)
+	{
+		free(profile->items[i].function);
+	}
+	free(profile->items);
+	profile->items = NULL;
+	profile->count = 0;
+	profile->capacity = 0;
+}
+
+/* The lookups return -1 for anything the profile has no line for. */
+long long profile_calls(const Profile *profile, const char *function)
+{
+	const ProfileRecord *record = find_record(profile, function, 0);
+	return record ? record->entries : -1;
+}
+
+long long profile_entries(const Profile *profile, const char *function, size_t loop)
+{
+	const ProfileRecord *record = loop > 0 ? find_record(profile, function, loop) : NULL;
+	return record ? record->entries : -1;
+}
+
+long long profile_trips(const Profile *profile, const char *function, size_t loop)
+{
+	const ProfileRecord *record = loop > 0 ? find_record(profile, function, loop) : NULL;
+	return record ? record->trips : -1;
+}
+
+static void number_loops_in_statement(AstStmt *stmt, size_t *next)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			number_loops_in_statement(stmt->data.block.statements.items[i], next);
+		}
+		break;
+	case STMT_WHILE:
+		stmt->data.while_stmt.profile_id = (*next)++;
+		number_loops_in_statement(stmt->data.while_stmt.body, next);
+		break;
+	case STMT_FOR:
+		stmt->data.for_stmt.profile_id = (*next)++;
+		number_loops_in_statement(stmt->data.for_stmt.body, next);
+		break;
+	default:
+		break;
+	}
+}
+
+static void instrument_list(Instrumenter *inst, AstStmtList *list)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmt *stmt = list->items[i];
+		switch (stmt->kind)
+		{
+		case STMT_BLOCK:
+			instrument_list(inst, &stmt->data.block.statements);
+			break;
+		case STMT_WHILE:
+		case STMT_FOR:
+		{
+			size_t loop = loop_id(stmt);
+			if (loop > 0)
+			{
+				insert_statement(list, i, make_counter(inst, "entries", loop));
+				++i;
+			}
+			if (stmt->kind == STMT_WHILE)
+			{
+				instrument_loop_body(inst, &stmt->data.while_stmt.body, loop);
+			}
+			else
+			{
+				instrument_loop_body(inst, &stmt->data.for_stmt.body, loop);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+}
+
+static void instrument_loop_body(Instrumenter *inst, AstStmt **slot, size_t loop)
+{
+	AstStmt *body = *slot;
+	if (!body || body->kind != STMT_BLOCK)
+	{
+		AstStmtList statements = ast_stmt_list_make();
+		if (body)
+		{
+			ast_stmt_list_push(&statements, body);
+		}
+		AstBlock block = ast_block_from_list(&statements);
+		body = ast_stmt_make_block(&block);
+		*slot = body;
+	}
+	AstStmt *trips = loop > 0 ? make_counter(inst, "trips", loop) : NULL;
+	instrument_list(inst, &body->data.block.statements);
+	if (trips)
+	{
+		insert_statement(&body->data.block.statements, 0, trips);
+	}
+}
+
+/* __profile[k] = __profile[k] + 1 for the counter of the given line. */
+static AstStmt *make_counter(Instrumenter *inst, const char *kind, size_t loop)
+{
+	char buffer[PROFILE_LINE_MAX];
+	if (loop > 0)
+	{
+		snprintf(buffer, sizeof(buffer), "%s %s %zu", kind, inst->function, loop);
+	}
+	else
+	{
+		snprintf(buffer, sizeof(buffer), "%s %s", kind, inst->function);
+	}
+	size_t slot = 0;
+	while (slot < inst->count && strcmp(inst->names[slot], buffer) != 0)
+	{
+		++slot;
+	}
+	if (slot == inst->count)
+	{
+		ensure_capacity((void **)&inst->names, sizeof(char *), &inst->capacity, inst->count + 1);
+		inst->names[inst->count++] = dup_string(buffer);
+	}
+
+	AstExpr *array = ast_expr_make_identifier(dup_string(PROFILE_COUNTERS));
+	array->type = TYPE_ARRAY;
+	AstExpr *index = ast_expr_make_int((long long)slot);
+	index->type = TYPE_INT;
+	AstExpr *current = ast_expr_make_subscript(array, index);
+	current->type = TYPE_INT;
+	AstExpr *one = ast_expr_make_int(1);
+	one->type = TYPE_INT;
+	AstExpr *sum = ast_expr_make_binary(BIN_OP_ADD, current, one);
+	sum->type = TYPE_INT;
+	AstExpr *target = ast_expr_make_int((long long)slot);
+	target->type = TYPE_INT;
+	AstStmt *store = ast_stmt_make_array_assign(dup_string(PROFILE_COUNTERS), target, sum);
+	store->data.array_assign.element_type = TYPE_INT;
+	return store;
+}
+
+static void insert_statement(AstStmtList *list, size_t index, AstStmt *stmt)
+{
+	ast_stmt_list_push(list, stmt);
+	memmove(&list->items[index + 1], &list->items[index], (list->count - index - 1) * sizeof(AstStmt *));
+	list->items[index] = stmt;
+}
+
+static size_t loop_id(const AstStmt *stmt)
+{
+	return stmt->kind == STMT_WHILE ? stmt->data.while_stmt.profile_id : stmt->data.for_stmt.profile_id;
+}
+
+/* Specialized clones are named NAME__specN and are profiled as NAME. */
+static size_t source_name_length(const char *name)
+{
+	size_t length = strlen(name);
+	size_t digits = length;
+	while (digits > 0 && name[digits - 1] >= '0' && name[digits - 1] <= '9')
+	{
+		--digits;
+	}
+	if (digits < length && digits > 6 && strncmp(name + digits - 6, "__spec", 6) == 0)
+	{
+		return digits - 6;
+	}
+	return length;
+}
+
+static const ProfileRecord *find_record(const Profile *profile, const char *function, size_t loop)
+{
+	if (!profile || !function)
+	{
+		return NULL;
+	}
+	size_t length = source_name_length(function);
+	for (size_t i = 0; i < profile->count; ++i)
+	{
+		const ProfileRecord *record = &profile->items[i];
+		if (record->loop == loop && strlen(record->function) == length && strncmp(record->function, function, length) == 0)
+		{
+			return record;
+		}
+	}
+	return NULL;
+}
+
+static ProfileRecord *add_record(Profile *profile, const char *function, size_t loop)
+{
+	for (size_t i = 0; i < profile->count; ++i)
+	{
+		if (profile->items[i].loop == loop && strcmp(profile->items[i].function, function) == 0)
+		{
+			return &profile->items[i];
+		}
+	}
+	ensure_capacity((void **)&profile->items, sizeof(ProfileRecord), &profile->capacity, profile->count + 1);
+	ProfileRecord *record = &profile->items[profile->count++];
+	record->function = dup_string(function);
+	record->loop = loop;
+	record->entries = 0;
+	record->trips = 0;
+	return record;
+}
+
+static char *dup_string(const char *src)
+{
+	if (!src)
+	{
+		return NULL;
+	}
+	size_t len = strlen(src);
+	char *copy = malloc(len + 1);
+	if (!copy)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(copy, src, len + 1);
+	return copy;
+}
+
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed)
+{
+	if (*capacity >= needed)
+	{
+		return;
+	}
+	size_t new_capacity = (*capacity == 0) ? 4 : (*capacity * 2);
+	while (new_capacity < needed)
+	{
+		new_capacity *= 2;
+	}
+	void *new_buffer = realloc(*buffer, new_capacity * elem_size);
+	if (!new_buffer)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	*buffer = new_buffer;
+	*capacity = new_capacity;
+}
@@ -0,0 +1,42 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stddef.h>
+
+#include "ast.h"
+
+/* Chunk-level tables of an instrumented build: the counters, and the profile
+ * line each one is written under. */
+#define PROFILE_COUNTERS "__profile"
+#define PROFILE_NAMES "__profile_names"
+
+/* One line of a profile file: how often a function was called (loop 0), or
+ * how often a loop was entered and how many iterations it ran in total. */
+typedef struct
+{
+	char *function;
+	size_t loop;
+	long long entries;
+	long long trips;
+} ProfileRecord;
+
+typedef struct
+{
+	ProfileRecord *items;
+	size_t count;
+	size_t capacity;
+} Profile;
+
+/* Consumers: call counts order specialization and function layout, loop counts
+ * gate unrolling. There is no inliner for call counts to drive, and loops are
+ * the only branches the grammar has, so loop counts stand in for branch
+ * frequencies. */
+void profile_number_loops(AstProgram *program);
+void profile_instrument(AstProgram *program);
+int profile_load(Profile *profile, const char *path);
+void profile_free(Profile *profile);
+long long profile_calls(const Profile *profile, const char *function);
+long long profile_entries(const Profile *profile, const char *function, size_t loop);
+long long profile_trips(const Profile *profile, const char *function, size_t loop);
+
+#endif
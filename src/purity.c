@@ -0,0 +1,264 @@
+#include "purity.h"
+
+#include <string.h>
+
+static int function_may_be_pure(const AstFunction *fn, const FunctionTable *functions);
+static int statement_may_be_pure(const AstStmt *stmt, const FunctionTable *functions);
+static int expression_may_be_pure(const AstExpr *expr, const FunctionTable *functions);
+static int statement_calls(const AstStmt *stmt, const char *callee);
+static int expression_calls(const AstExpr *expr, const char *callee);
+static FunctionSignature *find_signature(FunctionTable *functions, const char *name);
+
+/* Optimistic fixed point: every function with scalar parameters starts out
+ * pure and loses the mark once it performs I/O or calls an impure function,
+ * so mutually recursive pure functions stay pure. */
+void purity_analyze(const AstProgram *program, FunctionTable *functions)
+{
+	if (!program || !functions)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		const AstFunction *fn = program->functions.items[i];
+		FunctionSignature *signature = find_signature(functions, fn->name);
+		if (!signature)
+		{
+			continue;
+		}
+		signature->is_pure = strcmp(fn->name, "main") != 0;
+		for (size_t p = 0; p < fn->params.count; ++p)
+		{
+			if (fn->params.items[p].type == TYPE_ARRAY)
+			{
+				signature->is_pure = 0;
+			}
+		}
+	}
+
+	int changed = 1;
+	while (changed)
+	{
+		changed = 0;
+		for (size_t i = 0; i < program->functions.count; ++i)
+		{
+			const AstFunction *fn = program->functions.items[i];
+			FunctionSignature *signature = find_signature(functions, fn->name);
+			if (signature && signature->is_pure && !function_may_be_pure(fn, functions))
+			{
+				signature->is_pure = 0;
+				changed = 1;
+			}
+		}
+	}
+}
+
+int purity_function_calls(const AstFunction *fn, const char *callee)
+{
+	if (!fn || !callee)
+	{
+		return 0;
+	}
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		if (statement_calls(fn->body.statements.items[i], callee))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int function_may_be_pure(const AstFunction *fn, const FunctionTable *functions)
+{
+	for (size_t i = 0; i < fn->body.statements.count; ++i)
+	{
+		if (!statement_may_be_pure(fn->body.statements.items[i], functions))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static int statement_may_be_pure(const AstStmt *stmt, const FunctionTable *functions)
+{
+	if (!stmt)
+	{
+		return 1;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (!statement_may_be_pure(stmt->data.block.statements.items[i], functions))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case STMT_DECL:
+		return expression_may_be_pure(stmt->data.decl.init, functions) &&
+			   expression_may_be_pure(stmt->data.decl.array_init, functions);
+	case STMT_ASSIGN:
+		return expression_may_be_pure(stmt->data.assign.value, functions);
+	case STMT_ARRAY_ASSIGN:
+		return expression_may_be_pure(stmt->data.array_assign.index, functions) &&
+			   expression_may_be_pure(stmt->data.array_assign.value, functions);
+	case STMT_WHILE:
+		return expression_may_be_pure(stmt->data.while_stmt.condition, functions) &&
+			   statement_may_be_pure(stmt->data.while_stmt.body, functions);
+	case STMT_FOR:
+		return statement_may_be_pure(stmt->data.for_stmt.init, functions) &&
+			   expression_may_be_pure(stmt->data.for_stmt.condition, functions) &&
+			   statement_may_be_pure(stmt->data.for_stmt.post, functions) &&
+			   statement_may_be_pure(stmt->data.for_stmt.body, functions);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return expression_may_be_pure(stmt->data.expr, functions);
+	}
+	return 0;
+}
+
+static int expression_may_be_pure(const AstExpr *expr, const FunctionTable *functions)
+{
+	if (!expr)
+	{
+		return 1;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		return expression_may_be_pure(expr->data.binary.left, functions) &&
+			   expression_may_be_pure(expr->data.binary.right, functions);
+	case EXPR_UNARY:
+		return expression_may_be_pure(expr->data.unary.operand, functions);
+	case EXPR_CALL:
+	{
+		const FunctionSignature *callee = function_table_find(functions, expr->data.call.callee);
+		if (!callee || !callee->is_pure)
+		{
+			return 0;
+		}
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			if (!expression_may_be_pure(expr->data.call.args.items[i], functions))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	}
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (!expression_may_be_pure(expr->data.array_literal.elements.items[i], functions))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case EXPR_SUBSCRIPT:
+		return expression_may_be_pure(expr->data.subscript.array, functions) &&
+			   expression_may_be_pure(expr->data.subscript.index, functions);
+	default:
+		return 1;
+	}
+}
+
+static int statement_calls(const AstStmt *stmt, const char *callee)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (statement_calls(stmt->data.block.statements.items[i], callee))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case STMT_DECL:
+		return expression_calls(stmt->data.decl.init, callee) || expression_calls(stmt->data.decl.array_init, callee);
+	case STMT_ASSIGN:
+		return expression_calls(stmt->data.assign.value, callee);
+	case STMT_ARRAY_ASSIGN:
+		return expression_calls(stmt->data.array_assign.index, callee) ||
+			   expression_calls(stmt->data.array_assign.value, callee);
+	case STMT_WHILE:
+		return expression_calls(stmt->data.while_stmt.condition, callee) ||
+			   statement_calls(stmt->data.while_stmt.body, callee);
+	case STMT_FOR:
+		return statement_calls(stmt->data.for_stmt.init, callee) ||
+			   expression_calls(stmt->data.for_stmt.condition, callee) ||
+			   statement_calls(stmt->data.for_stmt.post, callee) || statement_calls(stmt->data.for_stmt.body, callee);
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return expression_calls(stmt->data.expr, callee);
+	}
+	return 0;
+}
+
+static int expression_calls(const AstExpr *expr, const char *callee)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		return expression_calls(expr->data.binary.left, callee) || expression_calls(expr->data.binary.right, callee);
+	case EXPR_UNARY:
+		return expression_calls(expr->data.unary.operand, callee);
+	case EXPR_CALL:
+		if (strcmp(expr->data.call.callee, callee) == 0)
+		{
+			return 1;
+		}
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			if (expression_calls(expr->data.call.args.items[i], callee))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			if (expression_calls(expr->data.array_literal.elements.items[i], callee))
+			{
+				return 1;
+			}
+		}
+		return 0;
+	case EXPR_SUBSCRIPT:
+		return expression_calls(expr->data.subscript.array, callee) || expression_calls(expr->data.subscript.index, callee);
+	default:
+		return 0;
+	}
+}
+
+static FunctionSignature *find_signature(FunctionTable *functions, const char *name)
+{
+	for (size_t i = 0; i < functions->count; ++i)
+	{
+		if (strcmp(functions->items[i].name, name) == 0)
+		{
+			return &functions->items[i];
+		}
+	}
+	return NULL;
+}
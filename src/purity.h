@@ -0,0 +1,10 @@
+#ifndef PURITY_H
+#define PURITY_H
+
+#include "ast.h"
+#include "symbol_table.h"
+
+void purity_analyze(const AstProgram *program, FunctionTable *functions);
+int purity_function_calls(const AstFunction *fn, const char *callee);
+
+#endif
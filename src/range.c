@@ -0,0 +1,676 @@
+#include "range.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RANGE_LIMIT 2147483647LL
+
+typedef struct
+{
+	long long low;
+	long long high;
+	int known;
+} Range;
+
+typedef struct
+{
+	const char *name;
+	int tracked;
+	int is_array;
+	size_t array_size;
+	Range range;
+} Binding;
+
+typedef struct
+{
+	Binding *items;
+	size_t count;
+	size_t capacity;
+	int check_bounds;
+	int c32;
+} Environment;
+
+static void analyze_function(AstFunction *fn, const CompilerOptions *options);
+static void analyze_block(AstBlock *block, Environment *env);
+static void analyze_statement(AstStmt *stmt, Environment *env);
+static void analyze_loop(AstExpr *condition, AstStmt *body, AstStmt *post, Environment *env);
+static void analyze_expression(AstExpr *expr, Environment *env);
+static AstIntOp choose_int_op(const AstExpr *expr, const Environment *env);
+static void defer_wrap(AstExpr *expr);
+static int match_induction(const AstExpr *condition, const Environment *env, const char **name, const AstExpr **bound, int *direction, int *inclusive);
+static int steps_monotonic(const AstStmt *stmt, const char *name, int direction);
+static int count_steps(const AstStmt *stmt, const char *name, int nested, long long *step);
+static int match_step(const AstStmt *stmt, const char *name, long long *step);
+static void forget_assigned(Environment *env, const AstStmt *stmt);
+static Range range_of(const AstExpr *expr, const Environment *env);
+static Range make_range(long long low, long long high);
+static Range unknown_range(void);
+static int index_in_bounds(Range index, size_t size);
+static void bind(Environment *env, const char *name, int tracked, int is_array, size_t array_size, Range range);
+static Binding *lookup(const Environment *env, const char *name);
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed);
+
+/* Value ranges of int locals, used to drop the array index checks of
+ * --bounds-check and the 32-bit wrapping of --int-semantics=c32 wherever they
+ * cannot matter. Ranges are tracked through straight-line code; a loop forgets
+ * whatever its body assigns, except for an induction variable that only moves
+ * toward its exit test, which keeps [entry value, bound] inside the body. */
+void range_analyze(AstProgram *program, const CompilerOptions *options)
+{
+	if (!program || !options || (!options->bounds_check && options->int_semantics != INT_SEMANTICS_C32))
+	{
+		return;
+	}
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		analyze_function(program->functions.items[i], options);
+	}
+}
+
+static void analyze_function(AstFunction *fn, const CompilerOptions *options)
+{
+	Environment env = {0};
+	env.check_bounds = options->bounds_check;
+	env.c32 = options->int_semantics == INT_SEMANTICS_C32;
+	for (size_t i = 0; i < fn->params.count; ++i)
+	{
+		const AstParam *param = &fn->params.items[i];
+		bind(&env, param->name, param->type == TYPE_INT, param->type == TYPE_ARRAY, 0, unknown_range());
+	}
+	analyze_block(&fn->body, &env);
+	free(env.items);
+}
+
+static void analyze_block(AstBlock *block, Environment *env)
+{
+	size_t mark = env->count;
+	for (size_t i = 0; i < block->statements.count; ++i)
+	{
+		analyze_statement(block->statements.items[i], env);
+	}
+	env->count = mark;
+}
+
+static void analyze_statement(AstStmt *stmt, Environment *env)
+{
+	if (!stmt)
+	{
+		return;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		analyze_block(&stmt->data.block, env);
+		break;
+	case STMT_DECL:
+		if (stmt->data.decl.is_array)
+		{
+			analyze_expression(stmt->data.decl.array_init, env);
+			bind(env, stmt->data.decl.name, 0, 1, stmt->data.decl.array_size, unknown_range());
+		}
+		else
+		{
+			analyze_expression(stmt->data.decl.init, env);
+			Range range = stmt->data.decl.init ? range_of(stmt->data.decl.init, env) : unknown_range();
+			bind(env, stmt->data.decl.name, stmt->data.decl.type == TYPE_INT, 0, 0, range);
+		}
+		break;
+	case STMT_ASSIGN:
+	{
+		analyze_expression(stmt->data.assign.value, env);
+		Binding *binding = lookup(env, stmt->data.assign.name);
+		if (binding && binding->tracked)
+		{
+			binding->range = range_of(stmt->data.assign.value, env);
+		}
+		break;
+	}
+	case STMT_ARRAY_ASSIGN:
+	{
+		analyze_expression(stmt->data.array_assign.index, env);
+		analyze_expression(stmt->data.array_assign.value, env);
+		Binding *binding = lookup(env, stmt->data.array_assign.name);
+		size_t size = (binding && binding->is_array) ? binding->array_size : 0;
+		stmt->data.array_assign.array_size = size;
+		stmt->data.array_assign.bounds_check = env->check_bounds && !index_in_bounds(range_of(stmt->data.array_assign.index, env), size);
+		break;
+	}
+	case STMT_WHILE:
+		analyze_loop(stmt->data.while_stmt.condition, stmt->data.while_stmt.body, NULL, env);
+		break;
+	case STMT_FOR:
+	{
+		size_t mark = env->count;
+		analyze_statement(stmt->data.for_stmt.init, env);
+		analyze_loop(stmt->data.for_stmt.condition, stmt->data.for_stmt.body, stmt->data.for_stmt.post, env);
+		env->count = mark;
+		break;
+	}
+	case STMT_EXPR:
+		analyze_expression(stmt->data.expr, env);
+		break;
+	case STMT_RETURN:
+		analyze_expression(stmt->data.expr, env);
+		break;
+	}
+}
+
+static void analyze_loop(AstExpr *condition, AstStmt *body, AstStmt *post, Environment *env)
+{
+	const char *name = NULL;
+	const AstExpr *bound = NULL;
+	int direction = 0;
+	int inclusive = 0;
+	int induction = match_induction(condition, env, &name, &bound, &direction, &inclusive) &&
+					steps_monotonic(body, name, direction) && steps_monotonic(post, name, direction);
+
+	size_t count = env->count;
+	Range *entry = NULL;
+	size_t capacity = 0;
+	ensure_capacity((void **)&entry, sizeof(Range), &capacity, count + 1);
+	for (size_t i = 0; i < count; ++i)
+	{
+		entry[i] = env->items[i].range;
+	}
+
+	forget_assigned(env, body);
+	forget_assigned(env, post);
+	analyze_expression(condition, env);
+
+	Binding *binding = induction ? lookup(env, name) : NULL;
+	Range limit = induction ? range_of(bound, env) : unknown_range();
+	if (binding && limit.known && entry[binding - env->items].known)
+	{
+		Range start = entry[binding - env->items];
+		if (direction > 0)
+		{
+			binding->range = make_range(start.low, inclusive ? limit.high : limit.high - 1);
+		}
+		else
+		{
+			binding->range = make_range(inclusive ? limit.low : limit.low + 1, start.high);
+		}
+
+		/* With one step per iteration the trip count is bounded, and so is
+		 * every other variable stepped exactly once per iteration. */
+		long long step = 0;
+		if (binding->range.known && count_steps(body, name, 0, &step) + count_steps(post, name, 0, &step) == 1 && step != 0)
+		{
+			long long trips = direction > 0 ? (binding->range.high - start.low) / step
+											: (start.high - binding->range.low) / -step;
+			for (size_t i = 0; i < count && trips >= 0 && trips <= RANGE_LIMIT; ++i)
+			{
+				Binding *other = &env->items[i];
+				long long other_step = 0;
+				if (other == binding || !other->tracked || !entry[i].known || lookup(env, other->name) != other ||
+					count_steps(body, other->name, 0, &other_step) + count_steps(post, other->name, 0, &other_step) != 1)
+				{
+					continue;
+				}
+				other->range = make_range(entry[i].low + (other_step < 0 ? other_step * trips : 0),
+										  entry[i].high + (other_step > 0 ? other_step * trips : 0));
+			}
+		}
+	}
+	free(entry);
+
+	analyze_statement(body, env);
+	analyze_statement(post, env);
+	forget_assigned(env, body);
+	forget_assigned(env, post);
+}
+
+static void analyze_expression(AstExpr *expr, Environment *env)
+{
+	if (!expr)
+	{
+		return;
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		analyze_expression(expr->data.binary.left, env);
+		analyze_expression(expr->data.binary.right, env);
+		if (env->c32 && expr->type == TYPE_INT)
+		{
+			expr->data.binary.int_op = choose_int_op(expr, env);
+		}
+		if (expr->data.binary.int_op == INT_OP_WRAP32)
+		{
+			defer_wrap(expr->data.binary.left);
+			defer_wrap(expr->data.binary.right);
+		}
+		break;
+	case EXPR_UNARY:
+		analyze_expression(expr->data.unary.operand, env);
+		if (env->c32 && expr->type == TYPE_INT && expr->data.unary.op == UN_OP_NEG)
+		{
+			expr->data.unary.int_op = choose_int_op(expr, env);
+		}
+		if (expr->data.unary.int_op == INT_OP_WRAP32)
+		{
+			defer_wrap(expr->data.unary.operand);
+		}
+		break;
+	case EXPR_CALL:
+		for (size_t i = 0; i < expr->data.call.args.count; ++i)
+		{
+			analyze_expression(expr->data.call.args.items[i], env);
+		}
+		break;
+	case EXPR_ARRAY_LITERAL:
+		for (size_t i = 0; i < expr->data.array_literal.elements.count; ++i)
+		{
+			analyze_expression(expr->data.array_literal.elements.items[i], env);
+		}
+		break;
+	case EXPR_SUBSCRIPT:
+	{
+		analyze_expression(expr->data.subscript.index, env);
+		const AstExpr *array = expr->data.subscript.array;
+		if (!array || array->kind != EXPR_IDENTIFIER)
+		{
+			break;
+		}
+		Binding *binding = lookup(env, array->data.identifier);
+		size_t size = (binding && binding->is_array) ? binding->array_size : 0;
+		expr->data.subscript.array_size = size;
+		expr->data.subscript.bounds_check = env->check_bounds && !index_in_bounds(range_of(expr->data.subscript.index, env), size);
+		break;
+	}
+	case EXPR_INT_LITERAL:
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+	case EXPR_STRING_LITERAL:
+	case EXPR_IDENTIFIER:
+		break;
+	}
+}
+
+/* Wrapping is only needed when the exact result may leave the int range, and
+ * '/' and '%' only need C truncation when an operand may be negative. */
+static AstIntOp choose_int_op(const AstExpr *expr, const Environment *env)
+{
+	if (expr->kind == EXPR_UNARY)
+	{
+		return range_of(expr, env).known ? INT_OP_LUA : INT_OP_WRAP32;
+	}
+
+	Range left = range_of(expr->data.binary.left, env);
+	Range right = range_of(expr->data.binary.right, env);
+	switch (expr->data.binary.op)
+	{
+	case BIN_OP_ADD:
+	case BIN_OP_SUB:
+	case BIN_OP_MUL:
+		return range_of(expr, env).known ? INT_OP_LUA : INT_OP_WRAP32;
+	case BIN_OP_DIV:
+	case BIN_OP_MOD:
+		return (left.known && right.known && left.low >= 0 && right.low >= 1) ? INT_OP_FLOOR : INT_OP_TRUNC;
+	default:
+		return INT_OP_LUA;
+	}
+}
+
+/* Lua integers wrap modulo 2^64, so a chain of + - * only needs to be
+ * brought back to 32 bits once, where the chain ends. */
+static void defer_wrap(AstExpr *expr)
+{
+	if (expr->kind == EXPR_BINARY && expr->data.binary.int_op == INT_OP_WRAP32)
+	{
+		expr->data.binary.int_op = INT_OP_LUA;
+	}
+	else if (expr->kind == EXPR_UNARY && expr->data.unary.int_op == INT_OP_WRAP32)
+	{
+		expr->data.unary.int_op = INT_OP_LUA;
+	}
+}
+
+static int match_induction(const AstExpr *condition, const Environment *env, const char **name, const AstExpr **bound, int *direction, int *inclusive)
+{
+	if (!condition || condition->kind != EXPR_BINARY)
+	{
+		return 0;
+	}
+
+	AstBinaryOp op = condition->data.binary.op;
+	const AstExpr *left = condition->data.binary.left;
+	const AstExpr *right = condition->data.binary.right;
+	if (right && right->kind == EXPR_IDENTIFIER && !(left && left->kind == EXPR_IDENTIFIER))
+	{
+		const AstExpr *swap = left;
+		left = right;
+		right = swap;
+		switch (op)
+		{
+		case BIN_OP_LT:
+			op = BIN_OP_GT;
+			break;
+		case BIN_OP_LE:
+			op = BIN_OP_GE;
+			break;
+		case BIN_OP_GT:
+			op = BIN_OP_LT;
+			break;
+		case BIN_OP_GE:
+			op = BIN_OP_LE;
+			break;
+		default:
+			break;
+		}
+	}
+	if (!left || left->kind != EXPR_IDENTIFIER || !right)
+	{
+		return 0;
+	}
+
+	Binding *binding = lookup(env, left->data.identifier);
+	if (!binding || !binding->tracked)
+	{
+		return 0;
+	}
+
+	switch (op)
+	{
+	case BIN_OP_LT:
+	case BIN_OP_LE:
+		*direction = 1;
+		break;
+	case BIN_OP_GT:
+	case BIN_OP_GE:
+		*direction = -1;
+		break;
+	default:
+		return 0;
+	}
+	*inclusive = op == BIN_OP_LE || op == BIN_OP_GE;
+	*name = left->data.identifier;
+	*bound = right;
+	return 1;
+}
+
+static int steps_monotonic(const AstStmt *stmt, const char *name, int direction)
+{
+	if (!stmt)
+	{
+		return 1;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			if (!steps_monotonic(stmt->data.block.statements.items[i], name, direction))
+			{
+				return 0;
+			}
+		}
+		return 1;
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) != 0;
+	case STMT_ASSIGN:
+	{
+		long long step = 0;
+		if (strcmp(stmt->data.assign.name, name) != 0)
+		{
+			return 1;
+		}
+		if (!match_step(stmt, name, &step))
+		{
+			return 0;
+		}
+		return direction > 0 ? step >= 0 : step <= 0;
+	}
+	case STMT_WHILE:
+		return steps_monotonic(stmt->data.while_stmt.body, name, direction);
+	case STMT_FOR:
+		return steps_monotonic(stmt->data.for_stmt.init, name, direction) &&
+			   steps_monotonic(stmt->data.for_stmt.post, name, direction) &&
+			   steps_monotonic(stmt->data.for_stmt.body, name, direction);
+	case STMT_ARRAY_ASSIGN:
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return 1;
+	}
+	return 1;
+}
+
+/* Number of times one iteration assigns the variable, or a large count when
+ * an assignment is not a constant step or sits inside a nested loop. */
+static int count_steps(const AstStmt *stmt, const char *name, int nested, long long *step)
+{
+	if (!stmt)
+	{
+		return 0;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+	{
+		int total = 0;
+		for (size_t i = 0; i < stmt->data.block.statements.count; ++i)
+		{
+			total += count_steps(stmt->data.block.statements.items[i], name, nested, step);
+			if (total > 1)
+			{
+				return 2;
+			}
+		}
+		return total;
+	}
+	case STMT_DECL:
+		return strcmp(stmt->data.decl.name, name) == 0 ? 2 : 0;
+	case STMT_ASSIGN:
+		if (strcmp(stmt->data.assign.name, name) != 0)
+		{
+			return 0;
+		}
+		return (!nested && match_step(stmt, name, step)) ? 1 : 2;
+	case STMT_WHILE:
+		return count_steps(stmt->data.while_stmt.body, name, 1, step) ? 2 : 0;
+	case STMT_FOR:
+		return (count_steps(stmt->data.for_stmt.init, name, 1, step) ||
+				count_steps(stmt->data.for_stmt.post, name, 1, step) ||
+				count_steps(stmt->data.for_stmt.body, name, 1, step))
+				   ? 2
+				   : 0;
+	case STMT_ARRAY_ASSIGN:
+	case STMT_EXPR:
+	case STMT_RETURN:
+		return 0;
+	}
+	return 0;
+}
+
+static int match_step(const AstStmt *stmt, const char *name, long long *step)
+{
+	const AstExpr *value = stmt->data.assign.value;
+	if (!value || value->kind != EXPR_BINARY ||
+		(value->data.binary.op != BIN_OP_ADD && value->data.binary.op != BIN_OP_SUB))
+	{
+		return 0;
+	}
+	const AstExpr *left = value->data.binary.left;
+	const AstExpr *right = value->data.binary.right;
+	if (value->data.binary.op == BIN_OP_ADD && left->kind == EXPR_INT_LITERAL)
+	{
+		const AstExpr *swap = left;
+		left = right;
+		right = swap;
+	}
+	if (left->kind != EXPR_IDENTIFIER || strcmp(left->data.identifier, name) != 0 ||
+		right->kind != EXPR_INT_LITERAL || right->data.int_value < -RANGE_LIMIT || right->data.int_value > RANGE_LIMIT)
+	{
+		return 0;
+	}
+	*step = value->data.binary.op == BIN_OP_ADD ? right->data.int_value : -right->data.int_value;
+	return 1;
+}
+
+static void forget_assigned(Environment *env, const AstStmt *stmt)
+{
+	if (!stmt)
+	{
+		return;
+	}
+	for (size_t i = 0; i < env->count; ++i)
+	{
+		Binding *binding = &env->items[i];
+		if (binding->tracked && ast_stmt_assigns(stmt, binding->name))
+		{
+			binding->range = unknown_range();
+		}
+	}
+}
+
+static Range range_of(const AstExpr *expr, const Environment *env)
+{
+	if (!expr)
+	{
+		return unknown_range();
+	}
+
+	switch (expr->kind)
+	{
+	case EXPR_INT_LITERAL:
+		return make_range(expr->data.int_value, expr->data.int_value);
+	case EXPR_IDENTIFIER:
+	{
+		Binding *binding = lookup(env, expr->data.identifier);
+		return (binding && binding->tracked) ? binding->range : unknown_range();
+	}
+	case EXPR_UNARY:
+	{
+		Range operand = range_of(expr->data.unary.operand, env);
+		if (!operand.known || expr->data.unary.op == UN_OP_NOT)
+		{
+			return unknown_range();
+		}
+		return expr->data.unary.op == UN_OP_NEG ? make_range(-operand.high, -operand.low) : operand;
+	}
+	case EXPR_BINARY:
+	{
+		Range left = range_of(expr->data.binary.left, env);
+		Range right = range_of(expr->data.binary.right, env);
+		if (expr->data.binary.op == BIN_OP_MOD && right.known && right.low >= 1)
+		{
+			/* Lua's % takes the sign of the divisor, C's the sign of the dividend. */
+			if (left.known && left.low >= 0)
+			{
+				return make_range(0, left.high < right.high - 1 ? left.high : right.high - 1);
+			}
+			return env->c32 ? make_range(-(right.high - 1), right.high - 1) : make_range(0, right.high - 1);
+		}
+		if (!left.known || !right.known)
+		{
+			return unknown_range();
+		}
+		switch (expr->data.binary.op)
+		{
+		case BIN_OP_ADD:
+			return make_range(left.low + right.low, left.high + right.high);
+		case BIN_OP_SUB:
+			return make_range(left.low - right.high, left.high - right.low);
+		case BIN_OP_MUL:
+		{
+			long long products[4] = {left.low * right.low, left.low * right.high, left.high * right.low, left.high * right.high};
+			long long low = products[0];
+			long long high = products[0];
+			for (size_t i = 1; i < 4; ++i)
+			{
+				low = products[i] < low ? products[i] : low;
+				high = products[i] > high ? products[i] : high;
+			}
+			return make_range(low, high);
+		}
+		case BIN_OP_DIV:
+			/* Lua's / always yields a float; C division of non-negative ints floors. */
+			if (!env->c32 || left.low < 0 || right.low < 1)
+			{
+				return unknown_range();
+			}
+			return make_range(left.low / right.high, left.high / right.low);
+		default:
+			return unknown_range();
+		}
+	}
+	case EXPR_FLOAT_LITERAL:
+	case EXPR_BOOL_LITERAL:
+	case EXPR_STRING_LITERAL:
+	case EXPR_CALL:
+	case EXPR_ARRAY_LITERAL:
+	case EXPR_SUBSCRIPT:
+		return unknown_range();
+	}
+	return unknown_range();
+}
+
+static Range make_range(long long low, long long high)
+{
+	Range range = {low, high, 1};
+	if (low < -RANGE_LIMIT || high > RANGE_LIMIT)
+	{
+		return unknown_range();
+	}
+	return range;
+}
+
+static Range unknown_range(void)
+{
+	Range range = {0, 0, 0};
+	return range;
+}
+
+static int index_in_bounds(Range index, size_t size)
+{
+	return index.known && index.low >= 0 && size > 0 && (unsigned long long)index.high < size;
+}
+
+static void bind(Environment *env, const char *name, int tracked, int is_array, size_t array_size, Range range)
+{
+	ensure_capacity((void **)&env->items, sizeof(Binding), &env->capacity, env->count + 1);
+	Binding *binding = &env->items[env->count++];
+	binding->name = name;
+	binding->tracked = tracked;
+	binding->is_array = is_array;
+	binding->array_size = array_size;
+	binding->range = tracked ? range : unknown_range();
+}
+
+static Binding *lookup(const Environment *env, const char *name)
+{
+	for (size_t i = env->count; i > 0; --i)
+	{
+		if (strcmp(env->items[i - 1].name, name) == 0)
+		{
+			return &env->items[i - 1];
+		}
+	}
+	return NULL;
+}
+
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed)
+{
+	if (*capacity >= needed)
+	{
+		return;
+	}
+	size_t new_capacity = (*capacity == 0) ? 4 : (*capacity * 2);
+	while (new_capacity < needed)
+	{
+		new_capacity *= 2;
+	}
+	void *new_buffer = realloc(*buffer, new_capacity * elem_size);
+	if (!new_buffer)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	*buffer = new_buffer;
+	*capacity = new_capacity;
+}
@@ -0,0 +1,9 @@
+#ifndef RANGE_H
+#define RANGE_H
+
+#include "ast.h"
+#include "options.h"
+
+void range_analyze(AstProgram *program, const CompilerOptions *options);
+
+#endif
@@ -526,6 +526,10 @@ static TypeKind analyze_expression(SemanticInfo *info, SymbolTable *symbols, Ast
 				semantic_error("arithmetic operator expects numeric operands");
 			}
 			expr->type = arithmetic_result(left_type, right_type);
+			if (expr->data.binary.op == BIN_OP_DIV && expr->type == TYPE_INT)
+			{
+				info->functions.fractional_ints = 1;
+			}
 			return expr->type;
 		case BIN_OP_MOD:
 			if (left_type != TYPE_INT || right_type != TYPE_INT)
@@ -0,0 +1,407 @@
+#include "split.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Every nesting level costs Lua's parser one or two C levels out of 200 and
+ * each pending operand a register, so expressions deeper than the limit are
+ * cut into chunks of at most CHUNK_DEPTH held in temporaries. */
+#define EXPR_DEPTH_LIMIT 40
+#define CHUNK_DEPTH 24
+
+typedef struct
+{
+	AstExpr *node;
+	size_t child;
+} PathFrame;
+
+typedef struct
+{
+	PathFrame *items;
+	size_t count;
+	size_t capacity;
+} Path;
+
+typedef struct
+{
+	size_t temp_counter;
+} SplitContext;
+
+static void split_list(SplitContext *ctx, AstStmtList *list);
+static AstStmt *split_statement(SplitContext *ctx, AstStmt *stmt, AstStmtList *prelude);
+static AstStmt *split_body(SplitContext *ctx, AstStmt *body);
+static AstStmt *split_loop(SplitContext *ctx, AstExpr *condition, AstStmt *body, AstStmt *post);
+static void split_root(SplitContext *ctx, AstExpr **slot, AstStmtList *prelude);
+static void split_node(SplitContext *ctx, AstExpr **slot, Path *path, AstStmtList *prelude, int conditional);
+static void flush_left_operands(SplitContext *ctx, const Path *path, int moved_has_call, AstStmtList *prelude);
+static void hoist(SplitContext *ctx, AstExpr **slot, AstStmtList *prelude);
+static size_t expression_depth(const AstExpr *expr);
+static size_t child_count(const AstExpr *expr);
+static AstExpr **child_slot(AstExpr *expr, size_t index);
+static int is_leaf(const AstExpr *expr);
+static AstStmt *make_block(AstStmtList *statements);
+static void reassign_prelude(AstStmtList *statements, const AstStmtList *prelude, const char *flag, const AstExpr *condition);
+static char *make_temp_name(SplitContext *ctx);
+static char *dup_string(const char *src);
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed);
+
+/* Operands are moved out in evaluation order: before a subexpression moves
+ * ahead of its statement, every operand evaluated before it that could call a
+ * function moves first, and nothing is moved out of the right operand of &&
+ * or ||, which may not be evaluated at all. */
+void split_expressions(AstProgram *program)
+{
+	if (!program)
+	{
+		return;
+	}
+	SplitContext ctx = {0};
+	for (size_t i = 0; i < program->functions.count; ++i)
+	{
+		split_list(&ctx, &program->functions.items[i]->body.statements);
+	}
+}
+
+static void split_list(SplitContext *ctx, AstStmtList *list)
+{
+	for (size_t i = 0; i < list->count; ++i)
+	{
+		AstStmtList prelude = ast_stmt_list_make();
+		AstStmt *stmt = split_statement(ctx, list->items[i], &prelude);
+		if (prelude.count == 0)
+		{
+			list->items[i] = stmt;
+			free(prelude.items);
+			continue;
+		}
+		if (stmt->kind != STMT_DECL)
+		{
+			ast_stmt_list_push(&prelude, stmt);
+			list->items[i] = make_block(&prelude);
+			continue;
+		}
+
+		/* The temporaries of a declaration share its scope. */
+		AstStmtList rebuilt = ast_stmt_list_make();
+		for (size_t j = 0; j < i; ++j)
+		{
+			ast_stmt_list_push(&rebuilt, list->items[j]);
+		}
+		for (size_t j = 0; j < prelude.count; ++j)
+		{
+			ast_stmt_list_push(&rebuilt, prelude.items[j]);
+		}
+		ast_stmt_list_push(&rebuilt, stmt);
+		size_t resume = rebuilt.count;
+		for (size_t j = i + 1; j < list->count; ++j)
+		{
+			ast_stmt_list_push(&rebuilt, list->items[j]);
+		}
+		free(prelude.items);
+		free(list->items);
+		*list = rebuilt;
+		i = resume - 1;
+	}
+}
+
+static AstStmt *split_statement(SplitContext *ctx, AstStmt *stmt, AstStmtList *prelude)
+{
+	if (!stmt)
+	{
+		return stmt;
+	}
+
+	switch (stmt->kind)
+	{
+	case STMT_BLOCK:
+		split_list(ctx, &stmt->data.block.statements);
+		break;
+	case STMT_DECL:
+		split_root(ctx, &stmt->data.decl.init, prelude);
+		split_root(ctx, &stmt->data.decl.array_init, prelude);
+		break;
+	case STMT_ASSIGN:
+		split_root(ctx, &stmt->data.assign.value, prelude);
+		break;
+	case STMT_ARRAY_ASSIGN:
+		split_root(ctx, &stmt->data.array_assign.index, prelude);
+		split_root(ctx, &stmt->data.array_assign.value, prelude);
+		break;
+	case STMT_WHILE:
+		stmt->data.while_stmt.body = split_body(ctx, stmt->data.while_stmt.body);
+		if (expression_depth(stmt->data.while_stmt.condition) > EXPR_DEPTH_LIMIT)
+		{
+			AstStmt *loop = split_loop(ctx, stmt->data.while_stmt.condition, stmt->data.while_stmt.body, NULL);
+			stmt->data.while_stmt.condition = NULL;
+			stmt->data.while_stmt.body = NULL;
+			ast_stmt_destroy(stmt);
+			return loop;
+		}
+		break;
+	case STMT_FOR:
+	{
+		stmt->data.for_stmt.init = split_statement(ctx, stmt->data.for_stmt.init, prelude);
+		stmt->data.for_stmt.body = split_body(ctx, stmt->data.for_stmt.body);
+		if (expression_depth(stmt->data.for_stmt.condition) > EXPR_DEPTH_LIMIT)
+		{
+			AstStmtList statements = ast_stmt_list_make();
+			if (stmt->data.for_stmt.init)
+			{
+				ast_stmt_list_push(&statements, stmt->data.for_stmt.init);
+			}
+			ast_stmt_list_push(&statements, split_loop(ctx, stmt->data.for_stmt.condition, stmt->data.for_stmt.body,
+													   stmt->data.for_stmt.post));
+			stmt->data.for_stmt.init = NULL;
+			stmt->data.for_stmt.condition = NULL;
+			stmt->data.for_stmt.body = NULL;
+			stmt->data.for_stmt.post = NULL;
+			ast_stmt_destroy(stmt);
+			return make_block(&statements);
+		}
+		break;
+	}
+	case STMT_EXPR:
+	case STMT_RETURN:
+		split_root(ctx, &stmt->data.expr, prelude);
+		break;
+	}
+	return stmt;
+}
+
+static AstStmt *split_body(SplitContext *ctx, AstStmt *body)
+{
+	AstStmtList prelude = ast_stmt_list_make();
+	body = split_statement(ctx, body, &prelude);
+	if (prelude.count == 0)
+	{
+		free(prelude.items);
+		return body;
+	}
+	ast_stmt_list_push(&prelude, body);
+	return make_block(&prelude);
+}
+
+/* A loop condition is re-evaluated on every iteration, so its pieces are
+ * computed before the loop and again at the end of each pass:
+ *
+ *   { pieces; bool c = cond; while (c) { { body } post; pieces; c = cond; } }
+ *
+ * The body keeps its own block so its declarations cannot shadow names the
+ * condition reads. */
+static AstStmt *split_loop(SplitContext *ctx, AstExpr *condition, AstStmt *body, AstStmt *post)
+{
+	AstStmtList outer = ast_stmt_list_make();
+	split_root(ctx, &condition, &outer);
+	char *flag = make_temp_name(ctx);
+	AstStmtList inner = ast_stmt_list_make();
+	if (body)
+	{
+		ast_stmt_list_push(&inner, body);
+	}
+	if (post)
+	{
+		ast_stmt_list_push(&inner, post);
+	}
+	reassign_prelude(&inner, &outer, flag, condition);
+	ast_stmt_list_push(&outer, ast_stmt_make_decl(TYPE_BOOL, dup_string(flag), condition));
+
+	AstExpr *test = ast_expr_make_identifier(dup_string(flag));
+	test->type = TYPE_BOOL;
+	ast_stmt_list_push(&outer, ast_stmt_make_while(test, make_block(&inner)));
+	free(flag);
+	return make_block(&outer);
+}
+
+static void reassign_prelude(AstStmtList *statements, const AstStmtList *prelude, const char *flag, const AstExpr *condition)
+{
+	for (size_t i = 0; i < prelude->count; ++i)
+	{
+		const AstStmt *decl = prelude->items[i];
+		AstStmt *assign = ast_stmt_make_assign(dup_string(decl->data.decl.name), ast_expr_clone(decl->data.decl.init));
+		assign->data.assign.type = decl->data.decl.type;
+		ast_stmt_list_push(statements, assign);
+	}
+	AstStmt *assign = ast_stmt_make_assign(dup_string(flag), ast_expr_clone(condition));
+	assign->data.assign.type = TYPE_BOOL;
+	ast_stmt_list_push(statements, assign);
+}
+
+static void split_root(SplitContext *ctx, AstExpr **slot, AstStmtList *prelude)
+{
+	if (!*slot || expression_depth(*slot) <= EXPR_DEPTH_LIMIT)
+	{
+		return;
+	}
+	Path path = {0};
+	split_node(ctx, slot, &path, prelude, 0);
+	free(path.items);
+}
+
+static void split_node(SplitContext *ctx, AstExpr **slot, Path *path, AstStmtList *prelude, int conditional)
+{
+	AstExpr *expr = *slot;
+	if (!expr)
+	{
+		return;
+	}
+
+	size_t frame = path->count;
+	ensure_capacity((void **)&path->items, sizeof(PathFrame), &path->capacity, path->count + 1);
+	path->items[path->count++] = (PathFrame){expr, 0};
+	int short_circuit = expr->kind == EXPR_BINARY && (expr->data.binary.op == BIN_OP_AND || expr->data.binary.op == BIN_OP_OR);
+	for (size_t i = 0; i < child_count(expr); ++i)
+	{
+		path->items[frame].child = i;
+		split_node(ctx, child_slot(expr, i), path, prelude, conditional || (short_circuit && i > 0));
+	}
+	path->count = frame;
+
+	if (conditional || frame == 0 || expression_depth(expr) < CHUNK_DEPTH)
+	{
+		return;
+	}
+	flush_left_operands(ctx, path, ast_expr_contains_call(expr), prelude);
+	hoist(ctx, slot, prelude);
+}
+
+/* Operands evaluated before the one being moved: those that may call a
+ * function must run first, and if the moved one calls, anything that may fail
+ * must as well. */
+static void flush_left_operands(SplitContext *ctx, const Path *path, int moved_has_call, AstStmtList *prelude)
+{
+	for (size_t i = 0; i < path->count; ++i)
+	{
+		const PathFrame *frame = &path->items[i];
+		for (size_t j = 0; j < frame->child; ++j)
+		{
+			AstExpr **slot = child_slot(frame->node, j);
+			if (!is_leaf(*slot) && (moved_has_call || ast_expr_contains_call(*slot)))
+			{
+				hoist(ctx, slot, prelude);
+			}
+		}
+	}
+}
+
+static void hoist(SplitContext *ctx, AstExpr **slot, AstStmtList *prelude)
+{
+	AstExpr *expr = *slot;
+	char *name = make_temp_name(ctx);
+	ast_stmt_list_push(prelude, ast_stmt_make_decl(expr->type, dup_string(name), expr));
+	AstExpr *replacement = ast_expr_make_identifier(name);
+	replacement->type = expr->type;
+	*slot = replacement;
+}
+
+static size_t expression_depth(const AstExpr *expr)
+{
+	if (!expr)
+	{
+		return 0;
+	}
+	size_t deepest = 0;
+	for (size_t i = 0; i < child_count(expr); ++i)
+	{
+		size_t depth = expression_depth(*child_slot((AstExpr *)expr, i));
+		if (depth > deepest)
+		{
+			deepest = depth;
+		}
+	}
+	return deepest + 1;
+}
+
+static size_t child_count(const AstExpr *expr)
+{
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+	case EXPR_SUBSCRIPT:
+		return 2;
+	case EXPR_UNARY:
+		return 1;
+	case EXPR_CALL:
+		return expr->data.call.args.count;
+	case EXPR_ARRAY_LITERAL:
+		return expr->data.array_literal.elements.count;
+	default:
+		return 0;
+	}
+}
+
+/* Children in evaluation order. */
+static AstExpr **child_slot(AstExpr *expr, size_t index)
+{
+	switch (expr->kind)
+	{
+	case EXPR_BINARY:
+		return index == 0 ? &expr->data.binary.left : &expr->data.binary.right;
+	case EXPR_SUBSCRIPT:
+		return index == 0 ? &expr->data.subscript.array : &expr->data.subscript.index;
+	case EXPR_UNARY:
+		return &expr->data.unary.operand;
+	case EXPR_CALL:
+		return &expr->data.call.args.items[index];
+	case EXPR_ARRAY_LITERAL:
+		return &expr->data.array_literal.elements.items[index];
+	default:
+		return NULL;
+	}
+}
+
+static int is_leaf(const AstExpr *expr)
+{
+	return expr->kind != EXPR_CALL && child_count(expr) == 0;
+}
+
+static AstStmt *make_block(AstStmtList *statements)
+{
+	AstBlock block = ast_block_from_list(statements);
+	return ast_stmt_make_block(&block);
+}
+
+static char *make_temp_name(SplitContext *ctx)
+{
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "__split%zu", ctx->temp_counter++);
+	return dup_string(buffer);
+}
+
+static char *dup_string(const char *src)
+{
+	if (!src)
+	{
+		return NULL;
+	}
+	size_t len = strlen(src);
+	char *copy = malloc(len + 1);
+	if (!copy)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(copy, src, len + 1);
+	return copy;
+}
+
+static void ensure_capacity(void **buffer, size_t elem_size, size_t *capacity, size_t needed)
+{
+	if (*capacity >= needed)
+	{
+		return;
+	}
+	size_t new_capacity = (*capacity == 0) ? 4 : (*capacity * 2);
+	while (new_capacity < needed)
+	{
+		new_capacity *= 2;
+	}
+	void *new_buffer = realloc(*buffer, new_capacity * elem_size);
+	if (!new_buffer)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	*buffer = new_buffer;
+	*capacity = new_capacity;
+}
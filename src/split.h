@@ -0,0 +1,8 @@
+#ifndef SPLIT_H
+#define SPLIT_H
+
+#include "ast.h"
+
+void split_expressions(AstProgram *program);
+
+#endif
@@ -162,6 +162,7 @@ void function_table_init(FunctionTable *table)
 	table->items = NULL;
 	table->count = 0;
 	table->capacity = 0;
+	table->fractional_ints = 0;
 }
 
 static void function_signature_free(FunctionSignature *signature)
@@ -208,6 +209,8 @@ FunctionSignature *function_table_add(FunctionTable *table, const char *name, Ty
 	signature->name = dup_string(name);
 	signature->return_type = return_type;
 	signature->params = ast_param_list_make();
+	signature->is_pure = 0;
+	signature->storage = FUNCTION_LOCAL;
 	if (params)
 	{
 		for (size_t i = 0; i < params->count; ++i)
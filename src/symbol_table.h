@@ -26,11 +26,20 @@ typedef struct
 	size_t capacity;
 } SymbolTable;
 
+typedef enum
+{
+	FUNCTION_LOCAL,
+	FUNCTION_FORWARD,
+	FUNCTION_TABLE
+} FunctionStorage;
+
 typedef struct
 {
 	char *name;
 	TypeKind return_type;
 	AstParamList params;
+	int is_pure;
+	FunctionStorage storage;
 } FunctionSignature;
 
 typedef struct
@@ -38,6 +47,9 @@ typedef struct
 	FunctionSignature *items;
 	size_t count;
 	size_t capacity;
+	/* Set when the program divides ints in Lua floating point, so an int
+	 * variable may hold a fraction. */
+	int fractional_ints;
 } FunctionTable;
 
 void symbol_table_init(SymbolTable *table);
@@ -1,9 +1,5 @@
 os.exit((function(args)
-	local a = 1
-	local b = 2.5
-	local c = (a + b)
-	local x = 7
-	local y = 3
-	local z = (x % y)
-	return x
+	local c = 1 + 2.5
+	local z = 7 % 3
+	return 7
 end)(arg))
@@ -1,6 +1,8 @@
 os.exit((function(args)
-	local arr = { 10, 20, 30 }
-	arr[2] = 99
-	local x = arr[2]
+	local __arr1_0 = 10
+	local __arr1_1 = 20
+	local __arr1_2 = 30
+	__arr1_1 = 99
+	local x = __arr1_1
 	return x
 end)(arg))
@@ -0,0 +1,27 @@
+int first_square(int target)
+{
+	int found = 0;
+	int i = 0;
+	while (!found && i < 10)
+	{
+		found = i * i == target;
+		i = i + 1;
+	}
+	return i;
+}
+
+int main()
+{
+	int a = 3;
+	int b = 4;
+	int done = 0;
+	int steps = 0;
+	while (!done)
+	{
+		steps = steps + 1;
+		done = !(a < b) || steps > 5;
+		a = a + 1;
+	}
+	printf("%d %d %d\n", first_square(16), steps, !a);
+	return 0;
+}
@@ -0,0 +1,26 @@
+local function first_square(target)
+	local found = false
+	local i = 0
+	while not found and i < 10 do
+		do
+			found = i * i == target
+			i = i + 1
+		end
+	end
+	return i
+end
+
+os.exit((function(args)
+	local a = 3
+	local done = false
+	local steps = 0
+	while not done do
+		do
+			steps = steps + 1
+			done = a >= 4 or steps > 5
+			a = a + 1
+		end
+	end
+	print(string.format("%d %d %d", 5, steps, a == 0 and 1 or 0))
+	return 0
+end)(arg))
@@ -0,0 +1,37 @@
+int main(int argc)
+{
+	int a[8];
+	int hist[3];
+	for (int i = 0; i < 8; i = i + 1)
+	{
+		a[i] = i * i;
+	}
+	int j = 0;
+	while (j < 8)
+	{
+		hist[j % 3] = hist[j % 3] + a[7 - j];
+		j = j + 1;
+	}
+	int k = 0;
+	while (k < 7)
+	{
+		k = k + 1;
+		a[k - 1] = a[k];
+	}
+	int p = 1;
+	while (p < 4)
+	{
+		p = p * 2;
+	}
+	printf("%d %d %d\n", a[p], hist[0], hist[2]);
+	int b[4] = {1, 2, 3, 4};
+	int m = argc + 2;
+	int q = 0;
+	while (q < argc - 5)
+	{
+		b[m] = b[m] + q;
+		q = q + 1;
+	}
+	printf("%d %d\n", b[0], q);
+	return 0;
+}
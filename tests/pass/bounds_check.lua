@@ -0,0 +1,51 @@
+local function __check_index(index, size)
+	if index < 0 or index >= size then
+		error("array index " .. index .. " out of bounds for size " .. size, 2)
+	end
+	return index + 1
+end
+
+os.exit((function(args)
+	local args_table = args
+	local argc = args_table and tonumber(args_table[1]) or 0
+	local a = { 0, 0, 0, 0, 0, 0, 0, 0 }
+	local hist = { 0, 0, 0 }
+	for i = 0, 7 do
+		a[i + 1] = i * i
+	end
+	local j = 0
+	while j < 8 do
+		do
+			hist[j % 3 + 1] = hist[j % 3 + 1] + a[8 - j]
+			j = j + 1
+		end
+	end
+	local k = 0
+	while k < 7 do
+		do
+			k = k + 1
+			a[k] = a[k + 1]
+		end
+	end
+	local p = 1
+	while p < 4 do
+		do
+			p = p * 2
+		end
+	end
+	print(string.format("%d %d %d", a[__check_index(p, 8)], hist[1], hist[3]))
+	local b = { 1, 2, 3, 4 }
+	local m = argc + 2
+	local q = 0
+	do
+		local __licm1 = argc - 5
+		while q < __licm1 do
+			do
+				b[__check_index(m, 4)] = b[__check_index(m, 4)] + q
+				q = q + 1
+			end
+		end
+	end
+	print(string.format("%d %d", b[1], q))
+	return 0
+end)(arg))
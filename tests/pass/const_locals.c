@@ -0,0 +1,24 @@
+int weigh(int n)
+{
+	int weights[4] = {3, 1, 4, 1};
+	int scale = n * 2;
+	int total = 0;
+	for (int i = 0; i < 4; i = i + 1)
+	{
+		int term = weights[i] * scale;
+		total = total + term;
+	}
+	return total;
+}
+
+int main()
+{
+	int limit = weigh(2) + 1;
+	int k = 0;
+	while (k < limit)
+	{
+		k = k + 4;
+	}
+	printf("%d %d\n", limit, k);
+	return 0;
+}
@@ -0,0 +1,23 @@
+local __const1 <const> = { 3, 1, 4, 1 }
+
+local function weigh(n)
+	local weights <const> = __const1
+	local scale <const> = n * 2
+	local total = 0
+	for i = 1, 4 do
+		local term <const> = weights[i] * scale
+		total = total + term
+	end
+	return total
+end
+
+os.exit((function(args)
+	local k = 0
+	while k < 37 do
+		do
+			k = k + 4
+		end
+	end
+	print(string.format("%d %d", 37, k))
+	return 0
+end)(arg))
@@ -0,0 +1,40 @@
+int pow2(int e)
+{
+	int r = 1;
+	for (int i = 0; i < e; i = i + 1)
+	{
+		r = r * 2;
+	}
+	return r;
+}
+
+int triangle(int n)
+{
+	int cells[16];
+	cells[0] = 0;
+	for (int i = 1; i <= n; i = i + 1)
+	{
+		cells[i] = cells[i - 1] + i;
+	}
+	return cells[n];
+}
+
+float half(float x)
+{
+	return x / 2;
+}
+
+int lowest()
+{
+	return 0 - 9223372036854775807 - 1;
+}
+
+int main()
+{
+	int size = pow2(10) + triangle(15);
+	printf("%d\n", size);
+	printf("%f\n", half(5));
+	printf("%d\n", pow2(size));
+	printf("%d\n", lowest() + size);
+	return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+	int width = 6;
+	printf("== report ==\n");
+	printf("%d items, %s mode, %5.2f%% done\n", 42, "fast", 99.5);
+	printf("|%-6d|%06d|%+d|% d|\n", -7, width, 5, 5);
+	printf("|%x|%X|%#x|\n", 255, 3054, 255);
+	printf("|%e|%g|%G|%g|\n", 12345.678, 2.5, 0.00001, 1.0);
+	printf("|%s|%s|%s|%5s|%-5s|%.2s|\n", 1.0, 10, 0.1, "ab", "cd", "xyz");
+	printf("%s %d\n", width > 3, width > 3);
+	printf("%5.3d|%c\n", width, 65);
+	printf("%d %d\n", 0 - 9223372036854775807 - 1, width - 9223372036854775807 - 7);
+	return 0;
+}
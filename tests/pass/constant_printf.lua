@@ -0,0 +1,12 @@
+os.exit((function(args)
+	print("== report ==")
+	print("42 items, fast mode, 99.50% done")
+	print("|-7    |000006|+5| 5|")
+	print("|ff|BEE|0xff|")
+	print("|1.234570e+04|2.5|1E-05|1|")
+	print("|1|10|0.1|   ab|cd   |xy|")
+	print("true 1")
+	print(string.format("%5.3d|%c", 6, 65))
+	print("-9223372036854775808 -9223372036854775808")
+	return 0
+end)(arg))
@@ -0,0 +1,29 @@
+int score(int n)
+{
+	int weights[10] = {5, 1, 4, 2, 8, 5, 7, 1, 3, 9};
+	int total = 0;
+	for (int k = 0; k < 3; k = k + 1)
+	{
+		total = total + weights[(n + k) % 10];
+	}
+	return total;
+}
+
+int scratch(int n)
+{
+	int buffer[3] = {1, 2, 3};
+	buffer[n % 3] = n;
+	return buffer[0] + buffer[1] + buffer[2];
+}
+
+int main()
+{
+	int total = 0;
+	for (int i = 0; i < 20; i = i + 1)
+	{
+		int masks[4] = {1, 2, 4, 8};
+		total = total + score(i * 37) + scratch(i) + masks[i % 4];
+	}
+	printf("%d\n", total);
+	return 0;
+}
@@ -0,0 +1,27 @@
+local __const1 = { 5, 1, 4, 2, 8, 5, 7, 1, 3, 9 }
+local __const2 = { 1, 2, 4, 8 }
+
+local function score(n)
+	local weights = __const1
+	local total = 0
+	for k = 0, 2 do
+		total = total + weights[(n + k) % 10 + 1]
+	end
+	return total
+end
+
+local function scratch(n)
+	local buffer = { 1, 2, 3 }
+	buffer[n % 3 + 1] = n
+	return buffer[1] + buffer[2] + buffer[3]
+end
+
+os.exit((function(args)
+	local total = 0
+	for i = 0, 19 do
+		local masks = __const2
+		total = total + score(i * 37) + scratch(i) + masks[i % 4 + 1]
+	end
+	print(string.format("%d", total))
+	return 0
+end)(arg))
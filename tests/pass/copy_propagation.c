@@ -0,0 +1,16 @@
+int shift(int x, int y)
+{
+	int t = x;
+	int u = t;
+	y = u + y;
+	x = x + 1;
+	return t + x + y;
+}
+
+int main()
+{
+	int base = 7;
+	int scale = base;
+	printf("%d %d\n", scale * 2, shift(base, 3));
+	return 0;
+}
@@ -0,0 +1,11 @@
+local function shift(x, y)
+	local t = x
+	y = x + y
+	x = x + 1
+	return t + x + y
+end
+
+os.exit((function(args)
+	print(string.format("%d %d", 14, shift(7, 3)))
+	return 0
+end)(arg))
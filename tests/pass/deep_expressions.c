@@ -0,0 +1,31 @@
+int noisy(int x)
+{
+	printf("%d\n", x);
+	return x;
+}
+
+int ordered(int s)
+{
+	return (noisy(s + 45) - (noisy(s + 44) - (noisy(s + 43) - (noisy(s + 42) - (noisy(s + 41) - (noisy(s + 40) - (noisy(s + 39) - (noisy(s + 38) - (noisy(s + 37) - (noisy(s + 36) - (noisy(s + 35) - (noisy(s + 34) - (noisy(s + 33) - (noisy(s + 32) - (noisy(s + 31) - (noisy(s + 30) - (noisy(s + 29) - (noisy(s + 28) - (noisy(s + 27) - (noisy(s + 26) - (noisy(s + 25) - (noisy(s + 24) - (noisy(s + 23) - (noisy(s + 22) - (noisy(s + 21) - (noisy(s + 20) - (noisy(s + 19) - (noisy(s + 18) - (noisy(s + 17) - (noisy(s + 16) - (noisy(s + 15) - (noisy(s + 14) - (noisy(s + 13) - (noisy(s + 12) - (noisy(s + 11) - (noisy(s + 10) - (noisy(s + 9) - (noisy(s + 8) - (noisy(s + 7) - (noisy(s + 6) - (noisy(s + 5) - (noisy(s + 4) - (noisy(s + 3) - (noisy(s + 2) - (noisy(s + 1) - noisy(s))))))))))))))))))))))))))))))))))))))))))))));
+}
+
+int steps(int n)
+{
+	int k = 0;
+	while (((((((((((((((((((((((((((((((((((((((((((((k + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) + n) - n) < 10)
+	{
+		k = k + 1;
+	}
+	return k;
+}
+
+int main()
+{
+	int a = 3;
+	int b = 5;
+	int sum = a + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3 + b * 4 + b * 5 + b * 6 + b * 0 + b * 1 + b * 2 + b * 3;
+	int alternating = (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - (b - a)))))))))))))))))))))))))))))))))))))))))))));
+	int k = steps(sum);
+	printf("%d %d %d %d\n", sum, alternating, k, ordered(k - 1000));
+	return 0;
+}
@@ -0,0 +1,60 @@
+local function noisy(x)
+	print(string.format("%d", x))
+	return x
+end
+
+local function ordered(s)
+	do
+		local __split0 = noisy(s + 45)
+		local __split1 = noisy(s + 44)
+		local __split2 = noisy(s + 43)
+		local __split3 = noisy(s + 42)
+		local __split4 = noisy(s + 41)
+		local __split5 = noisy(s + 40)
+		local __split6 = noisy(s + 39)
+		local __split7 = noisy(s + 38)
+		local __split8 = noisy(s + 37)
+		local __split9 = noisy(s + 36)
+		local __split10 = noisy(s + 35)
+		local __split11 = noisy(s + 34)
+		local __split12 = noisy(s + 33)
+		local __split13 = noisy(s + 32)
+		local __split14 = noisy(s + 31)
+		local __split15 = noisy(s + 30)
+		local __split16 = noisy(s + 29)
+		local __split17 = noisy(s + 28)
+		local __split18 = noisy(s + 27)
+		local __split19 = noisy(s + 26)
+		local __split20 = noisy(s + 25)
+		local __split21 = noisy(s + 24)
+		local __split22 = noisy(s + 23)
+		local __split23 = noisy(s + 22)
+		local __split24 = noisy(s + 21) - (noisy(s + 20) - (noisy(s + 19) - (noisy(s + 18) - (noisy(s + 17) - (noisy(s + 16) - (noisy(s + 15) - (noisy(s + 14) - (noisy(s + 13) - (noisy(s + 12) - (noisy(s + 11) - (noisy(s + 10) - (noisy(s + 9) - (noisy(s + 8) - (noisy(s + 7) - (noisy(s + 6) - (noisy(s + 5) - (noisy(s + 4) - (noisy(s + 3) - (noisy(s + 2) - (noisy(s + 1) - noisy(s)))))))))))))))))))))
+		local __split25 = __split1 - (__split2 - (__split3 - (__split4 - (__split5 - (__split6 - (__split7 - (__split8 - (__split9 - (__split10 - (__split11 - (__split12 - (__split13 - (__split14 - (__split15 - (__split16 - (__split17 - (__split18 - (__split19 - (__split20 - (__split21 - (__split22 - (__split23 - __split24))))))))))))))))))))))
+		return __split0 - __split25
+	end
+end
+
+local function steps(n)
+	local k = 0
+	do
+		local __split26 = k + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n
+		local __split27 = __split26 - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n < 10
+		while __split27 do
+			do
+				do
+					k = k + 1
+				end
+				__split26 = k + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n
+				__split27 = __split26 - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n + n - n < 10
+			end
+		end
+	end
+	return k
+end
+
+os.exit((function(args)
+	local k = steps(873)
+	print(string.format("%d %d %d %d", 873, 2, k, ordered(k - 1000)))
+	return 0
+end)(arg))
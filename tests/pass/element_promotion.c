@@ -0,0 +1,23 @@
+int accumulate(int k)
+{
+	int x[8] = {3, 1, 4, 1, 5, 9, 2, 6};
+	int sum[2];
+	for (int i = 0; i < 8; i = i + 1)
+	{
+		sum[k] = sum[k] + x[i];
+	}
+	return sum[k];
+}
+
+int main()
+{
+	int hist[3];
+	int j = 0;
+	while (j < 8)
+	{
+		hist[j % 3] = hist[j % 3] + 1;
+		j = j + 1;
+	}
+	printf("%d %d %d\n", accumulate(1), hist[0], hist[2]);
+	return 0;
+}
@@ -0,0 +1,27 @@
+local __const2 = { 3, 1, 4, 1, 5, 9, 2, 6 }
+
+local function accumulate(k)
+	local x = __const2
+	local sum = { 0, 0 }
+	do
+		local __elem1 = sum[k + 1]
+		for i = 1, 8 do
+			__elem1 = __elem1 + x[i]
+		end
+		sum[k + 1] = __elem1
+	end
+	return sum[k + 1]
+end
+
+os.exit((function(args)
+	local hist = { 0, 0, 0 }
+	local j = 0
+	while j < 8 do
+		do
+			hist[j % 3 + 1] = hist[j % 3 + 1] + 1
+			j = j + 1
+		end
+	end
+	print(string.format("%d %d %d", 31, hist[1], hist[3]))
+	return 0
+end)(arg))
@@ -0,0 +1,28 @@
+int is_even(int n)
+{
+	while (n > 0)
+	{
+		return is_odd(n - 1);
+	}
+	return 1;
+}
+
+int is_odd(int n)
+{
+	while (n > 0)
+	{
+		return is_even(n - 1);
+	}
+	return 0;
+}
+
+int main()
+{
+	int total = 0;
+	for (int i = 0; i < 10; i = i + 1)
+	{
+		total = total + is_even(i) * 10 + is_odd(i);
+	}
+	printf("%d\n", total);
+	return 0;
+}
@@ -0,0 +1,28 @@
+local is_odd
+
+local function is_even(n)
+	while n > 0 do
+		do
+			return is_odd(n - 1)
+		end
+	end
+	return 1
+end
+
+function is_odd(n)
+	while n > 0 do
+		do
+			return is_even(n - 1)
+		end
+	end
+	return 0
+end
+
+os.exit((function(args)
+	local total = 0
+	for i = 0, 9 do
+		total = total + is_even(i) * 10 + is_odd(i)
+	end
+	print(string.format("%d", total))
+	return 0
+end)(arg))
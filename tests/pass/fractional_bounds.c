@@ -0,0 +1,23 @@
+int cnt(int n)
+{
+	int c = 0;
+	for (int i = 0; i < n / 2; i = i + 1)
+	{
+		c = c + 1;
+	}
+	for (int i = 9; i > n / 2; i = i - 1)
+	{
+		c = c + 10;
+	}
+	for (int i = n / 2; i < 6; i = i + 1)
+	{
+		c = c + 100;
+	}
+	return c;
+}
+
+int main(int argc)
+{
+	printf("%d %d\n", cnt(7), cnt(argc));
+	return 0;
+}
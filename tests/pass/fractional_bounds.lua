@@ -0,0 +1,32 @@
+local function cnt(n)
+	local c = 0
+	do
+		local __licm1 = n / 2
+		for i = 0, math.ceil(__licm1) - 1 do
+			c = c + 1
+		end
+	end
+	do
+		local __licm2 = n / 2
+		for i = 9, math.floor(__licm2) + 1, -1 do
+			c = c + 10
+		end
+	end
+	do
+		local i = n / 2
+		while i < 6 do
+			do
+				c = c + 100
+			end
+			i = i + 1
+		end
+	end
+	return c
+end
+
+os.exit((function(args)
+	local args_table = args
+	local argc = args_table and tonumber(args_table[1]) or 0
+	print(string.format("%d %d", 364, cnt(argc)))
+	return 0
+end)(arg))
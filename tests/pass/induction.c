@@ -0,0 +1,12 @@
+int main()
+{
+	int a[8];
+	int b[4] = {4, 3, 2, 1};
+	for (int i = 0; i < 4; i = i + 1)
+	{
+		a[2 * i] = b[i];
+		a[2 * i + 1] = b[i] + b[3 - i];
+	}
+	printf("%d %d\n", a[0], a[7]);
+	return 0;
+}
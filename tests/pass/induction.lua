@@ -0,0 +1,14 @@
+os.exit((function(args)
+	local a = { 0, 0, 0, 0, 0, 0, 0, 0 }
+	local b = { 4, 3, 2, 1 }
+	do
+		local __iv1 = 1
+		for i = 1, 4 do
+			a[__iv1] = b[i]
+			a[__iv1 + 1] = b[i] + b[5 - i]
+			__iv1 = __iv1 + 2
+		end
+	end
+	print(string.format("%d %d", a[1], a[8]))
+	return 0
+end)(arg))
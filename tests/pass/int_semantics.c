@@ -0,0 +1,44 @@
+int hash(int n)
+{
+	int h = 5381;
+	for (int i = 0; i < n; i = i + 1)
+	{
+		h = h * 33 + i;
+	}
+	return h;
+}
+
+int next(int seed)
+{
+	return seed * 1103515245 + 12345;
+}
+
+int share(int n, int d)
+{
+	int s = 0;
+	int i = 0;
+	while (i < d)
+	{
+		s = s + n / d;
+		i = i + 1;
+	}
+	return s;
+}
+
+int main(int argc)
+{
+	int s = 42;
+	int counts[7];
+	for (int k = 0; k < 10; k = k + 1)
+	{
+		s = next(s);
+		counts[(s / 65536) % 4 + 3] = k;
+	}
+	int a = -7;
+	int b = 2;
+	int big = 2147483647;
+	printf("%d %d %d %d %d\n", hash(20), s, a / b, a % b, -big - 1);
+	printf("%d %d %d\n", big + 1, counts[0], counts[6]);
+	printf("%d\n", share(a, argc));
+	return 0;
+}
@@ -0,0 +1,43 @@
+local function __cdiv(a, b)
+	local q = (a - math.fmod(a, b)) // b
+	return ((q + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+end
+
+local function hash(n)
+	local h = 5381
+	for i = 0, n - 1 do
+		h = (h * 33 + i + 0x80000000 & 0xFFFFFFFF) - 0x80000000
+	end
+	return h
+end
+
+local function next(seed)
+	return (seed * 1103515245 + 12345 + 0x80000000 & 0xFFFFFFFF) - 0x80000000
+end
+
+local function share(n, d)
+	local s = 0
+	local i = 0
+	while i < d do
+		do
+			s = (s + __cdiv(n, d) + 0x80000000 & 0xFFFFFFFF) - 0x80000000
+			i = (i + 1 + 0x80000000 & 0xFFFFFFFF) - 0x80000000
+		end
+	end
+	return s
+end
+
+os.exit((function(args)
+	local args_table = args
+	local argc = args_table and tonumber(args_table[1]) or 0
+	local s = 42
+	local counts = { 0, 0, 0, 0, 0, 0, 0 }
+	for k = 0, 9 do
+		s = next(s)
+		counts[math.fmod(__cdiv(s, 65536), 4) + 4] = k
+	end
+	print(string.format("%d %d %d %d %d", 1524743363, s, __cdiv(-7, 2), math.fmod(-7, 2), -2147483648))
+	print(string.format("%d %d %d", -2147483648, counts[1], counts[7]))
+	print(string.format("%d", share(-7, argc)))
+	return 0
+end)(arg))
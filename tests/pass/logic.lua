@@ -1,9 +1,7 @@
 os.exit((function(args)
-	local a = 1
-	local b = 0
-	local c = (((a ~= 0) and not ((b ~= 0))) and 1 or 0)
-	local d = (((b ~= 0) or (a ~= 0)) and 1 or 0)
-	local cond = ((a ~= 0) and (b ~= 0))
+	local c = 1
+	local d = 1
+	local cond = false
 	print(string.format("logic %d %d", c, d))
 	return 0
 end)(arg))
@@ -0,0 +1,28 @@
+int main()
+{
+	int total = 0;
+	for (int i = 0; i < 4; i = i + 1)
+	{
+		int counts[3];
+		int weights[3] = {i, i + 1, total};
+		counts[i % 3] = counts[i % 3] + weights[i % 3];
+		total = total + counts[0] + counts[1] + counts[2];
+
+		int row = 0;
+		while (row < 2)
+		{
+			int squares[5];
+			for (int k = 0; k < 5; k = k + 1)
+			{
+				squares[k] = k * k + row;
+			}
+			float scratch[10];
+			scratch[row] = scratch[row] + 0.5;
+			total = total + squares[4] + squares[row];
+			printf("%d %d %.1f\n", i, row, scratch[row] + scratch[9]);
+			row = row + 1;
+		}
+	}
+	printf("%d\n", total);
+	return 0;
+}
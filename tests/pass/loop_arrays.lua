@@ -0,0 +1,34 @@
+os.exit((function(args)
+	local total = 0
+	local counts = { 0, 0, 0 }
+	local weights = { 0, 0, 0 }
+	local squares = { 0, 0, 0, 0, 0 }
+	local scratch = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }
+	for i = 0, 3 do
+		counts[1] = 0
+		counts[2] = 0
+		counts[3] = 0
+		weights[1] = i
+		weights[2] = i + 1
+		weights[3] = total
+		counts[i % 3 + 1] = counts[i % 3 + 1] + weights[i % 3 + 1]
+		total = total + counts[1] + counts[2] + counts[3]
+		local row = 0
+		while row < 2 do
+			do
+				for k = 0, 4 do
+					squares[k + 1] = k * k + row
+				end
+				for __reset1 = 0, 9 do
+					scratch[__reset1 + 1] = 0
+				end
+				scratch[row + 1] = scratch[row + 1] + 0.5
+				total = total + squares[5] + squares[row + 1]
+				print(string.format("%d %d %.1f", i, row, scratch[row + 1] + scratch[10]))
+				row = row + 1
+			end
+		end
+	end
+	print(string.format("%d", total))
+	return 0
+end)(arg))
@@ -0,0 +1,24 @@
+int main()
+{
+	int a[6];
+	int b[6];
+	int sum = 0;
+	for (int i = 0; i < 6; i = i + 1)
+	{
+		a[i] = i * i;
+	}
+	for (int i = 0; i < 6; i = i + 1)
+	{
+		b[i] = a[i] + 1;
+	}
+	for (int i = 0; i < 6; i = i + 1)
+	{
+		sum = sum + b[i];
+	}
+	for (int i = 0; i < 6; i = i + 1)
+	{
+		a[i] = a[5 - i];
+	}
+	printf("%d %d %d\n", sum, a[0], a[5]);
+	return 0;
+}
@@ -0,0 +1,15 @@
+os.exit((function(args)
+	local a = { 0, 0, 0, 0, 0, 0 }
+	local b = { 0, 0, 0, 0, 0, 0 }
+	local sum = 0
+	for i = 1, 6 do
+		a[i] = (i - 1) * (i - 1)
+		b[i] = a[i] + 1
+		sum = sum + b[i]
+	end
+	for i = 1, 6 do
+		a[i] = a[7 - i]
+	end
+	print(string.format("%d %d %d", sum, a[1], a[6]))
+	return 0
+end)(arg))
@@ -0,0 +1,51 @@
+int weigh(int n, int m)
+{
+	int total = 0;
+	int i = 0;
+	while (i < n * m + 1)
+	{
+		total = total + i * (n + m);
+		i = i + 1;
+	}
+	return total;
+}
+
+int first_above(int n, int limit)
+{
+	int i = 0;
+	while (i < n)
+	{
+		while (i * i > limit)
+		{
+			return i + limit * 2;
+		}
+		i = i + 1;
+	}
+	return 0 - 1;
+}
+
+int last_doubled(int n)
+{
+	int x;
+	int s = 0;
+	for (int i = 0; i < n; i = i + 1)
+	{
+		x = i;
+	}
+	int j = 0;
+	while (j < n)
+	{
+		s = s + x * 2;
+		j = j + 1;
+	}
+	return s;
+}
+
+int main(int argc)
+{
+	int n = 4;
+	printf("%d\n", weigh(n, n - 1));
+	printf("%d\n", first_above(n * 5, n + 6));
+	printf("%d\n", last_doubled(argc));
+	return 0;
+}
@@ -0,0 +1,55 @@
+local function weigh(n, m)
+	local total = 0
+	local i = 0
+	do
+		local __licm1 = n * m + 1
+		local __licm2 = n + m
+		while i < __licm1 do
+			do
+				total = total + i * __licm2
+				i = i + 1
+			end
+		end
+	end
+	return total
+end
+
+local function first_above(n, limit)
+	local i = 0
+	while i < n do
+		do
+			while i * i > limit do
+				do
+					return i + limit * 2
+				end
+			end
+			i = i + 1
+		end
+	end
+	return -1
+end
+
+local function last_doubled(n)
+	local x
+	local s = 0
+	for i = 0, n - 1 do
+		x = i
+	end
+	local j = 0
+	while j < n do
+		do
+			s = s + x * 2
+			j = j + 1
+		end
+	end
+	return s
+end
+
+os.exit((function(args)
+	local args_table = args
+	local argc = args_table and tonumber(args_table[1]) or 0
+	print(string.format("%d", weigh(4, 3)))
+	print(string.format("%d", first_above(20, 10)))
+	print(string.format("%d", last_doubled(argc)))
+	return 0
+end)(arg))
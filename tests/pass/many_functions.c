@@ -0,0 +1,960 @@
+int step0(int x)
+{
+	return step1(x + 0);
+}
+
+int step1(int x)
+{
+	return step2(x + 1);
+}
+
+int step2(int x)
+{
+	return step3(x + 2);
+}
+
+int step3(int x)
+{
+	return step4(x + 3);
+}
+
+int step4(int x)
+{
+	return step5(x + 0);
+}
+
+int step5(int x)
+{
+	return step6(x + 1);
+}
+
+int step6(int x)
+{
+	return step7(x + 2);
+}
+
+int step7(int x)
+{
+	return step8(x + 3);
+}
+
+int step8(int x)
+{
+	return step9(x + 0);
+}
+
+int step9(int x)
+{
+	return step10(x + 1);
+}
+
+int step10(int x)
+{
+	return step11(x + 2);
+}
+
+int step11(int x)
+{
+	return step12(x + 3);
+}
+
+int step12(int x)
+{
+	return step13(x + 0);
+}
+
+int step13(int x)
+{
+	return step14(x + 1);
+}
+
+int step14(int x)
+{
+	return step15(x + 2);
+}
+
+int step15(int x)
+{
+	return step16(x + 3);
+}
+
+int step16(int x)
+{
+	return step17(x + 0);
+}
+
+int step17(int x)
+{
+	return step18(x + 1);
+}
+
+int step18(int x)
+{
+	return step19(x + 2);
+}
+
+int step19(int x)
+{
+	return step20(x + 3);
+}
+
+int step20(int x)
+{
+	return step21(x + 0);
+}
+
+int step21(int x)
+{
+	return step22(x + 1);
+}
+
+int step22(int x)
+{
+	return step23(x + 2);
+}
+
+int step23(int x)
+{
+	return step24(x + 3);
+}
+
+int step24(int x)
+{
+	return step25(x + 0);
+}
+
+int step25(int x)
+{
+	return step26(x + 1);
+}
+
+int step26(int x)
+{
+	return step27(x + 2);
+}
+
+int step27(int x)
+{
+	return step28(x + 3);
+}
+
+int step28(int x)
+{
+	return step29(x + 0);
+}
+
+int step29(int x)
+{
+	return step30(x + 1);
+}
+
+int step30(int x)
+{
+	return step31(x + 2);
+}
+
+int step31(int x)
+{
+	return step32(x + 3);
+}
+
+int step32(int x)
+{
+	return step33(x + 0);
+}
+
+int step33(int x)
+{
+	return step34(x + 1);
+}
+
+int step34(int x)
+{
+	return step35(x + 2);
+}
+
+int step35(int x)
+{
+	return step36(x + 3);
+}
+
+int step36(int x)
+{
+	return step37(x + 0);
+}
+
+int step37(int x)
+{
+	return step38(x + 1);
+}
+
+int step38(int x)
+{
+	return step39(x + 2);
+}
+
+int step39(int x)
+{
+	return step40(x + 3);
+}
+
+int step40(int x)
+{
+	return step41(x + 0);
+}
+
+int step41(int x)
+{
+	return step42(x + 1);
+}
+
+int step42(int x)
+{
+	return step43(x + 2);
+}
+
+int step43(int x)
+{
+	return step44(x + 3);
+}
+
+int step44(int x)
+{
+	return step45(x + 0);
+}
+
+int step45(int x)
+{
+	return step46(x + 1);
+}
+
+int step46(int x)
+{
+	return step47(x + 2);
+}
+
+int step47(int x)
+{
+	return step48(x + 3);
+}
+
+int step48(int x)
+{
+	return step49(x + 0);
+}
+
+int step49(int x)
+{
+	return step50(x + 1);
+}
+
+int step50(int x)
+{
+	return step51(x + 2);
+}
+
+int step51(int x)
+{
+	return step52(x + 3);
+}
+
+int step52(int x)
+{
+	return step53(x + 0);
+}
+
+int step53(int x)
+{
+	return step54(x + 1);
+}
+
+int step54(int x)
+{
+	return step55(x + 2);
+}
+
+int step55(int x)
+{
+	return step56(x + 3);
+}
+
+int step56(int x)
+{
+	return step57(x + 0);
+}
+
+int step57(int x)
+{
+	return step58(x + 1);
+}
+
+int step58(int x)
+{
+	return step59(x + 2);
+}
+
+int step59(int x)
+{
+	return step60(x + 3);
+}
+
+int step60(int x)
+{
+	return step61(x + 0);
+}
+
+int step61(int x)
+{
+	return step62(x + 1);
+}
+
+int step62(int x)
+{
+	return step63(x + 2);
+}
+
+int step63(int x)
+{
+	return step64(x + 3);
+}
+
+int step64(int x)
+{
+	return step65(x + 0);
+}
+
+int step65(int x)
+{
+	return step66(x + 1);
+}
+
+int step66(int x)
+{
+	return step67(x + 2);
+}
+
+int step67(int x)
+{
+	return step68(x + 3);
+}
+
+int step68(int x)
+{
+	return step69(x + 0);
+}
+
+int step69(int x)
+{
+	return step70(x + 1);
+}
+
+int step70(int x)
+{
+	return step71(x + 2);
+}
+
+int step71(int x)
+{
+	return step72(x + 3);
+}
+
+int step72(int x)
+{
+	return step73(x + 0);
+}
+
+int step73(int x)
+{
+	return step74(x + 1);
+}
+
+int step74(int x)
+{
+	return step75(x + 2);
+}
+
+int step75(int x)
+{
+	return step76(x + 3);
+}
+
+int step76(int x)
+{
+	return step77(x + 0);
+}
+
+int step77(int x)
+{
+	return step78(x + 1);
+}
+
+int step78(int x)
+{
+	return step79(x + 2);
+}
+
+int step79(int x)
+{
+	return step80(x + 3);
+}
+
+int step80(int x)
+{
+	return step81(x + 0);
+}
+
+int step81(int x)
+{
+	return step82(x + 1);
+}
+
+int step82(int x)
+{
+	return step83(x + 2);
+}
+
+int step83(int x)
+{
+	return step84(x + 3);
+}
+
+int step84(int x)
+{
+	return step85(x + 0);
+}
+
+int step85(int x)
+{
+	return step86(x + 1);
+}
+
+int step86(int x)
+{
+	return step87(x + 2);
+}
+
+int step87(int x)
+{
+	return step88(x + 3);
+}
+
+int step88(int x)
+{
+	return step89(x + 0);
+}
+
+int step89(int x)
+{
+	return step90(x + 1);
+}
+
+int step90(int x)
+{
+	return step91(x + 2);
+}
+
+int step91(int x)
+{
+	return step92(x + 3);
+}
+
+int step92(int x)
+{
+	return step93(x + 0);
+}
+
+int step93(int x)
+{
+	return step94(x + 1);
+}
+
+int step94(int x)
+{
+	return step95(x + 2);
+}
+
+int step95(int x)
+{
+	return step96(x + 3);
+}
+
+int step96(int x)
+{
+	return step97(x + 0);
+}
+
+int step97(int x)
+{
+	return step98(x + 1);
+}
+
+int step98(int x)
+{
+	return step99(x + 2);
+}
+
+int step99(int x)
+{
+	return step100(x + 3);
+}
+
+int step100(int x)
+{
+	return step101(x + 0);
+}
+
+int step101(int x)
+{
+	return step102(x + 1);
+}
+
+int step102(int x)
+{
+	return step103(x + 2);
+}
+
+int step103(int x)
+{
+	return step104(x + 3);
+}
+
+int step104(int x)
+{
+	return step105(x + 0);
+}
+
+int step105(int x)
+{
+	return step106(x + 1);
+}
+
+int step106(int x)
+{
+	return step107(x + 2);
+}
+
+int step107(int x)
+{
+	return step108(x + 3);
+}
+
+int step108(int x)
+{
+	return step109(x + 0);
+}
+
+int step109(int x)
+{
+	return step110(x + 1);
+}
+
+int step110(int x)
+{
+	return step111(x + 2);
+}
+
+int step111(int x)
+{
+	return step112(x + 3);
+}
+
+int step112(int x)
+{
+	return step113(x + 0);
+}
+
+int step113(int x)
+{
+	return step114(x + 1);
+}
+
+int step114(int x)
+{
+	return step115(x + 2);
+}
+
+int step115(int x)
+{
+	return step116(x + 3);
+}
+
+int step116(int x)
+{
+	return step117(x + 0);
+}
+
+int step117(int x)
+{
+	return step118(x + 1);
+}
+
+int step118(int x)
+{
+	return step119(x + 2);
+}
+
+int step119(int x)
+{
+	return step120(x + 3);
+}
+
+int step120(int x)
+{
+	return step121(x + 0);
+}
+
+int step121(int x)
+{
+	return step122(x + 1);
+}
+
+int step122(int x)
+{
+	return step123(x + 2);
+}
+
+int step123(int x)
+{
+	return step124(x + 3);
+}
+
+int step124(int x)
+{
+	return step125(x + 0);
+}
+
+int step125(int x)
+{
+	return step126(x + 1);
+}
+
+int step126(int x)
+{
+	return step127(x + 2);
+}
+
+int step127(int x)
+{
+	return step128(x + 3);
+}
+
+int step128(int x)
+{
+	return step129(x + 0);
+}
+
+int step129(int x)
+{
+	return step130(x + 1);
+}
+
+int step130(int x)
+{
+	return step131(x + 2);
+}
+
+int step131(int x)
+{
+	return step132(x + 3);
+}
+
+int step132(int x)
+{
+	return step133(x + 0);
+}
+
+int step133(int x)
+{
+	return step134(x + 1);
+}
+
+int step134(int x)
+{
+	return step135(x + 2);
+}
+
+int step135(int x)
+{
+	return step136(x + 3);
+}
+
+int step136(int x)
+{
+	return step137(x + 0);
+}
+
+int step137(int x)
+{
+	return step138(x + 1);
+}
+
+int step138(int x)
+{
+	return step139(x + 2);
+}
+
+int step139(int x)
+{
+	return step140(x + 3);
+}
+
+int step140(int x)
+{
+	return step141(x + 0);
+}
+
+int step141(int x)
+{
+	return step142(x + 1);
+}
+
+int step142(int x)
+{
+	return step143(x + 2);
+}
+
+int step143(int x)
+{
+	return step144(x + 3);
+}
+
+int step144(int x)
+{
+	return step145(x + 0);
+}
+
+int step145(int x)
+{
+	return step146(x + 1);
+}
+
+int step146(int x)
+{
+	return step147(x + 2);
+}
+
+int step147(int x)
+{
+	return step148(x + 3);
+}
+
+int step148(int x)
+{
+	return step149(x + 0);
+}
+
+int step149(int x)
+{
+	return step150(x + 1);
+}
+
+int step150(int x)
+{
+	return step151(x + 2);
+}
+
+int step151(int x)
+{
+	return step152(x + 3);
+}
+
+int step152(int x)
+{
+	return step153(x + 0);
+}
+
+int step153(int x)
+{
+	return step154(x + 1);
+}
+
+int step154(int x)
+{
+	return step155(x + 2);
+}
+
+int step155(int x)
+{
+	return step156(x + 3);
+}
+
+int step156(int x)
+{
+	return step157(x + 0);
+}
+
+int step157(int x)
+{
+	return step158(x + 1);
+}
+
+int step158(int x)
+{
+	return step159(x + 2);
+}
+
+int step159(int x)
+{
+	return step160(x + 3);
+}
+
+int step160(int x)
+{
+	return step161(x + 0);
+}
+
+int step161(int x)
+{
+	return step162(x + 1);
+}
+
+int step162(int x)
+{
+	return step163(x + 2);
+}
+
+int step163(int x)
+{
+	return step164(x + 3);
+}
+
+int step164(int x)
+{
+	return step165(x + 0);
+}
+
+int step165(int x)
+{
+	return step166(x + 1);
+}
+
+int step166(int x)
+{
+	return step167(x + 2);
+}
+
+int step167(int x)
+{
+	return step168(x + 3);
+}
+
+int step168(int x)
+{
+	return step169(x + 0);
+}
+
+int step169(int x)
+{
+	return step170(x + 1);
+}
+
+int step170(int x)
+{
+	return step171(x + 2);
+}
+
+int step171(int x)
+{
+	return step172(x + 3);
+}
+
+int step172(int x)
+{
+	return step173(x + 0);
+}
+
+int step173(int x)
+{
+	return step174(x + 1);
+}
+
+int step174(int x)
+{
+	return step175(x + 2);
+}
+
+int step175(int x)
+{
+	return step176(x + 3);
+}
+
+int step176(int x)
+{
+	return step177(x + 0);
+}
+
+int step177(int x)
+{
+	return step178(x + 1);
+}
+
+int step178(int x)
+{
+	return step179(x + 2);
+}
+
+int step179(int x)
+{
+	return step180(x + 3);
+}
+
+int step180(int x)
+{
+	return step181(x + 0);
+}
+
+int step181(int x)
+{
+	return step182(x + 1);
+}
+
+int step182(int x)
+{
+	return step183(x + 2);
+}
+
+int step183(int x)
+{
+	return step184(x + 3);
+}
+
+int step184(int x)
+{
+	return step185(x + 0);
+}
+
+int step185(int x)
+{
+	return step186(x + 1);
+}
+
+int step186(int x)
+{
+	return step187(x + 2);
+}
+
+int step187(int x)
+{
+	return step188(x + 3);
+}
+
+int step188(int x)
+{
+	return step189(x + 0);
+}
+
+int step189(int x)
+{
+	return x;
+}
+
+int main()
+{
+	int total = 0;
+	for (int k = 0; k < 3; k = k + 1)
+	{
+		total = total + step0(k);
+	}
+	printf("%d\n", total + step150(1));
+	return 0;
+}
@@ -0,0 +1,771 @@
+local step1, step2, step3, step4, step5, step6, step7, step8, step9, step10, step11, step12, step13, step14, step15, step16, step17, step18, step19, step20, step21, step22, step23, step24, step25, step26, step27, step28, step29, step30, step31, step32, step33, step34, step35, step36, step37, step38, step39, step40, step41, step42, step43, step44, step45, step46, step47, step48, step49, step50, step51, step52, step53, step54, step55, step56, step57, step58, step59, step60, step61, step62, step63, step64, step65, step66, step67, step68, step69, step70, step71, step72, step73, step74, step75, step76, step77, step78, step79, step80, step81, step82, step83, step84, step85, step86, step87, step88, step89, step90, step91, step92, step93, step94, step95, step96, step97, step98, step99, step100, step101, step102, step103, step104, step105, step106, step107, step108, step109, step110, step111, step112, step113, step114, step115, step116, step117, step118, step119, step120, step121, step122, step123, step124, step125, step126, step127, step128, step129, step130, step131, step132, step133, step134, step135, step136, step137, step138, step139, step140, step141, step142, step143, step144, step145, step146, step147, step148, step149, step150, step151, step152, step153, step154, step155, step156, step157, step158, step159, step160, step161, step162, step163, step164, step165, step166, step167, step168, step169, step170, step171, step172, step173, step174, step175, step176, step177, step178
+local __fn = {}
+
+local function step0(x)
+	return step1(x)
+end
+
+function step1(x)
+	return step2(x + 1)
+end
+
+function step2(x)
+	return step3(x + 2)
+end
+
+function step3(x)
+	return step4(x + 3)
+end
+
+function step4(x)
+	return step5(x)
+end
+
+function step5(x)
+	return step6(x + 1)
+end
+
+function step6(x)
+	return step7(x + 2)
+end
+
+function step7(x)
+	return step8(x + 3)
+end
+
+function step8(x)
+	return step9(x)
+end
+
+function step9(x)
+	return step10(x + 1)
+end
+
+function step10(x)
+	return step11(x + 2)
+end
+
+function step11(x)
+	return step12(x + 3)
+end
+
+function step12(x)
+	return step13(x)
+end
+
+function step13(x)
+	return step14(x + 1)
+end
+
+function step14(x)
+	return step15(x + 2)
+end
+
+function step15(x)
+	return step16(x + 3)
+end
+
+function step16(x)
+	return step17(x)
+end
+
+function step17(x)
+	return step18(x + 1)
+end
+
+function step18(x)
+	return step19(x + 2)
+end
+
+function step19(x)
+	return step20(x + 3)
+end
+
+function step20(x)
+	return step21(x)
+end
+
+function step21(x)
+	return step22(x + 1)
+end
+
+function step22(x)
+	return step23(x + 2)
+end
+
+function step23(x)
+	return step24(x + 3)
+end
+
+function step24(x)
+	return step25(x)
+end
+
+function step25(x)
+	return step26(x + 1)
+end
+
+function step26(x)
+	return step27(x + 2)
+end
+
+function step27(x)
+	return step28(x + 3)
+end
+
+function step28(x)
+	return step29(x)
+end
+
+function step29(x)
+	return step30(x + 1)
+end
+
+function step30(x)
+	return step31(x + 2)
+end
+
+function step31(x)
+	return step32(x + 3)
+end
+
+function step32(x)
+	return step33(x)
+end
+
+function step33(x)
+	return step34(x + 1)
+end
+
+function step34(x)
+	return step35(x + 2)
+end
+
+function step35(x)
+	return step36(x + 3)
+end
+
+function step36(x)
+	return step37(x)
+end
+
+function step37(x)
+	return step38(x + 1)
+end
+
+function step38(x)
+	return step39(x + 2)
+end
+
+function step39(x)
+	return step40(x + 3)
+end
+
+function step40(x)
+	return step41(x)
+end
+
+function step41(x)
+	return step42(x + 1)
+end
+
+function step42(x)
+	return step43(x + 2)
+end
+
+function step43(x)
+	return step44(x + 3)
+end
+
+function step44(x)
+	return step45(x)
+end
+
+function step45(x)
+	return step46(x + 1)
+end
+
+function step46(x)
+	return step47(x + 2)
+end
+
+function step47(x)
+	return step48(x + 3)
+end
+
+function step48(x)
+	return step49(x)
+end
+
+function step49(x)
+	return step50(x + 1)
+end
+
+function step50(x)
+	return step51(x + 2)
+end
+
+function step51(x)
+	return step52(x + 3)
+end
+
+function step52(x)
+	return step53(x)
+end
+
+function step53(x)
+	return step54(x + 1)
+end
+
+function step54(x)
+	return step55(x + 2)
+end
+
+function step55(x)
+	return step56(x + 3)
+end
+
+function step56(x)
+	return step57(x)
+end
+
+function step57(x)
+	return step58(x + 1)
+end
+
+function step58(x)
+	return step59(x + 2)
+end
+
+function step59(x)
+	return step60(x + 3)
+end
+
+function step60(x)
+	return step61(x)
+end
+
+function step61(x)
+	return step62(x + 1)
+end
+
+function step62(x)
+	return step63(x + 2)
+end
+
+function step63(x)
+	return step64(x + 3)
+end
+
+function step64(x)
+	return step65(x)
+end
+
+function step65(x)
+	return step66(x + 1)
+end
+
+function step66(x)
+	return step67(x + 2)
+end
+
+function step67(x)
+	return step68(x + 3)
+end
+
+function step68(x)
+	return step69(x)
+end
+
+function step69(x)
+	return step70(x + 1)
+end
+
+function step70(x)
+	return step71(x + 2)
+end
+
+function step71(x)
+	return step72(x + 3)
+end
+
+function step72(x)
+	return step73(x)
+end
+
+function step73(x)
+	return step74(x + 1)
+end
+
+function step74(x)
+	return step75(x + 2)
+end
+
+function step75(x)
+	return step76(x + 3)
+end
+
+function step76(x)
+	return step77(x)
+end
+
+function step77(x)
+	return step78(x + 1)
+end
+
+function step78(x)
+	return step79(x + 2)
+end
+
+function step79(x)
+	return step80(x + 3)
+end
+
+function step80(x)
+	return step81(x)
+end
+
+function step81(x)
+	return step82(x + 1)
+end
+
+function step82(x)
+	return step83(x + 2)
+end
+
+function step83(x)
+	return step84(x + 3)
+end
+
+function step84(x)
+	return step85(x)
+end
+
+function step85(x)
+	return step86(x + 1)
+end
+
+function step86(x)
+	return step87(x + 2)
+end
+
+function step87(x)
+	return step88(x + 3)
+end
+
+function step88(x)
+	return step89(x)
+end
+
+function step89(x)
+	return step90(x + 1)
+end
+
+function step90(x)
+	return step91(x + 2)
+end
+
+function step91(x)
+	return step92(x + 3)
+end
+
+function step92(x)
+	return step93(x)
+end
+
+function step93(x)
+	return step94(x + 1)
+end
+
+function step94(x)
+	return step95(x + 2)
+end
+
+function step95(x)
+	return step96(x + 3)
+end
+
+function step96(x)
+	return step97(x)
+end
+
+function step97(x)
+	return step98(x + 1)
+end
+
+function step98(x)
+	return step99(x + 2)
+end
+
+function step99(x)
+	return step100(x + 3)
+end
+
+function step100(x)
+	return step101(x)
+end
+
+function step101(x)
+	return step102(x + 1)
+end
+
+function step102(x)
+	return step103(x + 2)
+end
+
+function step103(x)
+	return step104(x + 3)
+end
+
+function step104(x)
+	return step105(x)
+end
+
+function step105(x)
+	return step106(x + 1)
+end
+
+function step106(x)
+	return step107(x + 2)
+end
+
+function step107(x)
+	return step108(x + 3)
+end
+
+function step108(x)
+	return step109(x)
+end
+
+function step109(x)
+	return step110(x + 1)
+end
+
+function step110(x)
+	return step111(x + 2)
+end
+
+function step111(x)
+	return step112(x + 3)
+end
+
+function step112(x)
+	return step113(x)
+end
+
+function step113(x)
+	return step114(x + 1)
+end
+
+function step114(x)
+	return step115(x + 2)
+end
+
+function step115(x)
+	return step116(x + 3)
+end
+
+function step116(x)
+	return step117(x)
+end
+
+function step117(x)
+	return step118(x + 1)
+end
+
+function step118(x)
+	return step119(x + 2)
+end
+
+function step119(x)
+	return step120(x + 3)
+end
+
+function step120(x)
+	return step121(x)
+end
+
+function step121(x)
+	return step122(x + 1)
+end
+
+function step122(x)
+	return step123(x + 2)
+end
+
+function step123(x)
+	return step124(x + 3)
+end
+
+function step124(x)
+	return step125(x)
+end
+
+function step125(x)
+	return step126(x + 1)
+end
+
+function step126(x)
+	return step127(x + 2)
+end
+
+function step127(x)
+	return step128(x + 3)
+end
+
+function step128(x)
+	return step129(x)
+end
+
+function step129(x)
+	return step130(x + 1)
+end
+
+function step130(x)
+	return step131(x + 2)
+end
+
+function step131(x)
+	return step132(x + 3)
+end
+
+function step132(x)
+	return step133(x)
+end
+
+function step133(x)
+	return step134(x + 1)
+end
+
+function step134(x)
+	return step135(x + 2)
+end
+
+function step135(x)
+	return step136(x + 3)
+end
+
+function step136(x)
+	return step137(x)
+end
+
+function step137(x)
+	return step138(x + 1)
+end
+
+function step138(x)
+	return step139(x + 2)
+end
+
+function step139(x)
+	return step140(x + 3)
+end
+
+function step140(x)
+	return step141(x)
+end
+
+function step141(x)
+	return step142(x + 1)
+end
+
+function step142(x)
+	return step143(x + 2)
+end
+
+function step143(x)
+	return step144(x + 3)
+end
+
+function step144(x)
+	return step145(x)
+end
+
+function step145(x)
+	return step146(x + 1)
+end
+
+function step146(x)
+	return step147(x + 2)
+end
+
+function step147(x)
+	return step148(x + 3)
+end
+
+function step148(x)
+	return step149(x)
+end
+
+function step149(x)
+	return step150(x + 1)
+end
+
+function step150(x)
+	return step151(x + 2)
+end
+
+function step151(x)
+	return step152(x + 3)
+end
+
+function step152(x)
+	return step153(x)
+end
+
+function step153(x)
+	return step154(x + 1)
+end
+
+function step154(x)
+	return step155(x + 2)
+end
+
+function step155(x)
+	return step156(x + 3)
+end
+
+function step156(x)
+	return step157(x)
+end
+
+function step157(x)
+	return step158(x + 1)
+end
+
+function step158(x)
+	return step159(x + 2)
+end
+
+function step159(x)
+	return step160(x + 3)
+end
+
+function step160(x)
+	return step161(x)
+end
+
+function step161(x)
+	return step162(x + 1)
+end
+
+function step162(x)
+	return step163(x + 2)
+end
+
+function step163(x)
+	return step164(x + 3)
+end
+
+function step164(x)
+	return step165(x)
+end
+
+function step165(x)
+	return step166(x + 1)
+end
+
+function step166(x)
+	return step167(x + 2)
+end
+
+function step167(x)
+	return step168(x + 3)
+end
+
+function step168(x)
+	return step169(x)
+end
+
+function step169(x)
+	return step170(x + 1)
+end
+
+function step170(x)
+	return step171(x + 2)
+end
+
+function step171(x)
+	return step172(x + 3)
+end
+
+function step172(x)
+	return step173(x)
+end
+
+function step173(x)
+	return step174(x + 1)
+end
+
+function step174(x)
+	return step175(x + 2)
+end
+
+function step175(x)
+	return step176(x + 3)
+end
+
+function step176(x)
+	return step177(x)
+end
+
+function step177(x)
+	return step178(x + 1)
+end
+
+function step178(x)
+	return __fn.step179(x + 2)
+end
+
+function __fn.step179(x)
+	return __fn.step180(x + 3)
+end
+
+function __fn.step180(x)
+	return __fn.step181(x)
+end
+
+function __fn.step181(x)
+	return __fn.step182(x + 1)
+end
+
+function __fn.step182(x)
+	return __fn.step183(x + 2)
+end
+
+function __fn.step183(x)
+	return __fn.step184(x + 3)
+end
+
+function __fn.step184(x)
+	return __fn.step185(x)
+end
+
+function __fn.step185(x)
+	return __fn.step186(x + 1)
+end
+
+function __fn.step186(x)
+	return __fn.step187(x + 2)
+end
+
+function __fn.step187(x)
+	return __fn.step188(x + 3)
+end
+
+function __fn.step188(x)
+	return __fn.step189(x)
+end
+
+function __fn.step189(x)
+	return x
+end
+
+os.exit((function(args)
+	local total = 0
+	for k = 0, 2 do
+		total = total + step0(k)
+	end
+	print(string.format("%d", total + 60))
+	return 0
+end)(arg))
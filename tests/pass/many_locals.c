@@ -0,0 +1,1012 @@
+int chain(int n)
+{
+	int v0 = n + 1;
+	int v1 = v0 * 3 % 1000 + 1;
+	int v2 = v1 * 3 % 1000 + 2;
+	int v3 = v2 * 3 % 1000 + 3;
+	int v4 = v3 * 3 % 1000 + 4;
+	int v5 = v4 * 3 % 1000 + 5;
+	int v6 = v5 * 3 % 1000 + 6;
+	int v7 = v6 * 3 % 1000 + 7;
+	int v8 = v7 * 3 % 1000 + 8;
+	int v9 = v8 * 3 % 1000 + 9;
+	int v10 = v9 * 3 % 1000 + 10;
+	int v11 = v10 * 3 % 1000 + 11;
+	int v12 = v11 * 3 % 1000 + 12;
+	int v13 = v12 * 3 % 1000 + 13;
+	int v14 = v13 * 3 % 1000 + 14;
+	int v15 = v14 * 3 % 1000 + 15;
+	int v16 = v15 * 3 % 1000 + 16;
+	int v17 = v16 * 3 % 1000 + 17;
+	int v18 = v17 * 3 % 1000 + 18;
+	int v19 = v18 * 3 % 1000 + 19;
+	int v20 = v19 * 3 % 1000 + 20;
+	int v21 = v20 * 3 % 1000 + 21;
+	int v22 = v21 * 3 % 1000 + 22;
+	int v23 = v22 * 3 % 1000 + 23;
+	int v24 = v23 * 3 % 1000 + 24;
+	int v25 = v24 * 3 % 1000 + 25;
+	int v26 = v25 * 3 % 1000 + 26;
+	int v27 = v26 * 3 % 1000 + 27;
+	int v28 = v27 * 3 % 1000 + 28;
+	int v29 = v28 * 3 % 1000 + 29;
+	int v30 = v29 * 3 % 1000 + 30;
+	int v31 = v30 * 3 % 1000 + 31;
+	int v32 = v31 * 3 % 1000 + 32;
+	int v33 = v32 * 3 % 1000 + 33;
+	int v34 = v33 * 3 % 1000 + 34;
+	int v35 = v34 * 3 % 1000 + 35;
+	int v36 = v35 * 3 % 1000 + 36;
+	int v37 = v36 * 3 % 1000 + 37;
+	int v38 = v37 * 3 % 1000 + 38;
+	int v39 = v38 * 3 % 1000 + 39;
+	int v40 = v39 * 3 % 1000 + 40;
+	int v41 = v40 * 3 % 1000 + 41;
+	int v42 = v41 * 3 % 1000 + 42;
+	int v43 = v42 * 3 % 1000 + 43;
+	int v44 = v43 * 3 % 1000 + 44;
+	int v45 = v44 * 3 % 1000 + 45;
+	int v46 = v45 * 3 % 1000 + 46;
+	int v47 = v46 * 3 % 1000 + 47;
+	int v48 = v47 * 3 % 1000 + 48;
+	int v49 = v48 * 3 % 1000 + 49;
+	int v50 = v49 * 3 % 1000 + 50;
+	int v51 = v50 * 3 % 1000 + 51;
+	int v52 = v51 * 3 % 1000 + 52;
+	int v53 = v52 * 3 % 1000 + 53;
+	int v54 = v53 * 3 % 1000 + 54;
+	int v55 = v54 * 3 % 1000 + 55;
+	int v56 = v55 * 3 % 1000 + 56;
+	int v57 = v56 * 3 % 1000 + 57;
+	int v58 = v57 * 3 % 1000 + 58;
+	int v59 = v58 * 3 % 1000 + 59;
+	int v60 = v59 * 3 % 1000 + 60;
+	int v61 = v60 * 3 % 1000 + 61;
+	int v62 = v61 * 3 % 1000 + 62;
+	int v63 = v62 * 3 % 1000 + 63;
+	int v64 = v63 * 3 % 1000 + 64;
+	int v65 = v64 * 3 % 1000 + 65;
+	int v66 = v65 * 3 % 1000 + 66;
+	int v67 = v66 * 3 % 1000 + 67;
+	int v68 = v67 * 3 % 1000 + 68;
+	int v69 = v68 * 3 % 1000 + 69;
+	int v70 = v69 * 3 % 1000 + 70;
+	int v71 = v70 * 3 % 1000 + 71;
+	int v72 = v71 * 3 % 1000 + 72;
+	int v73 = v72 * 3 % 1000 + 73;
+	int v74 = v73 * 3 % 1000 + 74;
+	int v75 = v74 * 3 % 1000 + 75;
+	int v76 = v75 * 3 % 1000 + 76;
+	int v77 = v76 * 3 % 1000 + 77;
+	int v78 = v77 * 3 % 1000 + 78;
+	int v79 = v78 * 3 % 1000 + 79;
+	int v80 = v79 * 3 % 1000 + 80;
+	int v81 = v80 * 3 % 1000 + 81;
+	int v82 = v81 * 3 % 1000 + 82;
+	int v83 = v82 * 3 % 1000 + 83;
+	int v84 = v83 * 3 % 1000 + 84;
+	int v85 = v84 * 3 % 1000 + 85;
+	int v86 = v85 * 3 % 1000 + 86;
+	int v87 = v86 * 3 % 1000 + 87;
+	int v88 = v87 * 3 % 1000 + 88;
+	int v89 = v88 * 3 % 1000 + 89;
+	int v90 = v89 * 3 % 1000 + 90;
+	int v91 = v90 * 3 % 1000 + 91;
+	int v92 = v91 * 3 % 1000 + 92;
+	int v93 = v92 * 3 % 1000 + 93;
+	int v94 = v93 * 3 % 1000 + 94;
+	int v95 = v94 * 3 % 1000 + 95;
+	int v96 = v95 * 3 % 1000 + 96;
+	int v97 = v96 * 3 % 1000 + 97;
+	int v98 = v97 * 3 % 1000 + 98;
+	int v99 = v98 * 3 % 1000 + 99;
+	int v100 = v99 * 3 % 1000 + 100;
+	int v101 = v100 * 3 % 1000 + 101;
+	int v102 = v101 * 3 % 1000 + 102;
+	int v103 = v102 * 3 % 1000 + 103;
+	int v104 = v103 * 3 % 1000 + 104;
+	int v105 = v104 * 3 % 1000 + 105;
+	int v106 = v105 * 3 % 1000 + 106;
+	int v107 = v106 * 3 % 1000 + 107;
+	int v108 = v107 * 3 % 1000 + 108;
+	int v109 = v108 * 3 % 1000 + 109;
+	int v110 = v109 * 3 % 1000 + 110;
+	int v111 = v110 * 3 % 1000 + 111;
+	int v112 = v111 * 3 % 1000 + 112;
+	int v113 = v112 * 3 % 1000 + 113;
+	int v114 = v113 * 3 % 1000 + 114;
+	int v115 = v114 * 3 % 1000 + 115;
+	int v116 = v115 * 3 % 1000 + 116;
+	int v117 = v116 * 3 % 1000 + 117;
+	int v118 = v117 * 3 % 1000 + 118;
+	int v119 = v118 * 3 % 1000 + 119;
+	int v120 = v119 * 3 % 1000 + 120;
+	int v121 = v120 * 3 % 1000 + 121;
+	int v122 = v121 * 3 % 1000 + 122;
+	int v123 = v122 * 3 % 1000 + 123;
+	int v124 = v123 * 3 % 1000 + 124;
+	int v125 = v124 * 3 % 1000 + 125;
+	int v126 = v125 * 3 % 1000 + 126;
+	int v127 = v126 * 3 % 1000 + 127;
+	int v128 = v127 * 3 % 1000 + 128;
+	int v129 = v128 * 3 % 1000 + 129;
+	int v130 = v129 * 3 % 1000 + 130;
+	int v131 = v130 * 3 % 1000 + 131;
+	int v132 = v131 * 3 % 1000 + 132;
+	int v133 = v132 * 3 % 1000 + 133;
+	int v134 = v133 * 3 % 1000 + 134;
+	int v135 = v134 * 3 % 1000 + 135;
+	int v136 = v135 * 3 % 1000 + 136;
+	int v137 = v136 * 3 % 1000 + 137;
+	int v138 = v137 * 3 % 1000 + 138;
+	int v139 = v138 * 3 % 1000 + 139;
+	int v140 = v139 * 3 % 1000 + 140;
+	int v141 = v140 * 3 % 1000 + 141;
+	int v142 = v141 * 3 % 1000 + 142;
+	int v143 = v142 * 3 % 1000 + 143;
+	int v144 = v143 * 3 % 1000 + 144;
+	int v145 = v144 * 3 % 1000 + 145;
+	int v146 = v145 * 3 % 1000 + 146;
+	int v147 = v146 * 3 % 1000 + 147;
+	int v148 = v147 * 3 % 1000 + 148;
+	int v149 = v148 * 3 % 1000 + 149;
+	int v150 = v149 * 3 % 1000 + 150;
+	int v151 = v150 * 3 % 1000 + 151;
+	int v152 = v151 * 3 % 1000 + 152;
+	int v153 = v152 * 3 % 1000 + 153;
+	int v154 = v153 * 3 % 1000 + 154;
+	int v155 = v154 * 3 % 1000 + 155;
+	int v156 = v155 * 3 % 1000 + 156;
+	int v157 = v156 * 3 % 1000 + 157;
+	int v158 = v157 * 3 % 1000 + 158;
+	int v159 = v158 * 3 % 1000 + 159;
+	int v160 = v159 * 3 % 1000 + 160;
+	int v161 = v160 * 3 % 1000 + 161;
+	int v162 = v161 * 3 % 1000 + 162;
+	int v163 = v162 * 3 % 1000 + 163;
+	int v164 = v163 * 3 % 1000 + 164;
+	int v165 = v164 * 3 % 1000 + 165;
+	int v166 = v165 * 3 % 1000 + 166;
+	int v167 = v166 * 3 % 1000 + 167;
+	int v168 = v167 * 3 % 1000 + 168;
+	int v169 = v168 * 3 % 1000 + 169;
+	int v170 = v169 * 3 % 1000 + 170;
+	int v171 = v170 * 3 % 1000 + 171;
+	int v172 = v171 * 3 % 1000 + 172;
+	int v173 = v172 * 3 % 1000 + 173;
+	int v174 = v173 * 3 % 1000 + 174;
+	int v175 = v174 * 3 % 1000 + 175;
+	int v176 = v175 * 3 % 1000 + 176;
+	int v177 = v176 * 3 % 1000 + 177;
+	int v178 = v177 * 3 % 1000 + 178;
+	int v179 = v178 * 3 % 1000 + 179;
+	int v180 = v179 * 3 % 1000 + 180;
+	int v181 = v180 * 3 % 1000 + 181;
+	int v182 = v181 * 3 % 1000 + 182;
+	int v183 = v182 * 3 % 1000 + 183;
+	int v184 = v183 * 3 % 1000 + 184;
+	int v185 = v184 * 3 % 1000 + 185;
+	int v186 = v185 * 3 % 1000 + 186;
+	int v187 = v186 * 3 % 1000 + 187;
+	int v188 = v187 * 3 % 1000 + 188;
+	int v189 = v188 * 3 % 1000 + 189;
+	int v190 = v189 * 3 % 1000 + 190;
+	int v191 = v190 * 3 % 1000 + 191;
+	int v192 = v191 * 3 % 1000 + 192;
+	int v193 = v192 * 3 % 1000 + 193;
+	int v194 = v193 * 3 % 1000 + 194;
+	int v195 = v194 * 3 % 1000 + 195;
+	int v196 = v195 * 3 % 1000 + 196;
+	int v197 = v196 * 3 % 1000 + 197;
+	int v198 = v197 * 3 % 1000 + 198;
+	int v199 = v198 * 3 % 1000 + 199;
+	int v200 = v199 * 3 % 1000 + 200;
+	int v201 = v200 * 3 % 1000 + 201;
+	int v202 = v201 * 3 % 1000 + 202;
+	int v203 = v202 * 3 % 1000 + 203;
+	int v204 = v203 * 3 % 1000 + 204;
+	return v204;
+}
+
+int wide(int n)
+{
+	int w0 = n + 0;
+	int w1 = n + 1;
+	int w2 = n + 2;
+	int w3 = n + 3;
+	int w4 = n + 4;
+	int w5 = n + 5;
+	int w6 = n + 6;
+	int w7 = n + 7;
+	int w8 = n + 8;
+	int w9 = n + 9;
+	int w10 = n + 10;
+	int w11 = n + 11;
+	int w12 = n + 12;
+	int w13 = n + 13;
+	int w14 = n + 14;
+	int w15 = n + 15;
+	int w16 = n + 16;
+	int w17 = n + 17;
+	int w18 = n + 18;
+	int w19 = n + 19;
+	int w20 = n + 20;
+	int w21 = n + 21;
+	int w22 = n + 22;
+	int w23 = n + 23;
+	int w24 = n + 24;
+	int w25 = n + 25;
+	int w26 = n + 26;
+	int w27 = n + 27;
+	int w28 = n + 28;
+	int w29 = n + 29;
+	int w30 = n + 30;
+	int w31 = n + 31;
+	int w32 = n + 32;
+	int w33 = n + 33;
+	int w34 = n + 34;
+	int w35 = n + 35;
+	int w36 = n + 36;
+	int w37 = n + 37;
+	int w38 = n + 38;
+	int w39 = n + 39;
+	int w40 = n + 40;
+	int w41 = n + 41;
+	int w42 = n + 42;
+	int w43 = n + 43;
+	int w44 = n + 44;
+	int w45 = n + 45;
+	int w46 = n + 46;
+	int w47 = n + 47;
+	int w48 = n + 48;
+	int w49 = n + 49;
+	int w50 = n + 50;
+	int w51 = n + 51;
+	int w52 = n + 52;
+	int w53 = n + 53;
+	int w54 = n + 54;
+	int w55 = n + 55;
+	int w56 = n + 56;
+	int w57 = n + 57;
+	int w58 = n + 58;
+	int w59 = n + 59;
+	int w60 = n + 60;
+	int w61 = n + 61;
+	int w62 = n + 62;
+	int w63 = n + 63;
+	int w64 = n + 64;
+	int w65 = n + 65;
+	int w66 = n + 66;
+	int w67 = n + 67;
+	int w68 = n + 68;
+	int w69 = n + 69;
+	int w70 = n + 70;
+	int w71 = n + 71;
+	int w72 = n + 72;
+	int w73 = n + 73;
+	int w74 = n + 74;
+	int w75 = n + 75;
+	int w76 = n + 76;
+	int w77 = n + 77;
+	int w78 = n + 78;
+	int w79 = n + 79;
+	int w80 = n + 80;
+	int w81 = n + 81;
+	int w82 = n + 82;
+	int w83 = n + 83;
+	int w84 = n + 84;
+	int w85 = n + 85;
+	int w86 = n + 86;
+	int w87 = n + 87;
+	int w88 = n + 88;
+	int w89 = n + 89;
+	int w90 = n + 90;
+	int w91 = n + 91;
+	int w92 = n + 92;
+	int w93 = n + 93;
+	int w94 = n + 94;
+	int w95 = n + 95;
+	int w96 = n + 96;
+	int w97 = n + 97;
+	int w98 = n + 98;
+	int w99 = n + 99;
+	int w100 = n + 100;
+	int w101 = n + 101;
+	int w102 = n + 102;
+	int w103 = n + 103;
+	int w104 = n + 104;
+	int w105 = n + 105;
+	int w106 = n + 106;
+	int w107 = n + 107;
+	int w108 = n + 108;
+	int w109 = n + 109;
+	int w110 = n + 110;
+	int w111 = n + 111;
+	int w112 = n + 112;
+	int w113 = n + 113;
+	int w114 = n + 114;
+	int w115 = n + 115;
+	int w116 = n + 116;
+	int w117 = n + 117;
+	int w118 = n + 118;
+	int w119 = n + 119;
+	int w120 = n + 120;
+	int w121 = n + 121;
+	int w122 = n + 122;
+	int w123 = n + 123;
+	int w124 = n + 124;
+	int w125 = n + 125;
+	int w126 = n + 126;
+	int w127 = n + 127;
+	int w128 = n + 128;
+	int w129 = n + 129;
+	int w130 = n + 130;
+	int w131 = n + 131;
+	int w132 = n + 132;
+	int w133 = n + 133;
+	int w134 = n + 134;
+	int w135 = n + 135;
+	int w136 = n + 136;
+	int w137 = n + 137;
+	int w138 = n + 138;
+	int w139 = n + 139;
+	int w140 = n + 140;
+	int w141 = n + 141;
+	int w142 = n + 142;
+	int w143 = n + 143;
+	int w144 = n + 144;
+	int w145 = n + 145;
+	int w146 = n + 146;
+	int w147 = n + 147;
+	int w148 = n + 148;
+	int w149 = n + 149;
+	int w150 = n + 150;
+	int w151 = n + 151;
+	int w152 = n + 152;
+	int w153 = n + 153;
+	int w154 = n + 154;
+	int w155 = n + 155;
+	int w156 = n + 156;
+	int w157 = n + 157;
+	int w158 = n + 158;
+	int w159 = n + 159;
+	int w160 = n + 160;
+	int w161 = n + 161;
+	int w162 = n + 162;
+	int w163 = n + 163;
+	int w164 = n + 164;
+	int w165 = n + 165;
+	int w166 = n + 166;
+	int w167 = n + 167;
+	int w168 = n + 168;
+	int w169 = n + 169;
+	int w170 = n + 170;
+	int w171 = n + 171;
+	int w172 = n + 172;
+	int w173 = n + 173;
+	int w174 = n + 174;
+	int w175 = n + 175;
+	int w176 = n + 176;
+	int w177 = n + 177;
+	int w178 = n + 178;
+	int w179 = n + 179;
+	int w180 = n + 180;
+	int w181 = n + 181;
+	int w182 = n + 182;
+	int w183 = n + 183;
+	int w184 = n + 184;
+	int w185 = n + 185;
+	int w186 = n + 186;
+	int w187 = n + 187;
+	int w188 = n + 188;
+	int w189 = n + 189;
+	int w190 = n + 190;
+	int w191 = n + 191;
+	int w192 = n + 192;
+	int w193 = n + 193;
+	int w194 = n + 194;
+	int w195 = n + 195;
+	int w196 = n + 196;
+	int w197 = n + 197;
+	int w198 = n + 198;
+	int w199 = n + 199;
+	int w200 = n + 200;
+	int w201 = n + 201;
+	int w202 = n + 202;
+	int w203 = n + 203;
+	int w204 = n + 204;
+	int total = 0;
+	total = total + w0;
+	total = total + w1;
+	total = total + w2;
+	total = total + w3;
+	total = total + w4;
+	total = total + w5;
+	total = total + w6;
+	total = total + w7;
+	total = total + w8;
+	total = total + w9;
+	total = total + w10;
+	total = total + w11;
+	total = total + w12;
+	total = total + w13;
+	total = total + w14;
+	total = total + w15;
+	total = total + w16;
+	total = total + w17;
+	total = total + w18;
+	total = total + w19;
+	total = total + w20;
+	total = total + w21;
+	total = total + w22;
+	total = total + w23;
+	total = total + w24;
+	total = total + w25;
+	total = total + w26;
+	total = total + w27;
+	total = total + w28;
+	total = total + w29;
+	total = total + w30;
+	total = total + w31;
+	total = total + w32;
+	total = total + w33;
+	total = total + w34;
+	total = total + w35;
+	total = total + w36;
+	total = total + w37;
+	total = total + w38;
+	total = total + w39;
+	total = total + w40;
+	total = total + w41;
+	total = total + w42;
+	total = total + w43;
+	total = total + w44;
+	total = total + w45;
+	total = total + w46;
+	total = total + w47;
+	total = total + w48;
+	total = total + w49;
+	total = total + w50;
+	total = total + w51;
+	total = total + w52;
+	total = total + w53;
+	total = total + w54;
+	total = total + w55;
+	total = total + w56;
+	total = total + w57;
+	total = total + w58;
+	total = total + w59;
+	total = total + w60;
+	total = total + w61;
+	total = total + w62;
+	total = total + w63;
+	total = total + w64;
+	total = total + w65;
+	total = total + w66;
+	total = total + w67;
+	total = total + w68;
+	total = total + w69;
+	total = total + w70;
+	total = total + w71;
+	total = total + w72;
+	total = total + w73;
+	total = total + w74;
+	total = total + w75;
+	total = total + w76;
+	total = total + w77;
+	total = total + w78;
+	total = total + w79;
+	total = total + w80;
+	total = total + w81;
+	total = total + w82;
+	total = total + w83;
+	total = total + w84;
+	total = total + w85;
+	total = total + w86;
+	total = total + w87;
+	total = total + w88;
+	total = total + w89;
+	total = total + w90;
+	total = total + w91;
+	total = total + w92;
+	total = total + w93;
+	total = total + w94;
+	total = total + w95;
+	total = total + w96;
+	total = total + w97;
+	total = total + w98;
+	total = total + w99;
+	total = total + w100;
+	total = total + w101;
+	total = total + w102;
+	total = total + w103;
+	total = total + w104;
+	total = total + w105;
+	total = total + w106;
+	total = total + w107;
+	total = total + w108;
+	total = total + w109;
+	total = total + w110;
+	total = total + w111;
+	total = total + w112;
+	total = total + w113;
+	total = total + w114;
+	total = total + w115;
+	total = total + w116;
+	total = total + w117;
+	total = total + w118;
+	total = total + w119;
+	total = total + w120;
+	total = total + w121;
+	total = total + w122;
+	total = total + w123;
+	total = total + w124;
+	total = total + w125;
+	total = total + w126;
+	total = total + w127;
+	total = total + w128;
+	total = total + w129;
+	total = total + w130;
+	total = total + w131;
+	total = total + w132;
+	total = total + w133;
+	total = total + w134;
+	total = total + w135;
+	total = total + w136;
+	total = total + w137;
+	total = total + w138;
+	total = total + w139;
+	total = total + w140;
+	total = total + w141;
+	total = total + w142;
+	total = total + w143;
+	total = total + w144;
+	total = total + w145;
+	total = total + w146;
+	total = total + w147;
+	total = total + w148;
+	total = total + w149;
+	total = total + w150;
+	total = total + w151;
+	total = total + w152;
+	total = total + w153;
+	total = total + w154;
+	total = total + w155;
+	total = total + w156;
+	total = total + w157;
+	total = total + w158;
+	total = total + w159;
+	total = total + w160;
+	total = total + w161;
+	total = total + w162;
+	total = total + w163;
+	total = total + w164;
+	total = total + w165;
+	total = total + w166;
+	total = total + w167;
+	total = total + w168;
+	total = total + w169;
+	total = total + w170;
+	total = total + w171;
+	total = total + w172;
+	total = total + w173;
+	total = total + w174;
+	total = total + w175;
+	total = total + w176;
+	total = total + w177;
+	total = total + w178;
+	total = total + w179;
+	total = total + w180;
+	total = total + w181;
+	total = total + w182;
+	total = total + w183;
+	total = total + w184;
+	total = total + w185;
+	total = total + w186;
+	total = total + w187;
+	total = total + w188;
+	total = total + w189;
+	total = total + w190;
+	total = total + w191;
+	total = total + w192;
+	total = total + w193;
+	total = total + w194;
+	total = total + w195;
+	total = total + w196;
+	total = total + w197;
+	total = total + w198;
+	total = total + w199;
+	total = total + w200;
+	total = total + w201;
+	total = total + w202;
+	total = total + w203;
+	total = total + w204;
+	return total;
+}
+
+int shadow(int n)
+{
+	int s0 = n + 0;
+	int s1 = n + 1;
+	int s2 = n + 2;
+	int s3 = n + 3;
+	int s4 = n + 4;
+	int s5 = n + 5;
+	int s6 = n + 6;
+	int s7 = n + 7;
+	int s8 = n + 8;
+	int s9 = n + 9;
+	int s10 = n + 10;
+	int s11 = n + 11;
+	int s12 = n + 12;
+	int s13 = n + 13;
+	int s14 = n + 14;
+	int s15 = n + 15;
+	int s16 = n + 16;
+	int s17 = n + 17;
+	int s18 = n + 18;
+	int s19 = n + 19;
+	int s20 = n + 20;
+	int s21 = n + 21;
+	int s22 = n + 22;
+	int s23 = n + 23;
+	int s24 = n + 24;
+	int s25 = n + 25;
+	int s26 = n + 26;
+	int s27 = n + 27;
+	int s28 = n + 28;
+	int s29 = n + 29;
+	int s30 = n + 30;
+	int s31 = n + 31;
+	int s32 = n + 32;
+	int s33 = n + 33;
+	int s34 = n + 34;
+	int s35 = n + 35;
+	int s36 = n + 36;
+	int s37 = n + 37;
+	int s38 = n + 38;
+	int s39 = n + 39;
+	int s40 = n + 40;
+	int s41 = n + 41;
+	int s42 = n + 42;
+	int s43 = n + 43;
+	int s44 = n + 44;
+	int s45 = n + 45;
+	int s46 = n + 46;
+	int s47 = n + 47;
+	int s48 = n + 48;
+	int s49 = n + 49;
+	int s50 = n + 50;
+	int s51 = n + 51;
+	int s52 = n + 52;
+	int s53 = n + 53;
+	int s54 = n + 54;
+	int s55 = n + 55;
+	int s56 = n + 56;
+	int s57 = n + 57;
+	int s58 = n + 58;
+	int s59 = n + 59;
+	int s60 = n + 60;
+	int s61 = n + 61;
+	int s62 = n + 62;
+	int s63 = n + 63;
+	int s64 = n + 64;
+	int s65 = n + 65;
+	int s66 = n + 66;
+	int s67 = n + 67;
+	int s68 = n + 68;
+	int s69 = n + 69;
+	int s70 = n + 70;
+	int s71 = n + 71;
+	int s72 = n + 72;
+	int s73 = n + 73;
+	int s74 = n + 74;
+	int s75 = n + 75;
+	int s76 = n + 76;
+	int s77 = n + 77;
+	int s78 = n + 78;
+	int s79 = n + 79;
+	int s80 = n + 80;
+	int s81 = n + 81;
+	int s82 = n + 82;
+	int s83 = n + 83;
+	int s84 = n + 84;
+	int s85 = n + 85;
+	int s86 = n + 86;
+	int s87 = n + 87;
+	int s88 = n + 88;
+	int s89 = n + 89;
+	int s90 = n + 90;
+	int s91 = n + 91;
+	int s92 = n + 92;
+	int s93 = n + 93;
+	int s94 = n + 94;
+	int s95 = n + 95;
+	int s96 = n + 96;
+	int s97 = n + 97;
+	int s98 = n + 98;
+	int s99 = n + 99;
+	int s100 = n + 100;
+	int s101 = n + 101;
+	int s102 = n + 102;
+	int s103 = n + 103;
+	int s104 = n + 104;
+	int s105 = n + 105;
+	int s106 = n + 106;
+	int s107 = n + 107;
+	int s108 = n + 108;
+	int s109 = n + 109;
+	int s110 = n + 110;
+	int s111 = n + 111;
+	int s112 = n + 112;
+	int s113 = n + 113;
+	int s114 = n + 114;
+	int s115 = n + 115;
+	int s116 = n + 116;
+	int s117 = n + 117;
+	int s118 = n + 118;
+	int s119 = n + 119;
+	int s120 = n + 120;
+	int s121 = n + 121;
+	int s122 = n + 122;
+	int s123 = n + 123;
+	int s124 = n + 124;
+	int s125 = n + 125;
+	int s126 = n + 126;
+	int s127 = n + 127;
+	int s128 = n + 128;
+	int s129 = n + 129;
+	int s130 = n + 130;
+	int s131 = n + 131;
+	int s132 = n + 132;
+	int s133 = n + 133;
+	int s134 = n + 134;
+	int s135 = n + 135;
+	int s136 = n + 136;
+	int s137 = n + 137;
+	int s138 = n + 138;
+	int s139 = n + 139;
+	int s140 = n + 140;
+	int s141 = n + 141;
+	int s142 = n + 142;
+	int s143 = n + 143;
+	int s144 = n + 144;
+	int s145 = n + 145;
+	int s146 = n + 146;
+	int s147 = n + 147;
+	int s148 = n + 148;
+	int s149 = n + 149;
+	int s150 = n + 150;
+	int s151 = n + 151;
+	int s152 = n + 152;
+	int s153 = n + 153;
+	int s154 = n + 154;
+	int s155 = n + 155;
+	int s156 = n + 156;
+	int s157 = n + 157;
+	int s158 = n + 158;
+	int s159 = n + 159;
+	int s160 = n + 160;
+	int s161 = n + 161;
+	int s162 = n + 162;
+	int s163 = n + 163;
+	int s164 = n + 164;
+	int s165 = n + 165;
+	int s166 = n + 166;
+	int s167 = n + 167;
+	int s168 = n + 168;
+	int s169 = n + 169;
+	int s170 = n + 170;
+	int s171 = n + 171;
+	int s172 = n + 172;
+	int s173 = n + 173;
+	int s174 = n + 174;
+	int s175 = n + 175;
+	int s176 = n + 176;
+	int s177 = n + 177;
+	int s178 = n + 178;
+	int s179 = n + 179;
+	int s180 = n + 180;
+	int s181 = n + 181;
+	int s182 = n + 182;
+	int s183 = n + 183;
+	int s184 = n + 184;
+	int x = 1;
+	{
+		int x = 2;
+		x = x + s3;
+	}
+	int total = x * 100000;
+	total = total + s0;
+	total = total + s1;
+	total = total + s2;
+	total = total + s3;
+	total = total + s4;
+	total = total + s5;
+	total = total + s6;
+	total = total + s7;
+	total = total + s8;
+	total = total + s9;
+	total = total + s10;
+	total = total + s11;
+	total = total + s12;
+	total = total + s13;
+	total = total + s14;
+	total = total + s15;
+	total = total + s16;
+	total = total + s17;
+	total = total + s18;
+	total = total + s19;
+	total = total + s20;
+	total = total + s21;
+	total = total + s22;
+	total = total + s23;
+	total = total + s24;
+	total = total + s25;
+	total = total + s26;
+	total = total + s27;
+	total = total + s28;
+	total = total + s29;
+	total = total + s30;
+	total = total + s31;
+	total = total + s32;
+	total = total + s33;
+	total = total + s34;
+	total = total + s35;
+	total = total + s36;
+	total = total + s37;
+	total = total + s38;
+	total = total + s39;
+	total = total + s40;
+	total = total + s41;
+	total = total + s42;
+	total = total + s43;
+	total = total + s44;
+	total = total + s45;
+	total = total + s46;
+	total = total + s47;
+	total = total + s48;
+	total = total + s49;
+	total = total + s50;
+	total = total + s51;
+	total = total + s52;
+	total = total + s53;
+	total = total + s54;
+	total = total + s55;
+	total = total + s56;
+	total = total + s57;
+	total = total + s58;
+	total = total + s59;
+	total = total + s60;
+	total = total + s61;
+	total = total + s62;
+	total = total + s63;
+	total = total + s64;
+	total = total + s65;
+	total = total + s66;
+	total = total + s67;
+	total = total + s68;
+	total = total + s69;
+	total = total + s70;
+	total = total + s71;
+	total = total + s72;
+	total = total + s73;
+	total = total + s74;
+	total = total + s75;
+	total = total + s76;
+	total = total + s77;
+	total = total + s78;
+	total = total + s79;
+	total = total + s80;
+	total = total + s81;
+	total = total + s82;
+	total = total + s83;
+	total = total + s84;
+	total = total + s85;
+	total = total + s86;
+	total = total + s87;
+	total = total + s88;
+	total = total + s89;
+	total = total + s90;
+	total = total + s91;
+	total = total + s92;
+	total = total + s93;
+	total = total + s94;
+	total = total + s95;
+	total = total + s96;
+	total = total + s97;
+	total = total + s98;
+	total = total + s99;
+	total = total + s100;
+	total = total + s101;
+	total = total + s102;
+	total = total + s103;
+	total = total + s104;
+	total = total + s105;
+	total = total + s106;
+	total = total + s107;
+	total = total + s108;
+	total = total + s109;
+	total = total + s110;
+	total = total + s111;
+	total = total + s112;
+	total = total + s113;
+	total = total + s114;
+	total = total + s115;
+	total = total + s116;
+	total = total + s117;
+	total = total + s118;
+	total = total + s119;
+	total = total + s120;
+	total = total + s121;
+	total = total + s122;
+	total = total + s123;
+	total = total + s124;
+	total = total + s125;
+	total = total + s126;
+	total = total + s127;
+	total = total + s128;
+	total = total + s129;
+	total = total + s130;
+	total = total + s131;
+	total = total + s132;
+	total = total + s133;
+	total = total + s134;
+	total = total + s135;
+	total = total + s136;
+	total = total + s137;
+	total = total + s138;
+	total = total + s139;
+	total = total + s140;
+	total = total + s141;
+	total = total + s142;
+	total = total + s143;
+	total = total + s144;
+	total = total + s145;
+	total = total + s146;
+	total = total + s147;
+	total = total + s148;
+	total = total + s149;
+	total = total + s150;
+	total = total + s151;
+	total = total + s152;
+	total = total + s153;
+	total = total + s154;
+	total = total + s155;
+	total = total + s156;
+	total = total + s157;
+	total = total + s158;
+	total = total + s159;
+	total = total + s160;
+	total = total + s161;
+	total = total + s162;
+	total = total + s163;
+	total = total + s164;
+	total = total + s165;
+	total = total + s166;
+	total = total + s167;
+	total = total + s168;
+	total = total + s169;
+	total = total + s170;
+	total = total + s171;
+	total = total + s172;
+	total = total + s173;
+	total = total + s174;
+	total = total + s175;
+	total = total + s176;
+	total = total + s177;
+	total = total + s178;
+	total = total + s179;
+	total = total + s180;
+	total = total + s181;
+	total = total + s182;
+	total = total + s183;
+	total = total + s184;
+	return total;
+}
+
+int main(int argc)
+{
+	printf("%d %d %d\n", chain(7), wide(3), shadow(argc));
+	return 0;
+}
@@ -0,0 +1,24 @@
+int fib(int n)
+{
+	while (n < 2)
+	{
+		return n;
+	}
+	return fib(n - 1) + fib(n - 2);
+}
+
+int paths(int rows, int cols)
+{
+	while (rows == 0 || cols == 0)
+	{
+		return 1;
+	}
+	return paths(rows - 1, cols) + paths(rows, cols - 1);
+}
+
+int main()
+{
+	printf("%d\n", fib(60));
+	printf("%d\n", paths(16, 16));
+	return 0;
+}
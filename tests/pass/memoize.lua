@@ -0,0 +1,45 @@
+local fib
+local __memo_fib = {}
+local function __compute_fib(n)
+	while n < 2 do
+		do
+			return n
+		end
+	end
+	return fib(n - 1) + fib(n - 2)
+end
+fib = function(n)
+	local key = n
+	local value = __memo_fib[key]
+	if value == nil then
+		value = __compute_fib(n)
+		__memo_fib[key] = value
+	end
+	return value
+end
+
+local paths
+local __memo_paths = {}
+local function __compute_paths(rows, cols)
+	while rows == 0 or cols == 0 do
+		do
+			return 1
+		end
+	end
+	return paths(rows - 1, cols) + paths(rows, cols - 1)
+end
+paths = function(rows, cols)
+	local key = tostring(rows) .. "," .. tostring(cols)
+	local value = __memo_paths[key]
+	if value == nil then
+		value = __compute_paths(rows, cols)
+		__memo_paths[key] = value
+	end
+	return value
+end
+
+os.exit((function(args)
+	print(string.format("%d", fib(60)))
+	print(string.format("%d", paths(16, 16)))
+	return 0
+end)(arg))
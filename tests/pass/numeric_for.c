@@ -0,0 +1,19 @@
+int main()
+{
+	int n = 6;
+	int total = 0;
+	for (int i = 0; i < n; i = i + 2)
+	{
+		total = total + i;
+	}
+	for (int i = 10; i >= 0; i = i - 1)
+	{
+		total = total + i;
+	}
+	for (int i = 0; i < n; i = i + 1)
+	{
+		n = n - 1;
+	}
+	printf("%d %d\n", total, n);
+	return 0;
+}
@@ -0,0 +1,21 @@
+os.exit((function(args)
+	local n = 6
+	local total = 0
+	for i = 0, 5, 2 do
+		total = total + i
+	end
+	for i = 10, 0, -1 do
+		total = total + i
+	end
+	do
+		local i = 0
+		while i < n do
+			do
+				n = n - 1
+			end
+			i = i + 1
+		end
+	end
+	print(string.format("%d %d", total, n))
+	return 0
+end)(arg))
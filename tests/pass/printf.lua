@@ -1,7 +1,5 @@
 os.exit((function(args)
-	local a = 42
-	local b = 3.14
-	print(string.format("Valor: %d e %f", a, b))
+	print("Valor: 42 e 3.140000")
 	print("fim")
 	return 0
 end)(arg))
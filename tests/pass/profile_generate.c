@@ -0,0 +1,26 @@
+int weight(int x, int k)
+{
+	printf("%d\n", x);
+	return x * k + k * k;
+}
+
+int sum(int n)
+{
+	int total = 0;
+	for (int i = 0; i < n; i = i + 1)
+	{
+		int j = 0;
+		while (j < i)
+		{
+			total = total + weight(j, 3);
+			j = j + 1;
+		}
+	}
+	return total;
+}
+
+int main(int n)
+{
+	printf("%d\n", sum(n));
+	return 0;
+}
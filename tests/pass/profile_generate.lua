@@ -0,0 +1,42 @@
+local __profile_names = { "calls weight", "calls sum", "entries sum 1", "trips sum 1", "entries sum 2", "trips sum 2", "calls main" }
+local __profile = { 0, 0, 0, 0, 0, 0, 0 }
+
+local function weight__spec1(x)
+	__profile[1] = __profile[1] + 1
+	print(string.format("%d", x))
+	return x * 3 + 9
+end
+
+local function sum(n)
+	__profile[2] = __profile[2] + 1
+	local total = 0
+	__profile[3] = __profile[3] + 1
+	for i = 0, n - 1 do
+		__profile[4] = __profile[4] + 1
+		local j = 0
+		__profile[5] = __profile[5] + 1
+		while j < i do
+			do
+				__profile[6] = __profile[6] + 1
+				total = total + weight__spec1(j)
+				j = j + 1
+			end
+		end
+	end
+	return total
+end
+
+os.exit((function(status)
+	local file = assert(io.open("sum.profile", "w"))
+	for i = 1, #__profile_names do
+		file:write(__profile_names[i], " ", __profile[i], "\n")
+	end
+	file:close()
+	return status
+end)((function(args)
+	local args_table = args
+	local n = args_table and tonumber(args_table[1]) or 0
+	__profile[7] = __profile[7] + 1
+	print(string.format("%d", sum(n)))
+	return 0
+end)(arg)))
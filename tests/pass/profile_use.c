@@ -0,0 +1,32 @@
+int weight(int x, int k)
+{
+	printf("%d\n", x);
+	return x * k + k * k;
+}
+
+int sum(int n, bool verbose)
+{
+	int total = 0;
+	for (int i = 0; i < n; i = i + 1)
+	{
+		total = total + weight(i, 3);
+	}
+	for (int i = 0; i < n; i = i + 1)
+	{
+		for (int j = 0; j < i; j = j + 1)
+		{
+			while (verbose)
+			{
+				total = total + weight(j, 5);
+				verbose = false;
+			}
+		}
+	}
+	return total;
+}
+
+int main(int n)
+{
+	printf("%d\n", sum(n, false));
+	return 0;
+}
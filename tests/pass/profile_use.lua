@@ -0,0 +1,44 @@
+local function weight(x, k)
+	print(string.format("%d", x))
+	return x * k + k * k
+end
+
+local function weight__spec1(x)
+	print(string.format("%d", x))
+	return x * 3 + 9
+end
+
+local function sum(n, verbose)
+	local total = 0
+	do
+		local __unroll2 = 0
+		for i = __unroll2, n - 4, 4 do
+			total = total + weight__spec1(i)
+			total = total + weight__spec1(i + 1)
+			total = total + weight__spec1(i + 2)
+			total = total + weight__spec1(i + 3)
+			__unroll2 = i + 4
+		end
+		for i = __unroll2, n - 1 do
+			total = total + weight__spec1(i)
+		end
+	end
+	for i = 0, n - 1 do
+		for j = 0, i - 1 do
+			while verbose do
+				do
+					total = total + weight(j, 5)
+					verbose = false
+				end
+			end
+		end
+	end
+	return total
+end
+
+os.exit((function(args)
+	local args_table = args
+	local n = args_table and tonumber(args_table[1]) or 0
+	print(string.format("%d", sum(n, false)))
+	return 0
+end)(arg))
@@ -0,0 +1,11 @@
+calls weight 40
+calls sum 1
+entries sum 1 1
+trips sum 1 40
+entries sum 2 1
+trips sum 2 40
+entries sum 3 40
+trips sum 3 780
+entries sum 4 780
+trips sum 4 0
+calls main 1
@@ -0,0 +1,28 @@
+int main(int argc)
+{
+	float v[3] = {1.5, 2.0, 4.0};
+	float w[3];
+	float dot = 0.0;
+	for (int i = 0; i < 3; i = i + 1)
+	{
+		w[i] = v[i] * 2.0;
+	}
+	for (int i = 0; i < 3; i = i + 1)
+	{
+		dot = dot + v[i] * w[i];
+	}
+	int counts[4];
+	int k = 0;
+	while (k < 2)
+	{
+		k = k + 1;
+	}
+	counts[k] = 7;
+	printf("%f %d\n", dot, counts[2]);
+	int a[3] = {1, 2, 3};
+	int a__1 = argc * 10;
+	a[1] = a[0] + a__1;
+	a__1 = a__1 + 1;
+	printf("%d %d\n", a[1], a__1);
+	return 0;
+}
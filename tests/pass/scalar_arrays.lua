@@ -0,0 +1,36 @@
+os.exit((function(args)
+	local args_table = args
+	local argc = args_table and tonumber(args_table[1]) or 0
+	local __v1_0 = 1.5
+	local __v1_1 = 2
+	local __v1_2 = 4
+	local __w2_0 = 0
+	local __w2_1 = 0
+	local __w2_2 = 0
+	local dot = 0
+	do
+		__w2_0 = __v1_0 * 2
+		dot = dot + __v1_0 * __w2_0
+		__w2_1 = __v1_1 * 2
+		dot = dot + __v1_1 * __w2_1
+		__w2_2 = __v1_2 * 2
+		dot = dot + __v1_2 * __w2_2
+	end
+	local counts = { 0, 0, 0, 0 }
+	local k = 0
+	while k < 2 do
+		do
+			k = k + 1
+		end
+	end
+	counts[k + 1] = 7
+	print(string.format("%f %d", dot, counts[3]))
+	local __a3_0 = 1
+	local __a3_1 = 2
+	local __a3_2 = 3
+	local a__1 = argc * 10
+	__a3_1 = __a3_0 + a__1
+	a__1 = a__1 + 1
+	print(string.format("%d %d", __a3_1, a__1))
+	return 0
+end)(arg))
@@ -0,0 +1,40 @@
+int scale(int x, int factor, bool negate)
+{
+	int r = x * factor;
+	while (negate)
+	{
+		return 0 - r;
+	}
+	return r;
+}
+
+int offset(int x, int k)
+{
+	int r = x + k;
+	return r;
+}
+
+int clamp(int x, int limit, bool enabled)
+{
+	while (enabled && x > limit)
+	{
+		return limit;
+	}
+	return x;
+}
+
+int main()
+{
+	int total = 0;
+	int i = 0;
+	while (i < 10)
+	{
+		total = total + scale(i, 8, false) + scale(i, 2, true);
+		total = total + offset(i, 1) + offset(i, 2);
+		total = total + clamp(i, 4, false);
+		i = i + 1;
+	}
+	printf("%d\n", total);
+	printf("%d\n", scale(total, 3, false));
+	return 0;
+}
@@ -0,0 +1,46 @@
+local function scale(x, factor, negate)
+	local r = x * factor
+	while negate do
+		do
+			return 0 - r
+		end
+	end
+	return r
+end
+
+local function scale__spec1(x)
+	local r = x * 8
+	return r
+end
+
+local function scale__spec2(x)
+	local r = x * 2
+	do
+		return 0 - r
+	end
+end
+
+local function offset(x, k)
+	local r = x + k
+	return r
+end
+
+local function clamp__spec3(x)
+	return x
+end
+
+os.exit((function(args)
+	local total = 0
+	local i = 0
+	while i < 10 do
+		do
+			total = total + scale__spec1(i) + scale__spec2(i)
+			total = total + offset(i, 1) + offset(i, 2)
+			total = total + clamp__spec3(i)
+			i = i + 1
+		end
+	end
+	print(string.format("%d", total))
+	print(string.format("%d", scale(total, 3, false)))
+	return 0
+end)(arg))
@@ -0,0 +1,25 @@
+int gcd(int a, int b)
+{
+	while (b == 0)
+	{
+		return a;
+	}
+	return gcd(b, a % b);
+}
+
+int count_down(int n, int acc)
+{
+	while (n == 0)
+	{
+		return acc;
+	}
+	return count_down(n - 1, acc + n);
+}
+
+int main()
+{
+	int a = 1071;
+	printf("%d\n", gcd(a, 462));
+	printf("%d\n", count_down(200000, 0));
+	return 0;
+}
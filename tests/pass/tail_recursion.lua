@@ -0,0 +1,35 @@
+local function gcd(a, b)
+	while true do
+		do
+			while b == 0 do
+				do
+					return a
+				end
+			end
+			local __tail1 = b
+			b = a % b
+			a = __tail1
+		end
+	end
+end
+
+local function count_down(n, acc)
+	while true do
+		do
+			while n == 0 do
+				do
+					return acc
+				end
+			end
+			local __tail2 = n - 1
+			acc = acc + n
+			n = __tail2
+		end
+	end
+end
+
+os.exit((function(args)
+	print(string.format("%d", gcd(1071, 462)))
+	print(string.format("%d", count_down(200000, 0)))
+	return 0
+end)(arg))
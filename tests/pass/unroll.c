@@ -0,0 +1,65 @@
+int sum_first(int n)
+{
+	for (int i = 0; i < 3; i = i + 1)
+	{
+		n = n + i;
+	}
+	return n;
+}
+
+int sum_range(int n, int m)
+{
+	int total = 0;
+	for (int i = n; i < m; i = i + 1)
+	{
+		total = total + i * 2;
+	}
+	return total;
+}
+
+int first_step(int n)
+{
+	for (int i = 0; i < 3; i = i + 1)
+	{
+		n = n + i;
+		return n;
+	}
+	return 0;
+}
+
+int triangle(int n)
+{
+	int total = 0;
+	for (int i = 0; i < 4; i = i + 1)
+	{
+		for (int j = 0; j < i; j = j + 1)
+		{
+			total = total + i * n + j;
+		}
+	}
+	return total;
+}
+
+int kernel(int n)
+{
+	int a[16];
+	for (int k = 0; k < 16; k = k + 1)
+	{
+		a[k] = k + n;
+	}
+	int trace = 0;
+	for (int i = 0; i < 4; i = i + 1)
+	{
+		for (int j = 0; j < 4; j = j + 1)
+		{
+			trace = trace + a[i * 4 + j] * (i + 1);
+		}
+	}
+	return trace;
+}
+
+int main(int argc)
+{
+	printf("%d %d %d %d %d\n", sum_first(argc), sum_range(argc, argc + 7), first_step(argc), triangle(argc), kernel(argc));
+	return 0;
+}
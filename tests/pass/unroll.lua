@@ -0,0 +1,116 @@
+local function sum_first(n)
+	do
+		n = n + 1
+		n = n + 2
+	end
+	return n
+end
+
+local function sum_range(n, m)
+	local total = 0
+	do
+		local __unroll1 = n
+		for i = __unroll1, m - 4, 4 do
+			total = total + i * 2
+			total = total + (i + 1) * 2
+			total = total + (i + 2) * 2
+			total = total + (i + 3) * 2
+			__unroll1 = i + 4
+		end
+		for i = __unroll1, m - 1 do
+			total = total + i * 2
+		end
+	end
+	return total
+end
+
+local function first_step(n)
+	for i = 0, 2 do
+		n = n + i
+		return n
+	end
+	return 0
+end
+
+local function triangle(n)
+	local total = 0
+	do
+		total = total + n
+		do
+			local __licm2 = 2 * n
+			total = total + __licm2
+			total = total + __licm2 + 1
+		end
+		do
+			local __licm2 = 3 * n
+			total = total + __licm2
+			total = total + __licm2 + 1
+			total = total + __licm2 + 2
+		end
+	end
+	return total
+end
+
+local function kernel(n)
+	local __a5_0 = 0
+	local __a5_1 = 0
+	local __a5_2 = 0
+	local __a5_3 = 0
+	local __a5_4 = 0
+	local __a5_5 = 0
+	local __a5_6 = 0
+	local __a5_7 = 0
+	local __a5_8 = 0
+	local __a5_9 = 0
+	local __a5_10 = 0
+	local __a5_11 = 0
+	local __a5_12 = 0
+	local __a5_13 = 0
+	local __a5_14 = 0
+	local __a5_15 = 0
+	do
+		__a5_0 = n
+		__a5_1 = 1 + n
+		__a5_2 = 2 + n
+		__a5_3 = 3 + n
+		__a5_4 = 4 + n
+		__a5_5 = 5 + n
+		__a5_6 = 6 + n
+		__a5_7 = 7 + n
+		__a5_8 = 8 + n
+		__a5_9 = 9 + n
+		__a5_10 = 10 + n
+		__a5_11 = 11 + n
+		__a5_12 = 12 + n
+		__a5_13 = 13 + n
+		__a5_14 = 14 + n
+		__a5_15 = 15 + n
+	end
+	local trace = 0
+	do
+		trace = trace + __a5_0
+		trace = trace + __a5_1
+		trace = trace + __a5_2
+		trace = trace + __a5_3
+		trace = trace + __a5_4 * 2
+		trace = trace + __a5_5 * 2
+		trace = trace + __a5_6 * 2
+		trace = trace + __a5_7 * 2
+		trace = trace + __a5_8 * 3
+		trace = trace + __a5_9 * 3
+		trace = trace + __a5_10 * 3
+		trace = trace + __a5_11 * 3
+		trace = trace + __a5_12 * 4
+		trace = trace + __a5_13 * 4
+		trace = trace + __a5_14 * 4
+		trace = trace + __a5_15 * 4
+	end
+	return trace
+end
+
+os.exit((function(args)
+	local args_table = args
+	local argc = args_table and tonumber(args_table[1]) or 0
+	print(string.format("%d %d %d %d %d", sum_first(argc), sum_range(argc, argc + 7), first_step(argc), triangle(argc), kernel(argc)))
+	return 0
+end)(arg))
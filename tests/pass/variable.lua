@@ -1,5 +1,5 @@
 os.exit((function(args)
 	local a = 10
-	a = (a + 5)
+	a = 15
 	return a
 end)(arg))